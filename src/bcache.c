@@ -0,0 +1,426 @@
+#include <string.h>
+#include "bcache.h"
+#include "disk_queue.h"
+
+#define BCACHE_NIL 0xFFFF
+
+// Girdi durum bitleri
+#define BCACHE_VALID 0x01   // Veri diskle eşleşiyor ya da daha yeni
+#define BCACHE_DIRTY 0x02   // Diske yazılmayı bekliyor
+#define BCACHE_AHEAD 0x04   // Readahead ile getirildi, henüz kullanılmadı
+#define BCACHE_LOADING 0x08 // Asenkron okuma sürüyor (girdi sabitli)
+
+typedef struct {
+    uint32_t lba;
+    uint16_t pin_count;
+    uint16_t flags;
+    uint16_t hash_next;     // Aynı kovadaki sonraki girdi
+    uint16_t lru_prev;      // LRU listesinde daha yeni olan
+    uint16_t lru_next;      // LRU listesinde daha eski olan
+} bcache_entry_t;
+
+static bcache_entry_t entries[BCACHE_ENTRIES];
+static uint8_t entry_data[BCACHE_ENTRIES][SECTOR_SIZE] __attribute__((aligned(64)));
+static uint16_t hash_table[BCACHE_HASH_SIZE];
+static uint16_t lru_head = BCACHE_NIL;   // En son kullanılan
+static uint16_t lru_tail = BCACHE_NIL;   // En eski
+static int initialized = 0;
+
+static bcache_stats_t stats;
+static disk_request_t sync_reqs[BCACHE_ENTRIES];
+static disk_async_request_t entry_reqs[BCACHE_ENTRIES];   // Girdi başına asenkron istek
+
+/* ================ YARDIMCI FONKSİYONLAR ================ */
+
+static inline uint32_t bcache_hash(uint32_t lba) {
+    return ((lba * 2654435761u) >> 16) & (BCACHE_HASH_SIZE - 1);
+}
+
+static void lru_remove(uint16_t idx) {
+    bcache_entry_t* e = &entries[idx];
+    if (e->lru_prev != BCACHE_NIL) entries[e->lru_prev].lru_next = e->lru_next;
+    else lru_head = e->lru_next;
+    if (e->lru_next != BCACHE_NIL) entries[e->lru_next].lru_prev = e->lru_prev;
+    else lru_tail = e->lru_prev;
+    e->lru_prev = e->lru_next = BCACHE_NIL;
+}
+
+static void lru_push_front(uint16_t idx) {
+    bcache_entry_t* e = &entries[idx];
+    e->lru_prev = BCACHE_NIL;
+    e->lru_next = lru_head;
+    if (lru_head != BCACHE_NIL) entries[lru_head].lru_prev = idx;
+    lru_head = idx;
+    if (lru_tail == BCACHE_NIL) lru_tail = idx;
+}
+
+static void lru_push_back(uint16_t idx) {
+    bcache_entry_t* e = &entries[idx];
+    e->lru_next = BCACHE_NIL;
+    e->lru_prev = lru_tail;
+    if (lru_tail != BCACHE_NIL) entries[lru_tail].lru_next = idx;
+    lru_tail = idx;
+    if (lru_head == BCACHE_NIL) lru_head = idx;
+}
+
+static void lru_touch(uint16_t idx) {
+    if (lru_head == idx) return;
+    lru_remove(idx);
+    lru_push_front(idx);
+}
+
+static uint16_t hash_lookup(uint32_t lba) {
+    uint16_t idx = hash_table[bcache_hash(lba)];
+    while (idx != BCACHE_NIL) {
+        if (entries[idx].lba == lba) return idx;
+        idx = entries[idx].hash_next;
+    }
+    return BCACHE_NIL;
+}
+
+// Girdi asenkron okunuyorsa tamamlanmasını bekle; okuma başarısız olup
+// girdi atılmış olabileceği için yeniden ara
+static uint16_t lookup_ready(uint32_t lba) {
+    uint16_t idx = hash_lookup(lba);
+    if (idx != BCACHE_NIL && (entries[idx].flags & BCACHE_LOADING)) {
+        disk_queue_wait(&entry_reqs[idx]);
+        idx = hash_lookup(lba);
+    }
+    return idx;
+}
+
+static void hash_insert(uint16_t idx) {
+    uint32_t bucket = bcache_hash(entries[idx].lba);
+    entries[idx].hash_next = hash_table[bucket];
+    hash_table[bucket] = idx;
+}
+
+static void hash_remove(uint16_t idx) {
+    uint16_t* link = &hash_table[bcache_hash(entries[idx].lba)];
+    while (*link != BCACHE_NIL) {
+        if (*link == idx) {
+            *link = entries[idx].hash_next;
+            break;
+        }
+        link = &entries[*link].hash_next;
+    }
+    entries[idx].hash_next = BCACHE_NIL;
+}
+
+// Girdiyi önbellekten çıkar ve LRU'nun sonuna (ilk kullanılacak) taşı
+static void entry_drop(uint16_t idx) {
+    if (entries[idx].flags & BCACHE_DIRTY) stats.dirty--;
+    if (entries[idx].flags & BCACHE_AHEAD) stats.ra_waste++;
+    hash_remove(idx);
+    entries[idx].flags = 0;
+    lru_remove(idx);
+    lru_push_back(idx);
+}
+
+// LRU sonundan sabitlenmemiş bir girdiyi boşaltıp lba için ayır
+static uint16_t entry_alloc(uint32_t lba) {
+    uint16_t idx = lru_tail;
+    while (idx != BCACHE_NIL && entries[idx].pin_count > 0) {
+        idx = entries[idx].lru_prev;
+    }
+    if (idx == BCACHE_NIL) {
+        // Asenkron okumalar girdileri sabitler; bitince yer açılır
+        if (stats.loading == 0) return BCACHE_NIL;  // Tüm girdiler sabitlenmiş
+        disk_queue_drain();
+        return stats.loading == 0 ? entry_alloc(lba) : BCACHE_NIL;
+    }
+
+    bcache_entry_t* e = &entries[idx];
+    if (e->flags & BCACHE_VALID) {
+        if (e->flags & BCACHE_DIRTY) {
+            if (write_sectors(e->lba, entry_data[idx], 1) != 0) {
+                return BCACHE_NIL;
+            }
+            stats.writebacks++;
+            stats.dirty--;
+        }
+        if (e->flags & BCACHE_AHEAD) stats.ra_waste++;
+        stats.evictions++;
+    }
+    hash_remove(idx);
+
+    e->lba = lba;
+    e->flags = 0;
+    hash_insert(idx);
+    lru_touch(idx);
+    return idx;
+}
+
+static void bcache_ensure_init(void) {
+    if (!initialized) {
+        bcache_init();
+    }
+}
+
+/* ================ GENEL FONKSİYONLAR ================ */
+
+void bcache_init(void) {
+    bcache_stats_t zero = {0};
+
+    // Uçuştaki okumalar girdi buffer'larına yazmadan önce bitmeli
+    if (initialized && stats.loading > 0) disk_queue_drain();
+
+    for (uint32_t i = 0; i < BCACHE_HASH_SIZE; i++) {
+        hash_table[i] = BCACHE_NIL;
+    }
+    lru_head = lru_tail = BCACHE_NIL;
+    for (uint16_t i = 0; i < BCACHE_ENTRIES; i++) {
+        entries[i].lba = 0;
+        entries[i].pin_count = 0;
+        entries[i].flags = 0;
+        entries[i].hash_next = BCACHE_NIL;
+        lru_push_back(i);
+    }
+    stats = zero;
+    initialized = 1;
+}
+
+// Önbellekte bulunan girdiye erişim: readahead ile gelmişse isabet say
+static inline void entry_hit(uint16_t idx) {
+    stats.hits++;
+    if (entries[idx].flags & BCACHE_AHEAD) {
+        entries[idx].flags &= ~BCACHE_AHEAD;
+        stats.ra_hits++;
+    }
+}
+
+// Pencereler halinde sektörleri önbelleğe getir; buffer NULL değilse kopyala.
+// ahead != 0 ise diskten okunan girdiler readahead olarak işaretlenir.
+static int bcache_fill(uint32_t lba, uint8_t* buffer, uint32_t count, int ahead) {
+    disk_request_t reqs[BCACHE_BATCH];
+    uint16_t slots[BCACHE_BATCH];
+
+    bcache_ensure_init();
+
+    while (count > 0) {
+        uint32_t n = count < BCACHE_BATCH ? count : BCACHE_BATCH;
+        uint32_t nreq = 0;
+        int result = 0;
+
+        // Önce tüm pencereyi sabitle, eksikleri tek bir toplu okumada topla
+        for (uint32_t i = 0; i < n; i++) {
+            uint16_t idx = lookup_ready(lba + i);
+            if (idx == BCACHE_NIL) {
+                idx = entry_alloc(lba + i);
+                if (idx == BCACHE_NIL) {
+                    n = i;
+                    result = -1;
+                    break;
+                }
+            } else {
+                lru_touch(idx);
+            }
+
+            if (entries[idx].flags & BCACHE_VALID) {
+                // Readahead'in kendisi önbellekteki sektörü "kullanmış" sayılmaz
+                if (!ahead) entry_hit(idx);
+            } else {
+                reqs[nreq].lba = lba + i;
+                reqs[nreq].buffer = entry_data[idx];
+                reqs[nreq].sectors = 1;
+                nreq++;
+                stats.misses++;
+            }
+            entries[idx].pin_count++;
+            slots[i] = idx;
+        }
+
+        if (nreq > 0 && disk_read_batch(reqs, nreq) != 0) {
+            result = -1;
+        }
+        for (uint32_t r = 0; r < nreq; r++) {
+            uint16_t idx = (uint16_t) ((reqs[r].buffer - entry_data[0]) / SECTOR_SIZE);
+            if (reqs[r].status == 0) {
+                entries[idx].flags |= BCACHE_VALID | (ahead ? BCACHE_AHEAD : 0);
+            }
+        }
+
+        for (uint32_t i = 0; i < n; i++) {
+            uint16_t idx = slots[i];
+            entries[idx].pin_count--;
+            if (entries[idx].flags & BCACHE_VALID) {
+                if (buffer) memcpy(buffer + i * SECTOR_SIZE, entry_data[idx], SECTOR_SIZE);
+            } else {
+                // Okunamayan girdi önbellekte kalmamalı
+                entry_drop(idx);
+            }
+        }
+
+        if (result != 0) return -1;
+        lba += n;
+        if (buffer) buffer += n * SECTOR_SIZE;
+        count -= n;
+    }
+    return 0;
+}
+
+int bcache_read(uint32_t lba, uint8_t* buffer, uint32_t count) {
+    return bcache_fill(lba, buffer, count, 0);
+}
+
+int bcache_prefetch(uint32_t lba, uint32_t count) {
+    return bcache_fill(lba, 0, count, 0);
+}
+
+int bcache_readahead(uint32_t lba, uint32_t count) {
+    return bcache_fill(lba, 0, count, 1);
+}
+
+// Asenkron readahead tamamlandı (disk_queue_poll/wait içinden çağrılır)
+static void readahead_done(void* arg) {
+    disk_async_request_t* req = arg;
+    uint16_t idx = (uint16_t) (req - entry_reqs);
+
+    entries[idx].flags &= ~BCACHE_LOADING;
+    entries[idx].pin_count--;
+    stats.loading--;
+    if (req->status == 0) {
+        entries[idx].flags |= BCACHE_VALID | BCACHE_AHEAD;
+    } else {
+        entry_drop(idx);
+    }
+}
+
+int bcache_readahead_async(uint32_t lba, uint32_t count) {
+    bcache_ensure_init();
+
+    for (uint32_t i = 0; i < count; i++) {
+        // Önbellekte olan ya da zaten okunmakta olan sektör atlanır
+        if (hash_lookup(lba + i) != BCACHE_NIL) continue;
+
+        uint16_t idx = entry_alloc(lba + i);
+        if (idx == BCACHE_NIL) break;
+
+        disk_async_request_t* req = &entry_reqs[idx];
+        req->lba = lba + i;
+        req->buffer = entry_data[idx];
+        req->sectors = 1;
+        req->direction = 0;
+        req->callback = readahead_done;
+        req->context = 0;
+        if (disk_queue_submit(req) != 0) {
+            // Kuyruk dolu: pencerenin kalanı okunmaz
+            entry_drop(idx);
+            break;
+        }
+
+        entries[idx].flags |= BCACHE_LOADING;
+        entries[idx].pin_count++;
+        stats.loading++;
+        stats.misses++;
+    }
+
+    // Bitişik sektörler tek komutta birleşir ve hemen yola çıkar
+    disk_queue_poll();
+    return 0;
+}
+
+int bcache_write(uint32_t lba, const uint8_t* buffer, uint32_t count) {
+    bcache_ensure_init();
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint16_t idx = lookup_ready(lba + i);
+        if (idx == BCACHE_NIL) {
+            // Tüm sektör yazılacağı için diskten okumaya gerek yok
+            idx = entry_alloc(lba + i);
+            if (idx == BCACHE_NIL) return -1;
+        } else {
+            lru_touch(idx);
+        }
+
+        memcpy(entry_data[idx], buffer + i * SECTOR_SIZE, SECTOR_SIZE);
+        if (!(entries[idx].flags & BCACHE_DIRTY)) stats.dirty++;
+        entries[idx].flags = (entries[idx].flags & ~BCACHE_AHEAD) | BCACHE_VALID | BCACHE_DIRTY;
+    }
+    return 0;
+}
+
+uint8_t* bcache_pin(uint32_t lba) {
+    bcache_ensure_init();
+
+    uint16_t idx = lookup_ready(lba);
+    if (idx == BCACHE_NIL) {
+        idx = entry_alloc(lba);
+        if (idx == BCACHE_NIL) return 0;
+    } else {
+        lru_touch(idx);
+    }
+
+    if (entries[idx].flags & BCACHE_VALID) {
+        entry_hit(idx);
+    } else {
+        stats.misses++;
+        if (read_sectors(lba, entry_data[idx], 1) != 0) {
+            entry_drop(idx);
+            return 0;
+        }
+        entries[idx].flags |= BCACHE_VALID;
+    }
+
+    entries[idx].pin_count++;
+    return entry_data[idx];
+}
+
+void bcache_unpin(uint32_t lba, int dirty) {
+    uint16_t idx = hash_lookup(lba);
+    if (idx == BCACHE_NIL || entries[idx].pin_count == 0) return;
+
+    entries[idx].pin_count--;
+    if (dirty && !(entries[idx].flags & BCACHE_DIRTY)) {
+        entries[idx].flags |= BCACHE_DIRTY;
+        stats.dirty++;
+    }
+}
+
+int bcache_sync(void) {
+    uint32_t n = 0;
+    int result;
+
+    if (!initialized || stats.dirty == 0) return 0;
+
+    for (uint16_t i = 0; i < BCACHE_ENTRIES; i++) {
+        if (entries[i].flags & BCACHE_DIRTY) {
+            sync_reqs[n].lba = entries[i].lba;
+            sync_reqs[n].buffer = entry_data[i];
+            sync_reqs[n].sectors = 1;
+            n++;
+        }
+    }
+
+    // disk_write_batch sıralar ve bitişik sektörleri tek komutta yazar
+    result = disk_write_batch(sync_reqs, n);
+
+    for (uint32_t r = 0; r < n; r++) {
+        if (sync_reqs[r].status == 0) {
+            uint16_t idx = (uint16_t) ((sync_reqs[r].buffer - entry_data[0]) / SECTOR_SIZE);
+            entries[idx].flags &= ~BCACHE_DIRTY;
+            stats.dirty--;
+            stats.writebacks++;
+        }
+    }
+    return result;
+}
+
+void bcache_discard(uint32_t lba, uint32_t count) {
+    if (!initialized) return;
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint16_t idx = lookup_ready(lba + i);
+        if (idx != BCACHE_NIL && entries[idx].pin_count == 0) {
+            entry_drop(idx);
+        }
+    }
+}
+
+void bcache_get_stats(bcache_stats_t* out) {
+    *out = stats;
+    out->pinned = 0;
+    for (uint16_t i = 0; i < BCACHE_ENTRIES && initialized; i++) {
+        if (entries[i].pin_count > 0) out->pinned++;
+    }
+}
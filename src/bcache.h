@@ -0,0 +1,69 @@
+#ifndef BCACHE_H
+#define BCACHE_H
+
+#include <stdint.h>
+#include "disk_io.h"
+
+// Sektör önbelleği: read_sectors üzerinde sabit boyutlu, hash ile
+// indekslenen, LRU ile boşaltılan ve write-back çalışan bir katman.
+// Tüm bellek statiktir; bootloader ortamında da malloc gerektirmez.
+// Thread-safe değildir, çağıran taraf gerekirse kilitlemelidir.
+
+#define BCACHE_ENTRIES   1024   // Önbellekteki sektör sayısı (512 KiB)
+#define BCACHE_HASH_SIZE 2048   // Hash kovası sayısı (2'nin kuvveti)
+#define BCACHE_BATCH     128    // Tek disk komutunda toplanan en fazla eksik sektör
+
+// Önbellek istatistikleri
+typedef struct {
+    uint64_t hits;            // Önbellekten karşılanan sektörler
+    uint64_t misses;          // Diskten okunan sektörler
+    uint64_t evictions;       // Yer açmak için atılan girdiler
+    uint64_t writebacks;      // Diske geri yazılan kirli sektörler
+    uint64_t ra_hits;         // Önceden okunup sonra kullanılan sektörler
+    uint64_t ra_waste;        // Önceden okunup hiç kullanılmadan atılan sektörler
+    uint32_t dirty;           // Şu anda kirli olan girdi sayısı
+    uint32_t pinned;          // Şu anda sabitlenmiş girdi sayısı
+    uint32_t loading;         // Şu anda asenkron okunan girdi sayısı
+} bcache_stats_t;
+
+// Önbelleği sıfırla (kirli girdiler varsa önce bcache_sync çağrılmalı;
+// uçuştaki asenkron okumalar beklenir)
+void bcache_init(void);
+
+// Sektörleri önbellek üzerinden oku; eksik sektörler tek seferde okunur
+int bcache_read(uint32_t lba, uint8_t* buffer, uint32_t count);
+
+// Sektörleri kopyalamadan önbelleğe getir (eksikler tek seferde okunur)
+int bcache_prefetch(uint32_t lba, uint32_t count);
+
+// Önceden okuma (readahead): prefetch gibi çalışır, ancak diskten getirilen
+// sektörler işaretlenir; kullanılırlarsa ra_hits, kullanılmadan atılırlarsa
+// ra_waste sayacı artar
+int bcache_readahead(uint32_t lba, uint32_t count);
+
+// Asenkron readahead: eksik sektörler için girdi ayrılır ve disk kuyruğuna
+// okuma gönderilir; çağıran beklemez. Okunmakta olan bir sektöre erişen
+// fonksiyonlar okuma bitene kadar bekler. Kuyruk doluysa pencerenin kalanı
+// atlanır.
+int bcache_readahead_async(uint32_t lba, uint32_t count);
+
+// Sektörleri önbelleğe yaz ve kirli işaretle (diske bcache_sync ile gider)
+int bcache_write(uint32_t lba, const uint8_t* buffer, uint32_t count);
+
+// Sektörü önbelleğe al ve sabitle; dönen adres bcache_unpin'e kadar geçerlidir.
+// Hata durumunda NULL döner.
+uint8_t* bcache_pin(uint32_t lba);
+
+// Sabitlemeyi kaldır; dirty != 0 ise sektör kirli işaretlenir
+void bcache_unpin(uint32_t lba, int dirty);
+
+// Tüm kirli sektörleri LBA sırasıyla, bitişik olanları birleştirerek yaz
+int bcache_sync(void);
+
+// Aralıktaki girdileri (kirli olsalar bile) önbellekten at.
+// Sektörler önbelleği atlayarak doğrudan diske yazıldığında kullanılır.
+void bcache_discard(uint32_t lba, uint32_t count);
+
+void bcache_get_stats(bcache_stats_t* stats);
+
+#endif
@@ -2,86 +2,95 @@
 #include <string.h>
 #include "disk_io.h"
 #include "fat32.h"
+#include "loader.h"
+#include "console.h"
+#include "boot_profile.h"
 
 // Sabitler
 #define KERNEL_LOAD_ADDRESS 0x10000  // Kernel'ı yüklemek için bellek adresi
-
-// Ekran yazdırma fonksiyonları (VGA)
-#define VGA_PORT 0xB8000 // VGA ekran belleği adresi
+#define KERNEL_MAX_SIZE     0x70000  // 0x80000'e kadar boş alan (EBDA altında)
 
 void outb(uint16_t port, uint8_t value) {
     __asm__ volatile ("outb %0, %1" :: "a"(value), "Nd"(port));
 }
 
-void write_char(char c, uint16_t x, uint16_t y) {
-    uint16_t* video_memory = (uint16_t*)VGA_PORT;
-    video_memory[y * 80 + x] = (0x0F << 8) | c;  // 0x0F: beyaz renk, karakter
+// Ekran çıktısı gölge tamponlu konsol üzerinden gider (console.c)
+void print(const char* str) {
+    console_puts(str);
 }
 
-void clear_screen() {
-    uint16_t* video_memory = (uint16_t*)VGA_PORT;
-    for (int i = 0; i < 80 * 25; i++) {
-        video_memory[i] = (0x0F << 8) | ' ';  // Ekranı temizle
-    }
-}
+// Kernel'ı cluster zincirini izleyerek doğrudan yükleme adresine okur.
+// compressed != 0 ise dosya LZ4 frame'dir ve okunurken açılır.
+void load_kernel(const DIR_ENTRY* kernel_entry, int compressed) {
+    loader_stats_t stats;
+    int result;
 
-void print(const char* str) {
-    while (*str) {
-        write_char(*str, 0, 0);  // Yalnızca başlangıçta ekrana yazalım
-        str++;
+    if (compressed) {
+        result = loader_load_entry_lz4(kernel_entry, (uint8_t*) KERNEL_LOAD_ADDRESS, KERNEL_MAX_SIZE, &stats);
+    } else {
+        result = loader_load_entry(kernel_entry, (uint8_t*) KERNEL_LOAD_ADDRESS, KERNEL_MAX_SIZE, &stats);
     }
-}
-
-// Kernel'ı bellek adresine yüklemek için yardımcı fonksiyon
-void load_kernel(uint32_t kernel_sector, uint32_t kernel_size) {
-    uint8_t buffer[SECTOR_SIZE]; // Veriyi tutacak geçici bir buffer
-    uint32_t kernel_address = KERNEL_LOAD_ADDRESS;
-
-    // Kernel'ı diskin FAT32 dosya sisteminden okuma işlemi
-    for (uint32_t sector = kernel_sector; kernel_size > 0; kernel_size -= SECTOR_SIZE, sector++) {
-        // FAT32 üzerinden diske erişim
-        if (read_sector(sector, buffer) != 0) {
-            print("Disk okuma hatası!\n");
-            return;
-        }
-
-        // Okunan veriyi bellek adresine kopyala
-        for (int i = 0; i < SECTOR_SIZE && kernel_size > 0; i++) {
-            *((uint8_t*)kernel_address++) = buffer[i];
-            kernel_size--;
-        }
+    if (result != 0) {
+        print("Disk okuma hatası!\n");
+        return;
     }
+    BOOT_PHASE("image_read");
+
+    console_printf("Kernel yuklendi: %u byte (diskten %u), %u parca\n",
+                   stats.bytes, stats.read_bytes, stats.extents);
+
+    // Aşama tablosu basılır ve kernel'a devredilir (sürücü başlatma
+    // aşamalarını kernel boot_profile_append ile aynı tabloya ekler)
+    BOOT_PROFILE_FINISH();
 
     // Kernel yüklendi, kernel'ı başlatmak için kontrolü kernel'a veriyoruz
-    print("Kernel yuklendi, baslatiliyor...\n");
+    print("Kernel baslatiliyor...\n");
     void (*kernel_main)(void) = (void*)KERNEL_LOAD_ADDRESS;
     kernel_main();
 }
 
-// `kernel.c` dosyasını FAT32 dosya sisteminde arar ve yükler
+// Kernel'ı FAT32 dosya sisteminde arar ve yükler; sıkıştırılmış
+// `kernel.lz4` varsa o tercih edilir, yoksa `kernel.c` okunur
 void load_kernel_from_fat32() {
-    // FAT32 ile dosya sistemine erişim için ilk olarak kök dizini aramamız gerekiyor
     DIR_ENTRY kernel_entry = {0};
+
+    disk_get_device();
+    BOOT_PHASE("disk_init");
+
+    if (fat32_init() != 0) {
+        print("FAT32 bolumu bulunamadi!\n");
+        return;
+    }
+    BOOT_PHASE("fat_mount");
+
+    if (find_file("kernel.lz4", &kernel_entry) == 0) {
+        BOOT_PHASE("dir_lookup");
+        load_kernel(&kernel_entry, 1);
+        return;
+    }
     if (find_file("kernel.c", &kernel_entry) != 0) {
         print("kernel.c dosyasi bulunamadi!\n");
         return;
     }
-
-    // Kernel dosyasının sektörünü alalım ve yükleyelim
-    uint32_t kernel_sector = kernel_entry.first_cluster;  // FAT32'de ilk cluster bilgisi
-    uint32_t kernel_size = kernel_entry.file_size; // Dosyanın boyutu
+    BOOT_PHASE("dir_lookup");
 
     // Kernel'ı yükle
-    load_kernel(kernel_sector, kernel_size);
+    load_kernel(&kernel_entry, 0);
 }
 
 // Gerçek zamanlı boot işlemi başlat
 void boot() {
-    clear_screen();  // Ekranı temizle
+    BOOT_PROFILE_START();
+    console_init(CONSOLE_DEFAULT_ATTR);  // Ekranı temizle
+    BOOT_PHASE("console");
     print("Bootloader Calisiyor...\n");
 
     // FAT32 dosya sisteminden kernel.c dosyasını yükle
     load_kernel_from_fat32();
+
+    // Buraya yalnızca yükleme başarısız olursa dönülür; tablo yine de
+    // basılır ve devredilir
+    BOOT_PROFILE_FINISH();
 }
 
 int main() {
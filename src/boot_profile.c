@@ -0,0 +1,143 @@
+// Boot aşaması profili; BOOT_PROFILE tanımlı değilse boş derlenir.
+#ifdef BOOT_PROFILE
+
+#include <string.h>
+#include "boot_profile.h"
+#include "console.h"
+
+#define PIT_HZ          1193182
+#define PIT_CHANNEL2    0x42
+#define PIT_COMMAND     0x43
+#define PIT_GATE_PORT   0x61
+#define CALIBRATE_TICKS 11932       // ~10 ms
+
+static boot_profile_t profile;
+
+static inline uint64_t read_tsc(void) {
+    uint32_t lo, hi;
+    __asm__ volatile ("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t) hi << 32) | lo;
+}
+
+static inline uint8_t pit_inb(uint16_t port) {
+    uint8_t value;
+    __asm__ volatile ("inb %1, %0" : "=a"(value) : "Nd"(port));
+    return value;
+}
+
+static inline void pit_outb(uint16_t port, uint8_t value) {
+    __asm__ volatile ("outb %0, %1" :: "a"(value), "Nd"(port));
+}
+
+// Devir adresi derleyiciden gizlenir: sabit 0x500'ü sıfır boyutlu bir
+// nesne sanıp erişimleri -Warray-bounds ile işaretlemesin
+static inline boot_profile_t* handoff_table(void) {
+    boot_profile_t* table = (boot_profile_t*) BOOT_PROFILE_ADDRESS;
+    __asm__ ("" : "+r"(table));
+    return table;
+}
+
+void boot_profile_start(void) {
+    memset(&profile, 0, sizeof(profile));
+    profile.magic = BOOT_PROFILE_MAGIC;
+    profile.start_tsc = read_tsc();
+}
+
+static void add_phase(boot_profile_t* table, const char* phase, uint64_t end_tsc) {
+    if (table->count >= BOOT_PROFILE_MAX_PHASES) return;
+    boot_phase_t* entry = &table->phases[table->count++];
+    strncpy(entry->name, phase, BOOT_PROFILE_NAME - 1);
+    entry->end_tsc = end_tsc;
+}
+
+void boot_profile_mark(const char* phase) {
+    add_phase(&profile, phase, read_tsc());
+}
+
+// Kanal 2'yi tek atımlık modda (mod 0) CALIBRATE_TICKS'ten geri saydır;
+// sayaç bitince port 0x61'in 5. biti 1 olur. Hoparlör kapalı tutulur.
+void boot_profile_calibrate(void) {
+    uint8_t gate = pit_inb(PIT_GATE_PORT);
+
+    pit_outb(PIT_GATE_PORT, (uint8_t) ((gate & ~0x02) | 0x01));
+    pit_outb(PIT_COMMAND, 0xB0);    // Kanal 2, lobyte/hibyte, mod 0, ikili
+    pit_outb(PIT_CHANNEL2, CALIBRATE_TICKS & 0xFF);
+    pit_outb(PIT_CHANNEL2, CALIBRATE_TICKS >> 8);
+
+    uint64_t start = read_tsc();
+    uint32_t spins = 0;
+    while (!(pit_inb(PIT_GATE_PORT) & 0x20)) {
+        // PIT yoksa (ör. bazı sanal makineler) sonsuza kadar beklenmez
+        if (++spins == 0x10000000) {
+            pit_outb(PIT_GATE_PORT, gate);
+            return;
+        }
+    }
+    uint64_t cycles = read_tsc() - start;
+    pit_outb(PIT_GATE_PORT, gate);
+
+    profile.tsc_hz = cycles * PIT_HZ / CALIBRATE_TICKS;
+}
+
+void boot_profile_finish(void) {
+    // Ölçüm son aşamadan sonra yapılır, böylece hiçbir aşamaya eklenmez
+    if (profile.tsc_hz == 0) boot_profile_calibrate();
+
+    uint64_t prev = profile.start_tsc;
+    uint64_t khz = profile.tsc_hz / 1000;
+
+    console_printf("Boot profili (%u asama, TSC %u MHz):\n",
+                   profile.count, (uint32_t) (profile.tsc_hz / 1000000));
+    for (uint32_t i = 0; i < profile.count; i++) {
+        uint64_t cycles = profile.phases[i].end_tsc - prev;
+        prev = profile.phases[i].end_tsc;
+
+        // Frekans ölçülemediyse yalnızca cycle sayısı basılır
+        if (khz == 0) {
+            console_printf("  %-16s %12llu cycle\n", profile.phases[i].name,
+                           (unsigned long long) cycles);
+            continue;
+        }
+        uint64_t us = cycles * 1000 / khz;
+        console_printf("  %-16s %6u.%03u ms\n", profile.phases[i].name,
+                       (uint32_t) (us / 1000), (uint32_t) (us % 1000));
+    }
+    if (khz != 0) {
+        uint64_t us = (prev - profile.start_tsc) * 1000 / khz;
+        console_printf("  %-16s %6u.%03u ms\n", "toplam", (uint32_t) (us / 1000), (uint32_t) (us % 1000));
+    }
+
+    // Kernel, tabloyu sabit adresten magic ile doğrulayarak okur
+    memcpy(handoff_table(), &profile, sizeof(profile));
+}
+
+const boot_profile_t* boot_profile_get(void) {
+    return &profile;
+}
+
+/* ================ KERNEL TARAFI ================ */
+
+uint64_t boot_profile_tsc(void) {
+    return read_tsc();
+}
+
+void boot_profile_append(const char* phase, uint64_t start_tsc) {
+    boot_profile_t* table = handoff_table();
+    uint64_t now = read_tsc();
+
+    if (table->magic != BOOT_PROFILE_MAGIC || table->count > BOOT_PROFILE_MAX_PHASES) return;
+
+    // Aşamalar arasında kalan süre tek bir "kernel" kaydında birikir
+    uint64_t last = table->count ? table->phases[table->count - 1].end_tsc : table->start_tsc;
+    if (start_tsc > last) {
+        boot_phase_t* prev = table->count ? &table->phases[table->count - 1] : 0;
+        if (prev && strcmp(prev->name, "kernel") == 0) {
+            prev->end_tsc = start_tsc;
+        } else {
+            add_phase(table, "kernel", start_tsc);
+        }
+    }
+    add_phase(table, phase, now);
+}
+
+#endif
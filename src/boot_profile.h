@@ -0,0 +1,78 @@
+#ifndef BOOT_PROFILE_H
+#define BOOT_PROFILE_H
+
+#include <stdint.h>
+
+// Boot aşaması profili. BOOT_PROFILE tanımlıysa her aşama sınırında bir
+// RDTSC damgası statik bir tabloya yazılır; TSC frekansı PIT kanal 2 ile
+// ölçülür ve boot sonunda aşama başına milisaniye tablosu konsola basılır.
+// Kernel'a geçmeden önce tablo sabit bir adrese kopyalanır; kernel oradan
+// okur ve kendi aşamalarını (sürücü başlatma) BOOT_KERNEL_PHASE_* ile aynı
+// tabloya ekler. BOOT_PROFILE tanımlı değilse makrolar boş açılır ve
+// boot_profile.c boş derlenir.
+
+#define BOOT_PROFILE_ADDRESS    0x0500      // Tablonun kernel'a devredildiği adres
+#define BOOT_PROFILE_MAGIC      0x464F5250  // "PROF"
+#define BOOT_PROFILE_MAX_PHASES 16
+#define BOOT_PROFILE_NAME       16
+
+typedef struct {
+    char     name[BOOT_PROFILE_NAME];  // Aşama adı (sonlandırılmış)
+    uint64_t end_tsc;                  // Aşamanın bittiği an
+} boot_phase_t;
+
+// Kernel ile paylaşılan biçim: aşama i, phases[i - 1].end_tsc'den (i == 0
+// için start_tsc'den) phases[i].end_tsc'ye kadar sürer
+typedef struct {
+    uint32_t magic;
+    uint32_t count;                    // Kayıtlı aşama sayısı
+    uint64_t tsc_hz;                   // Ölçülen TSC frekansı (0: ölçülemedi)
+    uint64_t start_tsc;                // Profilin başladığı an
+    boot_phase_t phases[BOOT_PROFILE_MAX_PHASES];
+} boot_profile_t;
+
+#ifdef BOOT_PROFILE
+
+// Profili başlat (boot'un ilk işi olmalı)
+void boot_profile_start(void);
+
+// Bir aşamanın bittiğini kaydet; tablo doluysa yok sayılır
+void boot_profile_mark(const char* phase);
+
+// TSC frekansını PIT ile ölç (yaklaşık 10 ms sürer)
+void boot_profile_calibrate(void);
+
+// Frekans henüz ölçülmediyse ölç, aşama tablosunu konsola bas ve
+// BOOT_PROFILE_ADDRESS'e kopyala
+void boot_profile_finish(void);
+
+const boot_profile_t* boot_profile_get(void);
+
+// Kernel tarafı: o anki TSC
+uint64_t boot_profile_tsc(void);
+
+// Kernel tarafı: BOOT_PROFILE_ADDRESS'teki devredilmiş tabloya start_tsc'den
+// şimdiye süren bir aşama ekle. Önceki kayıttan start_tsc'ye kadar geçen
+// süre "kernel" aşamasına yazılır (başarısız bir sürücü başlatması da
+// oraya düşer). Tablo yoksa (magic) ya da doluysa yok sayılır.
+void boot_profile_append(const char* phase, uint64_t start_tsc);
+
+#define BOOT_PROFILE_START()     boot_profile_start()
+#define BOOT_PHASE(name)         boot_profile_mark(name)
+#define BOOT_PROFILE_FINISH()    boot_profile_finish()
+
+#define BOOT_KERNEL_PHASE_BEGIN(var)      uint64_t var = boot_profile_tsc()
+#define BOOT_KERNEL_PHASE_END(name, var)  boot_profile_append(name, var)
+
+#else
+
+#define BOOT_PROFILE_START()     ((void) 0)
+#define BOOT_PHASE(name)         ((void) 0)
+#define BOOT_PROFILE_FINISH()    ((void) 0)
+
+#define BOOT_KERNEL_PHASE_BEGIN(var)      ((void) 0)
+#define BOOT_KERNEL_PHASE_END(name, var)  ((void) 0)
+
+#endif
+
+#endif
@@ -0,0 +1,261 @@
+#include <string.h>
+#include "console.h"
+
+#define VGA_CRTC_INDEX 0x3D4
+#define VGA_CRTC_DATA  0x3D5
+#define CELLS_PER_WORD 4        // 64 bitlik bir yazmadaki hücre sayısı
+#define ALL_ROWS       ((1u << CONSOLE_ROWS) - 1)
+
+// Hücreler 16 bit, kopyalama 64 bitlik kelimelerle yapılır
+typedef uint64_t __attribute__((may_alias)) vga_word_t;
+
+// Gölge ekran: satırlar halka olarak kullanılır, ekranın ilk satırı top
+static uint16_t shadow[CONSOLE_ROWS][CONSOLE_COLS] __attribute__((aligned(8)));
+static uint32_t top = 0;
+static uint32_t dirty = 0;          // Bit r: ekran satırı r değişti
+static uint32_t cursor_x = 0, cursor_y = 0;
+static uint32_t hw_cursor = 0xFFFFFFFF;
+static uint16_t attr = (uint16_t) CONSOLE_DEFAULT_ATTR << 8;
+
+static inline void vga_outb(uint16_t port, uint8_t value) {
+    __asm__ volatile ("outb %0, %1" :: "a"(value), "Nd"(port));
+}
+
+static inline uint16_t* screen_row(uint32_t row) {
+    return shadow[(top + row) % CONSOLE_ROWS];
+}
+
+static void fill_row(uint16_t* row) {
+    for (uint32_t x = 0; x < CONSOLE_COLS; x++) row[x] = attr | ' ';
+}
+
+/* ================ GÖLGE EKRAN ================ */
+
+void console_set_attribute(uint8_t attribute) {
+    attr = (uint16_t) attribute << 8;
+}
+
+void console_clear(void) {
+    for (uint32_t y = 0; y < CONSOLE_ROWS; y++) fill_row(shadow[y]);
+    top = 0;
+    cursor_x = cursor_y = 0;
+    dirty = ALL_ROWS;
+}
+
+void console_init(uint8_t attribute) {
+    console_set_attribute(attribute);
+    console_clear();
+    console_flush();
+}
+
+// Bir satır yukarı kaydır: en üst satır halkada en alta geçer ve temizlenir
+static void scroll(void) {
+    fill_row(shadow[top]);
+    top = (top + 1) % CONSOLE_ROWS;
+    dirty = ALL_ROWS;
+}
+
+static void newline(void) {
+    cursor_x = 0;
+    if (cursor_y + 1 < CONSOLE_ROWS) {
+        cursor_y++;
+    } else {
+        scroll();
+    }
+}
+
+void console_putc(char c) {
+    switch (c) {
+    case '\n':
+        newline();
+        return;
+    case '\r':
+        cursor_x = 0;
+        return;
+    case '\t':
+        cursor_x = (cursor_x + CONSOLE_TAB_WIDTH) & ~(CONSOLE_TAB_WIDTH - 1);
+        if (cursor_x >= CONSOLE_COLS) newline();
+        return;
+    case '\b':
+        if (cursor_x > 0) cursor_x--;
+        return;
+    default:
+        break;
+    }
+
+    screen_row(cursor_y)[cursor_x] = attr | (uint8_t) c;
+    dirty |= 1u << cursor_y;
+    if (++cursor_x == CONSOLE_COLS) newline();
+}
+
+/* ================ EKRANA AKTARMA ================ */
+
+void console_flush(void) {
+    volatile vga_word_t* vga = (volatile vga_word_t*) CONSOLE_VGA_ADDRESS;
+
+    // Satır başına 160 byte: 20 adet 64 bitlik yazma
+    for (uint32_t y = 0; dirty != 0 && y < CONSOLE_ROWS; y++) {
+        if (!(dirty & (1u << y))) continue;
+        dirty &= ~(1u << y);
+
+        const vga_word_t* src = (const vga_word_t*) screen_row(y);
+        volatile vga_word_t* dst = vga + y * (CONSOLE_COLS / CELLS_PER_WORD);
+        for (uint32_t i = 0; i < CONSOLE_COLS / CELLS_PER_WORD; i++) dst[i] = src[i];
+    }
+
+    // Donanım imleci yalnızca yer değiştirdiyse güncellenir (4 port yazması)
+    uint32_t pos = cursor_y * CONSOLE_COLS + cursor_x;
+    if (pos != hw_cursor) {
+        vga_outb(VGA_CRTC_INDEX, 0x0F);
+        vga_outb(VGA_CRTC_DATA, (uint8_t) (pos & 0xFF));
+        vga_outb(VGA_CRTC_INDEX, 0x0E);
+        vga_outb(VGA_CRTC_DATA, (uint8_t) (pos >> 8));
+        hw_cursor = pos;
+    }
+}
+
+void console_write(const char* str, uint32_t len) {
+    for (uint32_t i = 0; i < len; i++) console_putc(str[i]);
+    console_flush();
+}
+
+void console_puts(const char* str) {
+    console_write(str, (uint32_t) strlen(str));
+}
+
+/* ================ BİÇİMLENDİRME ================ */
+
+#define FMT_LEFT 0x01   // '-': sola yasla
+#define FMT_ZERO 0x02   // '0': sıfırla doldur
+
+// Sayıyı verilen tabanda yaz; genişliğe göre boşluk/sıfır ile doldur
+static int put_number(uint64_t value, int negative, uint32_t base, int upper,
+                      int flags, int width) {
+    const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char buffer[24];
+    int n = 0, count = 0;
+
+    do {
+        buffer[n++] = digits[value % base];
+        value /= base;
+    } while (value > 0);
+
+    int length = n + negative;
+    if (negative && (flags & FMT_ZERO)) {
+        console_putc('-');
+        count++;
+        negative = 0;
+    }
+    if (!(flags & FMT_LEFT)) {
+        for (; width > length; width--, count++) console_putc((flags & FMT_ZERO) ? '0' : ' ');
+    }
+    if (negative) {
+        console_putc('-');
+        count++;
+    }
+    while (n > 0) {
+        console_putc(buffer[--n]);
+        count++;
+    }
+    for (; width > length; width--, count++) console_putc(' ');
+    return count;
+}
+
+static int put_string(const char* str, int flags, int width) {
+    int length = (int) strlen(str);
+    int count = 0;
+
+    if (!(flags & FMT_LEFT)) {
+        for (; width > length; width--, count++) console_putc(' ');
+    }
+    while (*str) {
+        console_putc(*str++);
+        count++;
+    }
+    for (; width > length; width--, count++) console_putc(' ');
+    return count;
+}
+
+int console_vprintf(const char* fmt, va_list args) {
+    int count = 0;
+
+    for (; *fmt; fmt++) {
+        if (*fmt != '%') {
+            console_putc(*fmt);
+            count++;
+            continue;
+        }
+
+        int flags = 0, width = 0, longs = 0;
+        for (fmt++; *fmt == '-' || *fmt == '0'; fmt++) {
+            flags |= *fmt == '-' ? FMT_LEFT : FMT_ZERO;
+        }
+        if (*fmt == '*') {
+            width = va_arg(args, int);
+            fmt++;
+        } else {
+            while (*fmt >= '0' && *fmt <= '9') width = width * 10 + (*fmt++ - '0');
+        }
+        while (*fmt == 'l') {
+            longs++;
+            fmt++;
+        }
+        if (flags & FMT_LEFT) flags &= ~FMT_ZERO;
+
+        switch (*fmt) {
+        case 'c':
+            console_putc((char) va_arg(args, int));
+            count++;
+            break;
+        case 's': {
+            const char* str = va_arg(args, const char*);
+            count += put_string(str ? str : "(null)", flags, width);
+            break;
+        }
+        case 'd':
+        case 'i': {
+            int64_t value = longs >= 2 ? va_arg(args, long long)
+                          : longs == 1 ? va_arg(args, long) : va_arg(args, int);
+            uint64_t magnitude = value < 0 ? 0 - (uint64_t) value : (uint64_t) value;
+            count += put_number(magnitude, value < 0, 10, 0, flags, width);
+            break;
+        }
+        case 'u':
+        case 'x':
+        case 'X': {
+            uint64_t value = longs >= 2 ? va_arg(args, unsigned long long)
+                           : longs == 1 ? va_arg(args, unsigned long) : va_arg(args, unsigned int);
+            count += put_number(value, 0, *fmt == 'u' ? 10 : 16, *fmt == 'X', flags, width);
+            break;
+        }
+        case 'p':
+            count += put_string("0x", 0, 0);
+            count += put_number((uintptr_t) va_arg(args, void*), 0, 16, 0, FMT_ZERO,
+                                (int) sizeof(void*) * 2);
+            break;
+        case '%':
+            console_putc('%');
+            count++;
+            break;
+        case '\0':
+            fmt--;   // Dizgi '%' ile bitti
+            break;
+        default:
+            console_putc('%');
+            console_putc(*fmt);
+            count += 2;
+            break;
+        }
+    }
+    return count;
+}
+
+int console_printf(const char* fmt, ...) {
+    va_list args;
+
+    va_start(args, fmt);
+    int count = console_vprintf(fmt, args);
+    va_end(args);
+    console_flush();
+    return count;
+}
@@ -0,0 +1,43 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <stdarg.h>
+#include <stdint.h>
+
+// VGA metin modu konsolu. Karakterler önce bellekteki bir gölge ekrana
+// yazılır; satır sonu, tab ve kaydırma orada işlenir. Değişen satırlar bir
+// bit maskesinde tutulur ve console_flush (her console_write/printf
+// sonunda otomatik) yalnızca bu satırları 64 bitlik yazmalarla 0xB8000'e
+// kopyalar. Kaydırma gölge ekranda bir halka indeksiyle yapılır; satırlar
+// bellekte kaydırılmaz.
+
+#define CONSOLE_COLS         80
+#define CONSOLE_ROWS         25
+#define CONSOLE_VGA_ADDRESS  0xB8000
+#define CONSOLE_TAB_WIDTH    8
+#define CONSOLE_DEFAULT_ATTR 0x0F     // Siyah zemin üzerine beyaz
+
+// Gölge ekranı temizle, imleci (0,0)'a al ve ekranı yenile
+void console_init(uint8_t attribute);
+void console_clear(void);
+
+// Sonraki karakterlerin rengi (VGA öznitelik byte'ı)
+void console_set_attribute(uint8_t attribute);
+
+// Gölge ekrana yaz (ekrana console_flush ile gider)
+void console_putc(char c);
+
+// len byte / sonlandırılmış dizgi yaz ve kirli satırları ekrana aktar
+void console_write(const char* str, uint32_t len);
+void console_puts(const char* str);
+
+// printf alt kümesi: %c %s %d %i %u %x %X %p %%; bayraklar '-' ve '0',
+// genişlik (sayı ya da '*'), uzunluk 'l' / 'll'. Yazılan karakter sayısını
+// döndürür.
+int console_printf(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+int console_vprintf(const char* fmt, va_list args);
+
+// Kirli satırları VGA belleğine yaz ve donanım imlecini güncelle
+void console_flush(void);
+
+#endif
@@ -90,8 +90,8 @@ void *scan_applications(void *data) {
             continue;
         }
 
-        // Kök dizindeki dosyaları oku
-        FileInfo *files = fat32_read_directory("/");
+        // Kök dizindeki .exe içeren dosyaları oku
+        FileInfo *files = fat32_list_extension("/", ".exe", FAT32_MATCH_CONTAINS);
         if (files == NULL) {
             fprintf(stderr, "Dosyalar okunamadı!\n");
             sleep(APP_SCAN_INTERVAL / 1000);
@@ -104,13 +104,11 @@ void *scan_applications(void *data) {
         // Mevcut butonları temizle
         remove_desktop_buttons();
 
-        // Dosyaları tarayarak .exe uzantılı olanları bul ve buton ekle
+        // Listelenen her dosya için buton ekle
         int x = 50, y = 50;
         for (int i = 0; files[i].name != NULL; i++) {
-            if (strstr(files[i].name, ".exe") != NULL) {
-                add_desktop_button(files[i].name, x, y);
-                y += BUTTON_HEIGHT + 10; // Butonları dikey olarak yerleştir
-            }
+            add_desktop_button(files[i].name, x, y);
+            y += BUTTON_HEIGHT + 10; // Butonları dikey olarak yerleştir
         }
 
         // Masaüstü butonlarını güncelleme işlemi tamamlandı, kilidi aç
@@ -0,0 +1,300 @@
+#include <string.h>
+#include "dir_index.h"
+
+#define DIR_INDEX_NIL 0xFFFF
+
+// İndekslenen girdi; adlar slotun ad havuzunda tutulur
+typedef struct {
+    uint32_t first_cluster;
+    uint32_t file_size;
+    uint32_t dirent_lba;
+    uint16_t dirent_offset;
+    uint16_t name_off;      // Görünen ad (havuz konumu)
+    uint16_t short_off;     // 8.3 ad (havuz konumu)
+    uint16_t next_name;     // Aynı ad kovasındaki sonraki girdi
+    uint16_t next_short;    // Aynı 8.3 kovasındaki sonraki girdi
+    uint16_t next_ext;      // Aynı uzantıdaki sonraki girdi (dizin sırasıyla)
+    uint8_t  attributes;
+} dir_index_entry_t;
+
+typedef struct {
+    uint32_t dir_cluster;   // İndekslenen dizin
+    uint32_t generation;    // Kurulduğu andaki nesil
+    uint32_t last_used;     // LRU için kullanım sayacı
+    uint8_t  valid;
+    uint8_t  complete;      // Tüm dizin sığdı mı?
+    uint16_t count;
+    uint16_t pool_used;
+    uint16_t name_hash[DIR_INDEX_HASH_SIZE];
+    uint16_t short_hash[DIR_INDEX_HASH_SIZE];
+    uint16_t ext_head[DIR_INDEX_EXT_BUCKETS];
+    uint16_t ext_tail[DIR_INDEX_EXT_BUCKETS];
+    dir_index_entry_t entries[DIR_INDEX_MAX_ENTRIES];
+    char pool[DIR_INDEX_NAME_POOL];
+} dir_index_slot_t;
+
+static dir_index_slot_t slots[DIR_INDEX_SLOTS];
+static uint32_t generations[DIR_INDEX_GENERATIONS];
+static uint32_t use_clock = 0;
+static dir_index_stats_t stats;
+
+/* ================ YARDIMCI FONKSİYONLAR ================ */
+
+static inline char to_lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? (char) (c - 'A' + 'a') : c;
+}
+
+// Küçük harfe çevrilmiş ad üzerinde FNV-1a (len < 0: NUL'a kadar)
+static uint32_t name_hash(const char* name, int len) {
+    uint32_t h = 2166136261u;
+    for (int i = 0; len < 0 ? name[i] != '\0' : i < len; i++) {
+        h ^= (uint8_t) to_lower(name[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static int name_equal(const char* a, const char* b) {
+    while (*a && to_lower(*a) == to_lower(*b)) {
+        a++;
+        b++;
+    }
+    return to_lower(*a) == to_lower(*b);
+}
+
+// Adın uzantısı (son noktadan sonrası); yoksa NULL
+static const char* name_extension(const char* name) {
+    const char* dot = 0;
+    for (const char* p = name; *p; p++) {
+        if (*p == '.') dot = p;
+    }
+    return (dot && dot != name) ? dot + 1 : 0;
+}
+
+static inline uint32_t ext_bucket(const char* ext) {
+    return name_hash(ext, -1) & (DIR_INDEX_EXT_BUCKETS - 1);
+}
+
+static inline uint32_t generation_of(uint32_t dir_cluster) {
+    return generations[dir_cluster % DIR_INDEX_GENERATIONS];
+}
+
+static int pool_add(dir_index_slot_t* slot, const char* name, uint16_t* off) {
+    size_t len = strlen(name) + 1;
+    if (slot->pool_used + len > DIR_INDEX_NAME_POOL) return -1;
+
+    memcpy(slot->pool + slot->pool_used, name, len);
+    *off = slot->pool_used;
+    slot->pool_used += (uint16_t) len;
+    return 0;
+}
+
+// Dizin taraması sırasında her girdiyi slota ekle
+static int index_visit(const DIR_ENTRY* entry, void* ctx) {
+    dir_index_slot_t* slot = ctx;
+
+    if (slot->count >= DIR_INDEX_MAX_ENTRIES) {
+        slot->complete = 0;
+        return 1;
+    }
+
+    uint16_t idx = slot->count;
+    dir_index_entry_t* e = &slot->entries[idx];
+
+    if (pool_add(slot, entry->name, &e->name_off) != 0) {
+        slot->complete = 0;
+        return 1;
+    }
+    e->short_off = e->name_off;
+    if (!name_equal(entry->name, entry->short_name) &&
+        pool_add(slot, entry->short_name, &e->short_off) != 0) {
+        slot->complete = 0;
+        return 1;
+    }
+
+    e->first_cluster = entry->first_cluster;
+    e->file_size = entry->file_size;
+    e->dirent_lba = entry->dirent_lba;
+    e->dirent_offset = entry->dirent_offset;
+    e->attributes = entry->attributes;
+
+    uint32_t h = name_hash(entry->name, -1) & (DIR_INDEX_HASH_SIZE - 1);
+    e->next_name = slot->name_hash[h];
+    slot->name_hash[h] = idx;
+
+    h = name_hash(entry->short_name, -1) & (DIR_INDEX_HASH_SIZE - 1);
+    e->next_short = slot->short_hash[h];
+    slot->short_hash[h] = idx;
+
+    // Uzantı zinciri dizin sırasını korusun diye sona eklenir
+    e->next_ext = DIR_INDEX_NIL;
+    const char* ext = name_extension(entry->name);
+    if (ext && !(entry->attributes & FAT32_ATTR_DIRECTORY)) {
+        uint32_t b = ext_bucket(ext);
+        if (slot->ext_tail[b] != DIR_INDEX_NIL) {
+            slot->entries[slot->ext_tail[b]].next_ext = idx;
+        } else {
+            slot->ext_head[b] = idx;
+        }
+        slot->ext_tail[b] = idx;
+    }
+
+    slot->count++;
+    return 0;
+}
+
+// Dizinin geçerli indeksini bul; yoksa en az kullanılan slotta kur
+static dir_index_slot_t* index_get(const fat32_volume_t* vol, uint32_t dir_cluster) {
+    uint32_t generation = generation_of(dir_cluster);
+    dir_index_slot_t* victim = &slots[0];
+
+    for (uint32_t i = 0; i < DIR_INDEX_SLOTS; i++) {
+        dir_index_slot_t* slot = &slots[i];
+        if (slot->valid && slot->dir_cluster == dir_cluster && slot->generation == generation) {
+            slot->last_used = ++use_clock;
+            return slot;
+        }
+        if (!slot->valid || (victim->valid && slot->last_used < victim->last_used)) {
+            victim = slot;
+        }
+    }
+
+    victim->valid = 0;
+    victim->dir_cluster = dir_cluster;
+    victim->generation = generation;
+    victim->complete = 1;
+    victim->count = 0;
+    victim->pool_used = 0;
+    for (uint32_t i = 0; i < DIR_INDEX_HASH_SIZE; i++) {
+        victim->name_hash[i] = DIR_INDEX_NIL;
+        victim->short_hash[i] = DIR_INDEX_NIL;
+    }
+    for (uint32_t i = 0; i < DIR_INDEX_EXT_BUCKETS; i++) {
+        victim->ext_head[i] = DIR_INDEX_NIL;
+        victim->ext_tail[i] = DIR_INDEX_NIL;
+    }
+
+    if (fat32_walk_directory(vol, dir_cluster, index_visit, victim) < 0) {
+        return 0;
+    }
+    stats.builds++;
+    victim->valid = 1;
+    victim->last_used = ++use_clock;
+    return victim;
+}
+
+static void entry_export(const dir_index_slot_t* slot, const dir_index_entry_t* e, DIR_ENTRY* out) {
+    strcpy(out->name, slot->pool + e->name_off);
+    strcpy(out->short_name, slot->pool + e->short_off);
+    out->attributes = e->attributes;
+    out->first_cluster = e->first_cluster;
+    out->file_size = e->file_size;
+    out->dirent_lba = e->dirent_lba;
+    out->dirent_offset = e->dirent_offset;
+}
+
+/* ================ DOĞRUSAL TARAMA (İNDEKS DOLU) ================ */
+
+typedef struct {
+    const char* name;
+    const char* ext;
+    DIR_ENTRY* out;
+    fat32_dir_visit_t visit;
+    void* ctx;
+} scan_ctx_t;
+
+static int scan_lookup_visit(const DIR_ENTRY* entry, void* ctx) {
+    scan_ctx_t* scan = ctx;
+    if (name_equal(entry->name, scan->name) || name_equal(entry->short_name, scan->name)) {
+        *scan->out = *entry;
+        return 1;
+    }
+    return 0;
+}
+
+static int scan_ext_visit(const DIR_ENTRY* entry, void* ctx) {
+    scan_ctx_t* scan = ctx;
+    const char* ext = name_extension(entry->name);
+    if (!scan->ext ||
+        (ext && !(entry->attributes & FAT32_ATTR_DIRECTORY) && name_equal(ext, scan->ext))) {
+        return scan->visit(entry, scan->ctx);
+    }
+    return 0;
+}
+
+/* ================ GENEL FONKSİYONLAR ================ */
+
+int dir_index_lookup(const fat32_volume_t* vol, uint32_t dir_cluster,
+                     const char* name, DIR_ENTRY* out) {
+    dir_index_slot_t* slot = index_get(vol, dir_cluster);
+    if (!slot) return -1;
+    stats.lookups++;
+
+    uint32_t h = name_hash(name, -1) & (DIR_INDEX_HASH_SIZE - 1);
+    for (uint16_t i = slot->name_hash[h]; i != DIR_INDEX_NIL; i = slot->entries[i].next_name) {
+        if (name_equal(slot->pool + slot->entries[i].name_off, name)) {
+            entry_export(slot, &slot->entries[i], out);
+            return 0;
+        }
+    }
+    for (uint16_t i = slot->short_hash[h]; i != DIR_INDEX_NIL; i = slot->entries[i].next_short) {
+        if (name_equal(slot->pool + slot->entries[i].short_off, name)) {
+            entry_export(slot, &slot->entries[i], out);
+            return 0;
+        }
+    }
+
+    if (slot->complete) return -1;
+
+    // İndekse sığmayan girdiler arasında olabilir
+    scan_ctx_t scan = { name, 0, out, 0, 0 };
+    stats.fallbacks++;
+    return fat32_walk_directory(vol, dir_cluster, scan_lookup_visit, &scan) == 1 ? 0 : -1;
+}
+
+int dir_index_foreach(const fat32_volume_t* vol, uint32_t dir_cluster, const char* ext,
+                      fat32_dir_visit_t visit, void* ctx) {
+    DIR_ENTRY entry;
+    dir_index_slot_t* slot = index_get(vol, dir_cluster);
+    if (!slot) return -1;
+
+    if (ext && *ext == '.') ext++;
+
+    if (!slot->complete) {
+        scan_ctx_t scan = { 0, ext, 0, visit, ctx };
+        stats.fallbacks++;
+        return fat32_walk_directory(vol, dir_cluster, scan_ext_visit, &scan);
+    }
+
+    if (!ext) {
+        for (uint16_t i = 0; i < slot->count; i++) {
+            entry_export(slot, &slot->entries[i], &entry);
+            if (visit(&entry, ctx)) return 1;
+        }
+        return 0;
+    }
+
+    // Aynı kovaya düşen farklı uzantılar ada bakılarak elenir
+    for (uint16_t i = slot->ext_head[ext_bucket(ext)]; i != DIR_INDEX_NIL; i = slot->entries[i].next_ext) {
+        const char* name_ext = name_extension(slot->pool + slot->entries[i].name_off);
+        if (name_equal(name_ext, ext)) {
+            entry_export(slot, &slot->entries[i], &entry);
+            if (visit(&entry, ctx)) return 1;
+        }
+    }
+    return 0;
+}
+
+void dir_index_invalidate(uint32_t dir_cluster) {
+    generations[dir_cluster % DIR_INDEX_GENERATIONS]++;
+}
+
+void dir_index_reset(void) {
+    for (uint32_t i = 0; i < DIR_INDEX_SLOTS; i++) {
+        slots[i].valid = 0;
+    }
+}
+
+void dir_index_get_stats(dir_index_stats_t* out) {
+    *out = stats;
+}
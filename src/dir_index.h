@@ -0,0 +1,42 @@
+#ifndef DIR_INDEX_H
+#define DIR_INDEX_H
+
+#include <stdint.h>
+#include "fat32.h"
+
+// Dizin indeksi: bir dizin ilk erişildiğinde bir kez taranır; uzun ve 8.3
+// adların (küçük harfe çevrilmiş) hash tabloları ile uzantı bazlı ikincil
+// bir indeks oluşturulur. Dizin değiştiğinde dir_index_invalidate ile nesil
+// sayacı artırılır ve indeks bir sonraki erişimde yeniden kurulur.
+
+#define DIR_INDEX_SLOTS       4      // Aynı anda indekslenen dizin sayısı
+#define DIR_INDEX_MAX_ENTRIES 1024   // Bir dizinde indekslenen en fazla girdi
+#define DIR_INDEX_HASH_SIZE   2048   // Ad hash kovası (2'nin kuvveti)
+#define DIR_INDEX_EXT_BUCKETS 64     // Uzantı hash kovası (2'nin kuvveti)
+#define DIR_INDEX_NAME_POOL   32768  // Adların tutulduğu havuz (byte)
+#define DIR_INDEX_GENERATIONS 256    // Nesil sayacı tablosu
+
+typedef struct {
+    uint64_t builds;      // Diskten yapılan indeks kurulumları
+    uint64_t lookups;     // Ad sorguları
+    uint64_t fallbacks;   // İndeks dolu olduğu için yapılan doğrusal taramalar
+} dir_index_stats_t;
+
+// Dizinde adı (büyük/küçük harf duyarsız, uzun ya da 8.3) ara: 0 bulundu, -1 yok
+int dir_index_lookup(const fat32_volume_t* vol, uint32_t dir_cluster,
+                     const char* name, DIR_ENTRY* out);
+
+// Dizindeki girdileri gez; ext NULL değilse yalnızca o uzantıdaki dosyalar
+// (ör. ".exe") uzantı indeksinden O(k) ile gezilir
+int dir_index_foreach(const fat32_volume_t* vol, uint32_t dir_cluster, const char* ext,
+                      fat32_dir_visit_t visit, void* ctx);
+
+// Dizin değişti: nesil sayacını artır
+void dir_index_invalidate(uint32_t dir_cluster);
+
+// Tüm indeksleri at (farklı bir bölüm mount edildiğinde)
+void dir_index_reset(void);
+
+void dir_index_get_stats(dir_index_stats_t* stats);
+
+#endif
@@ -0,0 +1,158 @@
+#include "disk_io.h"
+
+// Birincil ATA kanalının portları
+#define ATA_DATA          0x1F0
+#define ATA_ERROR         0x1F1
+#define ATA_SECTOR_COUNT  0x1F2
+#define ATA_LBA_LOW       0x1F3
+#define ATA_LBA_MID       0x1F4
+#define ATA_LBA_HIGH      0x1F5
+#define ATA_DRIVE_HEAD    0x1F6
+#define ATA_STATUS        0x1F7
+#define ATA_COMMAND       0x1F7
+#define ATA_ALT_STATUS    0x3F6
+
+// Durum bitleri
+#define ATA_SR_ERR  0x01
+#define ATA_SR_DRQ  0x08
+#define ATA_SR_DF   0x20
+#define ATA_SR_BSY  0x80
+
+// Komutlar
+#define ATA_CMD_READ_PIO   0x20
+#define ATA_CMD_WRITE_PIO  0x30
+#define ATA_CMD_CACHE_FLUSH 0xE7
+#define ATA_CMD_IDENTIFY   0xEC
+
+#define ATA_TIMEOUT 1000000
+
+static inline uint8_t ata_inb(uint16_t port) {
+    uint8_t value;
+    __asm__ volatile ("inb %1, %0" : "=a"(value) : "Nd"(port));
+    return value;
+}
+
+static inline void ata_outb(uint16_t port, uint8_t value) {
+    __asm__ volatile ("outb %0, %1" :: "a"(value), "Nd"(port));
+}
+
+// Bir sektörü (256 word) tek rep insw ile oku
+static inline void ata_read_sector(uint8_t* buffer) {
+    void* dst = buffer;
+    uint32_t count = SECTOR_SIZE / 2;
+    __asm__ volatile ("rep insw" : "+D"(dst), "+c"(count) : "d"((uint16_t) ATA_DATA) : "memory");
+}
+
+static inline void ata_write_sector(const uint8_t* buffer) {
+    const void* src = buffer;
+    uint32_t count = SECTOR_SIZE / 2;
+    __asm__ volatile ("rep outsw" : "+S"(src), "+c"(count) : "d"((uint16_t) ATA_DATA) : "memory");
+}
+
+// BSY bitinin düşmesini bekle
+static int ata_wait_ready(void) {
+    for (uint32_t i = 0; i < ATA_TIMEOUT; i++) {
+        uint8_t status = ata_inb(ATA_STATUS);
+        if (!(status & ATA_SR_BSY)) {
+            return (status & (ATA_SR_ERR | ATA_SR_DF)) ? -1 : 0;
+        }
+    }
+    return -1;
+}
+
+// Veri transferi için DRQ bekle
+static int ata_wait_drq(void) {
+    for (uint32_t i = 0; i < ATA_TIMEOUT; i++) {
+        uint8_t status = ata_inb(ATA_STATUS);
+        if (status & (ATA_SR_ERR | ATA_SR_DF)) return -1;
+        if (!(status & ATA_SR_BSY) && (status & ATA_SR_DRQ)) return 0;
+    }
+    return -1;
+}
+
+// 400ns bekleme: alternatif durum registerını dört kez oku
+static void ata_delay(void) {
+    for (int i = 0; i < 4; i++) {
+        (void) ata_inb(ATA_ALT_STATUS);
+    }
+}
+
+// LBA28 komutunu hazırla (count == 256 için 0 yazılır)
+static int ata_issue(disk_device_t* dev, uint8_t command, uint32_t lba, uint32_t count) {
+    if (ata_wait_ready() != 0) return -1;
+
+    ata_outb(ATA_DRIVE_HEAD, 0xE0 | (dev->drive << 4) | ((lba >> 24) & 0x0F));
+    ata_delay();
+    ata_outb(ATA_SECTOR_COUNT, (uint8_t) count);
+    ata_outb(ATA_LBA_LOW, (uint8_t) lba);
+    ata_outb(ATA_LBA_MID, (uint8_t) (lba >> 8));
+    ata_outb(ATA_LBA_HIGH, (uint8_t) (lba >> 16));
+    ata_outb(ATA_COMMAND, command);
+    return 0;
+}
+
+// Tek bir READ SECTORS komutu ile tüm iov parçalarını doldur.
+// Disk katmanı max_sectors sınırını zaten uyguladığı için toplam <= 256'dır.
+static int ata_readv(disk_device_t* dev, uint32_t lba, const disk_iovec_t* iov, uint32_t iovcnt) {
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < iovcnt; i++) total += iov[i].sectors;
+
+    if (ata_issue(dev, ATA_CMD_READ_PIO, lba, total) != 0) return -1;
+
+    for (uint32_t i = 0; i < iovcnt; i++) {
+        uint8_t* buffer = iov[i].buffer;
+        for (uint32_t s = 0; s < iov[i].sectors; s++) {
+            if (ata_wait_drq() != 0) return -1;
+            ata_read_sector(buffer);
+            buffer += SECTOR_SIZE;
+        }
+    }
+    return 0;
+}
+
+static int ata_writev(disk_device_t* dev, uint32_t lba, const disk_iovec_t* iov, uint32_t iovcnt) {
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < iovcnt; i++) total += iov[i].sectors;
+
+    if (ata_issue(dev, ATA_CMD_WRITE_PIO, lba, total) != 0) return -1;
+
+    for (uint32_t i = 0; i < iovcnt; i++) {
+        const uint8_t* buffer = iov[i].buffer;
+        for (uint32_t s = 0; s < iov[i].sectors; s++) {
+            if (ata_wait_drq() != 0) return -1;
+            ata_write_sector(buffer);
+            buffer += SECTOR_SIZE;
+        }
+    }
+
+    // Disk önbelleğini boşalt
+    ata_outb(ATA_COMMAND, ATA_CMD_CACHE_FLUSH);
+    return ata_wait_ready();
+}
+
+// ATA PIO aygıtını hazırla; IDENTIFY yanıt vermezse -1 döner
+int disk_ata_init(disk_device_t* dev, uint8_t slave) {
+    uint8_t identify[SECTOR_SIZE];
+
+    dev->name = "ata-pio";
+    dev->max_sectors = 256;
+    dev->readv = ata_readv;
+    dev->writev = ata_writev;
+    dev->close = 0;
+    dev->fd = -1;
+    dev->drive = slave ? 1 : 0;
+
+    ata_outb(ATA_DRIVE_HEAD, 0xA0 | (dev->drive << 4));
+    ata_delay();
+    ata_outb(ATA_SECTOR_COUNT, 0);
+    ata_outb(ATA_LBA_LOW, 0);
+    ata_outb(ATA_LBA_MID, 0);
+    ata_outb(ATA_LBA_HIGH, 0);
+    ata_outb(ATA_COMMAND, ATA_CMD_IDENTIFY);
+
+    // Durum 0 ise bu kanalda disk yok
+    if (ata_inb(ATA_STATUS) == 0) return -1;
+    if (ata_wait_drq() != 0) return -1;
+    ata_read_sector(identify);
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include "disk_io.h"
+
+// BIOS disk okuma servisini kullanarak diske veri okuma
+static int bios_read(uint8_t drive, uint32_t lba, uint8_t* buffer, uint32_t sectors) {
+    uint8_t failed = 0;
+    (void) drive;
+
+    __asm__ __volatile__ (
+        "movl %[sectors], %%ecx;"     // Okunacak sektör sayısını ECX'e yerleştir
+        "movl %[lba], %%ebx;"         // LBA'yı EBX'e yerleştir
+        "movl %[buffer], %%edi;"      // Buffer adresini EDI'ye yerleştir
+        "movb $0x02, %%al;"           // Diskin okuma komutu (0x02)
+        "int $0x13;"                  // BIOS Disk servisini çağır
+        "setc %[failed];"             // Carry flag hata demektir
+        : [failed] "=m" (failed)
+        : [lba] "r" (lba), [buffer] "r" ((uint32_t)(uintptr_t) buffer), [sectors] "r" (sectors)
+        : "eax", "ebx", "ecx", "edx", "edi", "esi", "memory"
+    );
+    return failed ? -1 : 0;
+}
+
+// int 0x13 tek çağrıda yalnızca tek bir bitişik buffer'a okuyabilir;
+// birden fazla iov parçası varsa her biri için ayrı çağrı yapılır.
+static int bios_readv(disk_device_t* dev, uint32_t lba, const disk_iovec_t* iov, uint32_t iovcnt) {
+    for (uint32_t i = 0; i < iovcnt; i++) {
+        if (bios_read(dev->drive, lba, iov[i].buffer, iov[i].sectors) != 0) {
+            return -1;
+        }
+        lba += iov[i].sectors;
+    }
+    return 0;
+}
+
+void disk_bios_init(disk_device_t* dev, uint8_t drive) {
+    dev->name = "bios";
+    dev->max_sectors = 127;   // int 0x13 tek çağrıda en fazla 127 sektör okur
+    dev->readv = bios_readv;
+    dev->writev = 0;
+    dev->close = 0;
+    dev->fd = -1;
+    dev->drive = drive;
+}
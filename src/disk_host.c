@@ -0,0 +1,79 @@
+// Host backend: Linux üzerinde bir FAT32 disk imajını blok aygıtı gibi sunar.
+// Bootloader (freestanding) derlemesinde bu dosya boş derlenir.
+#if defined(__linux__) && __STDC_HOSTED__
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include "disk_io.h"
+
+// preadv/pwritev kısa dönebilir; kalan kısmı iov listesinde ilerleyerek tamamla
+static int host_transfer(disk_device_t* dev, int write, uint32_t lba,
+                         const disk_iovec_t* iov, uint32_t iovcnt) {
+    struct iovec vec[DISK_MAX_IOV];
+    off_t offset = (off_t) lba * SECTOR_SIZE;
+    int n = 0;
+
+    for (uint32_t i = 0; i < iovcnt; i++) {
+        vec[n].iov_base = iov[i].buffer;
+        vec[n].iov_len = (size_t) iov[i].sectors * SECTOR_SIZE;
+        n++;
+    }
+
+    struct iovec* cur = vec;
+    while (n > 0) {
+        ssize_t done = write ? pwritev(dev->fd, cur, n, offset)
+                             : preadv(dev->fd, cur, n, offset);
+        if (done < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (done == 0) return -1;  // İmajın sonu aşıldı
+
+        offset += done;
+        while (n > 0 && (size_t) done >= cur->iov_len) {
+            done -= cur->iov_len;
+            cur++;
+            n--;
+        }
+        if (n > 0) {
+            cur->iov_base = (uint8_t*) cur->iov_base + done;
+            cur->iov_len -= done;
+        }
+    }
+    return 0;
+}
+
+static int host_readv(disk_device_t* dev, uint32_t lba, const disk_iovec_t* iov, uint32_t iovcnt) {
+    return host_transfer(dev, 0, lba, iov, iovcnt);
+}
+
+static int host_writev(disk_device_t* dev, uint32_t lba, const disk_iovec_t* iov, uint32_t iovcnt) {
+    return host_transfer(dev, 1, lba, iov, iovcnt);
+}
+
+static void host_close(disk_device_t* dev) {
+    if (dev->fd >= 0) {
+        close(dev->fd);
+        dev->fd = -1;
+    }
+}
+
+// Disk imajını aç; writable == 0 ise yazma desteklenmez
+int disk_host_open(disk_device_t* dev, const char* path, int writable) {
+    int fd = open(path, (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+    if (fd < 0) return -1;
+
+    dev->name = "host";
+    dev->max_sectors = 2048;   // 1 MiB'lık tek preadv
+    dev->readv = host_readv;
+    dev->writev = writable ? host_writev : 0;
+    dev->close = host_close;
+    dev->fd = fd;
+    dev->drive = 0;
+    return 0;
+}
+
+#endif
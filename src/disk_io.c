@@ -1,15 +1,178 @@
 #include "disk_io.h"
 
-// BIOS disk okuma servisini kullanarak diske veri okuma
-void read_sectors(uint32_t lba, uint8_t* buffer, uint32_t sectors) {
-    __asm__ __volatile__ (
-        "movl %[sectors], %%ecx;"     // Okunacak sektör sayısını ECX'e yerleştir
-        "movl %[lba], %%ebx;"         // LBA'yı EBX'e yerleştir
-        "movl %[buffer], %%edi;"      // Buffer adresini EDI'ye yerleştir
-        "movb $0x02, %%al;"           // Diskin okuma komutu (0x02)
-        "int $0x13;"                  // BIOS Disk servisini çağır
-        :
-        : [lba] "r" (lba), [buffer] "r" (buffer), [sectors] "r" (sectors)
-        : "eax", "ebx", "ecx", "edx", "edi", "esi"
-    );
+// Varsayılan aygıt: ilk sabit disk üzerinden BIOS int 0x13
+static disk_device_t bios_device;
+static disk_device_t* active_device = 0;
+
+static disk_stats_t disk_stats;
+
+void disk_set_device(disk_device_t* dev) {
+    active_device = dev;
+}
+
+disk_device_t* disk_get_device(void) {
+    if (!active_device) {
+        disk_bios_init(&bios_device, 0x80);
+        active_device = &bios_device;
+    }
+    return active_device;
+}
+
+// Sayaçlar disk kuyruğunun iş parçacıklarından da güncellenir
+#define STAT_ADD(field, n) __atomic_fetch_add(&disk_stats.field, (n), __ATOMIC_RELAXED)
+
+// Tek bir komutu aygıta gönder ve istatistikleri güncelle
+static int disk_issue(disk_device_t* dev, int write, uint32_t lba,
+                      const disk_iovec_t* iov, uint32_t iovcnt, uint32_t total) {
+    int ret = write ? dev->writev(dev, lba, iov, iovcnt)
+                    : dev->readv(dev, lba, iov, iovcnt);
+    if (ret != 0) {
+        STAT_ADD(errors, 1);
+        return -1;
+    }
+    if (write) {
+        STAT_ADD(write_commands, 1);
+        STAT_ADD(sectors_written, total);
+    } else {
+        STAT_ADD(read_commands, 1);
+        STAT_ADD(sectors_read, total);
+    }
+    return 0;
+}
+
+// Bir iov listesini aygıtın komut sınırına (max_sectors) bölerek gönder
+static int disk_submit(disk_device_t* dev, int write, uint32_t lba,
+                       const disk_iovec_t* iov, uint32_t iovcnt) {
+    disk_iovec_t chunk[DISK_MAX_IOV];
+    uint32_t n = 0, total = 0;
+
+    for (uint32_t i = 0; i < iovcnt; i++) {
+        uint8_t* buffer = iov[i].buffer;
+        uint32_t left = iov[i].sectors;
+
+        while (left > 0) {
+            uint32_t take = left;
+            if (total + take > dev->max_sectors) {
+                take = dev->max_sectors - total;
+            }
+
+            chunk[n].buffer = buffer;
+            chunk[n].sectors = take;
+            n++;
+            total += take;
+            buffer += take * SECTOR_SIZE;
+            left -= take;
+
+            // Komut dolduysa aygıta gönder ve yeni komuta başla
+            if (total == dev->max_sectors || n == DISK_MAX_IOV) {
+                if (disk_issue(dev, write, lba, chunk, n, total) != 0) return -1;
+                lba += total;
+                n = 0;
+                total = 0;
+            }
+        }
+    }
+
+    if (n > 0) {
+        return disk_issue(dev, write, lba, chunk, n, total);
+    }
+    return 0;
+}
+
+int disk_transfer(disk_device_t* dev, int write, uint32_t lba,
+                  const disk_iovec_t* iov, uint32_t iovcnt) {
+    if (write && !dev->writev) return -1;
+    return disk_submit(dev, write, lba, iov, iovcnt);
+}
+
+int read_sectors(uint32_t lba, uint8_t* buffer, uint32_t sectors) {
+    disk_iovec_t iov = { buffer, sectors };
+    if (sectors == 0) return 0;
+    return disk_submit(disk_get_device(), 0, lba, &iov, 1);
+}
+
+int write_sectors(uint32_t lba, const uint8_t* buffer, uint32_t sectors) {
+    disk_iovec_t iov = { (uint8_t*) buffer, sectors };
+    disk_device_t* dev = disk_get_device();
+    if (sectors == 0) return 0;
+    if (!dev->writev) return -1;
+    return disk_submit(dev, 1, lba, &iov, 1);
+}
+
+// İstekleri LBA'ya göre sırala (küçük listeler için insertion sort yeterli)
+static void disk_sort_requests(disk_request_t* reqs, uint32_t count) {
+    for (uint32_t i = 1; i < count; i++) {
+        disk_request_t key = reqs[i];
+        uint32_t j = i;
+        while (j > 0 && reqs[j - 1].lba > key.lba) {
+            reqs[j] = reqs[j - 1];
+            j--;
+        }
+        reqs[j] = key;
+    }
+}
+
+// Bitişik istekleri tek bir vektörel komutta birleştirerek işle
+static int disk_batch(disk_request_t* reqs, uint32_t count, int write) {
+    disk_device_t* dev = disk_get_device();
+    disk_iovec_t iov[DISK_MAX_IOV];
+    int result = 0;
+
+    if (write && !dev->writev) return -1;
+
+    disk_sort_requests(reqs, count);
+
+    uint32_t i = 0;
+    while (i < count) {
+        uint32_t first = i;
+        uint32_t next_lba = reqs[i].lba + reqs[i].sectors;
+        uint32_t n = 1;
+
+        iov[0].buffer = reqs[i].buffer;
+        iov[0].sectors = reqs[i].sectors;
+        i++;
+
+        // Bir önceki isteğin bittiği yerden başlayanları aynı komuta ekle
+        while (i < count && n < DISK_MAX_IOV && reqs[i].lba == next_lba) {
+            iov[n].buffer = reqs[i].buffer;
+            iov[n].sectors = reqs[i].sectors;
+            next_lba += reqs[i].sectors;
+            n++;
+            i++;
+        }
+        STAT_ADD(merged_requests, n - 1);
+
+        int status = disk_submit(dev, write, reqs[first].lba, iov, n);
+        for (uint32_t k = first; k < i; k++) {
+            reqs[k].status = status;
+        }
+        if (status != 0) result = -1;
+    }
+    return result;
+}
+
+int disk_read_batch(disk_request_t* reqs, uint32_t count) {
+    return disk_batch(reqs, count, 0);
+}
+
+int disk_write_batch(disk_request_t* reqs, uint32_t count) {
+    return disk_batch(reqs, count, 1);
+}
+
+void disk_close(disk_device_t* dev) {
+    if (dev->close) {
+        dev->close(dev);
+    }
+    if (active_device == dev) {
+        active_device = 0;
+    }
+}
+
+void disk_get_stats(disk_stats_t* stats) {
+    *stats = disk_stats;
+}
+
+void disk_reset_stats(void) {
+    disk_stats_t zero = {0};
+    disk_stats = zero;
 }
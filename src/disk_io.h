@@ -3,6 +3,76 @@
 
 #include <stdint.h>
 
-void read_sectors(uint32_t lba, uint8_t* buffer, uint32_t sectors);
+#define SECTOR_SIZE 512
+
+// Tek bir birleştirilmiş komutta kullanılabilecek en fazla buffer parçası
+#define DISK_MAX_IOV 32
+
+// Diskte art arda gelen sektörlere karşılık gelen bir bellek parçası
+typedef struct {
+    uint8_t* buffer;   // Okunacak/yazılacak bellek
+    uint32_t sectors;  // Bu parçadaki sektör sayısı
+} disk_iovec_t;
+
+// Toplu okuma/yazma isteği (disk_read_batch / disk_write_batch)
+typedef struct {
+    uint32_t lba;      // Başlangıç sektörü
+    uint8_t* buffer;   // Bellek adresi
+    uint32_t sectors;  // Sektör sayısı
+    int      status;   // 0: başarılı, -1: hata
+} disk_request_t;
+
+// Blok aygıtı arayüzü: her backend (BIOS, ATA PIO, host imaj) bu yapıyı doldurur.
+// readv/writev, lba'dan başlayarak diskte bitişik olan sektörleri iov
+// parçalarına dağıtır; yani tek bir disk komutu birden fazla buffer'a yazabilir.
+typedef struct disk_device {
+    const char* name;        // Backend adı
+    uint32_t max_sectors;    // Tek komutta aktarılabilecek en fazla sektör
+    int (*readv)(struct disk_device* dev, uint32_t lba, const disk_iovec_t* iov, uint32_t iovcnt);
+    int (*writev)(struct disk_device* dev, uint32_t lba, const disk_iovec_t* iov, uint32_t iovcnt);
+    void (*close)(struct disk_device* dev);
+    int   fd;                // Host backend için dosya tanımlayıcısı
+    uint8_t drive;           // BIOS sürücü numarası / ATA master-slave seçimi
+} disk_device_t;
+
+// Disk katmanı istatistikleri
+typedef struct {
+    uint64_t read_commands;    // Aygıta gönderilen okuma komutları
+    uint64_t sectors_read;     // Okunan toplam sektör
+    uint64_t write_commands;   // Aygıta gönderilen yazma komutları
+    uint64_t sectors_written;  // Yazılan toplam sektör
+    uint64_t merged_requests;  // Başka bir istekle birleştirilen istek sayısı
+    uint64_t errors;           // Başarısız komut sayısı
+} disk_stats_t;
+
+// Aktif aygıtı seç (NULL verilirse varsayılan BIOS aygıtına dönülür)
+void disk_set_device(disk_device_t* dev);
+disk_device_t* disk_get_device(void);
+
+// Tekil okuma/yazma: 0 başarılı, -1 hata
+int read_sectors(uint32_t lba, uint8_t* buffer, uint32_t sectors);
+int write_sectors(uint32_t lba, const uint8_t* buffer, uint32_t sectors);
+
+// Diskte lba'dan başlayan bitişik sektörleri iov parçalarına aktar; komut
+// aygıtın max_sectors sınırına göre bölünür. Aygıt backend'i izin veriyorsa
+// (host) farklı iş parçacıklarından aynı anda çağrılabilir.
+int disk_transfer(disk_device_t* dev, int write, uint32_t lba,
+                  const disk_iovec_t* iov, uint32_t iovcnt);
+
+// Toplu okuma/yazma: istekler LBA'ya göre sıralanır, bitişik olanlar tek
+// komutta birleştirilir. Herhangi bir istek başarısız olursa -1 döner.
+int disk_read_batch(disk_request_t* reqs, uint32_t count);
+int disk_write_batch(disk_request_t* reqs, uint32_t count);
+
+// Aygıtı kapat (host backend dosyayı kapatır)
+void disk_close(disk_device_t* dev);
+
+void disk_get_stats(disk_stats_t* stats);
+void disk_reset_stats(void);
+
+// Backend'ler
+void disk_bios_init(disk_device_t* dev, uint8_t drive);
+int  disk_ata_init(disk_device_t* dev, uint8_t slave);
+int  disk_host_open(disk_device_t* dev, const char* path, int writable);
 
 #endif
@@ -0,0 +1,338 @@
+#include <string.h>
+#include "disk_queue.h"
+
+// Host derlemesinde komutlar bir iş parçacığı havuzunda yürütülür;
+// bootloader (freestanding) derlemesinde kilitler boş makrolardır.
+#if defined(__linux__) && __STDC_HOSTED__
+#define DISK_QUEUE_THREADS 1
+#include <pthread.h>
+
+static pthread_mutex_t queue_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t work_cond = PTHREAD_COND_INITIALIZER;  // Worker'lara iş geldi
+static pthread_cond_t done_cond = PTHREAD_COND_INITIALIZER;  // Bir komut tamamlandı
+static pthread_t workers[DISK_QUEUE_MAX_WORKERS];
+static int stopping = 0;
+
+#define QUEUE_LOCK()   pthread_mutex_lock(&queue_lock)
+#define QUEUE_UNLOCK() pthread_mutex_unlock(&queue_lock)
+#else
+#define DISK_QUEUE_THREADS 0
+#define QUEUE_LOCK()
+#define QUEUE_UNLOCK()
+#endif
+
+// Birleştirilmiş istekler: aygıta giden tek bir komut
+typedef struct disk_queue_job {
+    disk_device_t* dev;
+    uint8_t  direction;
+    uint32_t lba;
+    uint32_t next_lba;              // Birleştirme için komutun bittiği sektör
+    uint32_t iovcnt;
+    disk_iovec_t iov[DISK_MAX_IOV];
+    disk_async_request_t* reqs;     // Komuttaki istekler (next ile bağlı)
+    disk_async_request_t* reqs_tail;
+    struct disk_queue_job* next;
+} disk_queue_job_t;
+
+static disk_queue_job_t jobs[DISK_QUEUE_JOBS];
+static disk_queue_job_t* job_free = 0;
+static disk_queue_job_t* run_head = 0;     // Yürütülmeyi bekleyen komutlar
+static disk_queue_job_t* run_tail = 0;
+
+static disk_async_request_t* pending[DISK_QUEUE_DEPTH];   // Henüz komuta dönüşmemiş
+static disk_async_request_t* sweep[DISK_QUEUE_DEPTH];
+static uint32_t pending_count = 0;
+
+static disk_async_request_t* done_head = 0;  // Callback'i bekleyen istekler
+static disk_async_request_t* done_tail = 0;
+
+static uint32_t outstanding = 0;    // Gönderilmiş, callback'i çağrılmamış istekler
+static uint32_t running = 0;        // Uçuştaki komutlar
+static uint32_t head_lba = 0;       // Asansörün son konumu
+static uint32_t worker_count = 0;
+static uint64_t errors = 0;         // Hata ile tamamlanan istekler
+static int initialized = 0;
+
+static disk_queue_stats_t stats;
+
+/* ================ YARDIMCI FONKSİYONLAR ================ */
+
+static void queue_setup(void) {
+    if (initialized) return;
+    job_free = 0;
+    for (uint32_t i = 0; i < DISK_QUEUE_JOBS; i++) {
+        jobs[i].next = job_free;
+        job_free = &jobs[i];
+    }
+    initialized = 1;
+}
+
+// Bekleyenleri LBA'ya göre sırala (insertion sort; liste genelde zaten sıralı)
+static void sort_pending(void) {
+    for (uint32_t i = 1; i < pending_count; i++) {
+        disk_async_request_t* key = pending[i];
+        uint32_t j = i;
+        while (j > 0 && pending[j - 1]->lba > key->lba) {
+            pending[j] = pending[j - 1];
+            j--;
+        }
+        pending[j] = key;
+    }
+}
+
+static void job_launch(disk_queue_job_t* job) {
+    job->next = 0;
+    if (run_tail) run_tail->next = job;
+    else run_head = job;
+    run_tail = job;
+
+    running++;
+    stats.commands++;
+    if (running > stats.max_in_flight) stats.max_in_flight = running;
+#if DISK_QUEUE_THREADS
+    if (worker_count > 0) pthread_cond_signal(&work_cond);
+#endif
+}
+
+// Bekleyen istekleri C-SCAN sırasında komutlara dönüştür (kilit altında)
+static void queue_dispatch(void) {
+    disk_device_t* dev;
+    disk_queue_job_t* job = 0;
+    uint32_t start = 0, k;
+
+    if (pending_count == 0) return;
+    dev = disk_get_device();
+    sort_pending();
+
+    // Son konumdan ileriye doğru tara, sonra en baştan devam et
+    while (start < pending_count && pending[start]->lba < head_lba) start++;
+    for (k = 0; k < pending_count; k++) {
+        sweep[k] = pending[(start + k) % pending_count];
+    }
+
+    for (k = 0; k < pending_count; k++) {
+        disk_async_request_t* req = sweep[k];
+        req->next = 0;
+
+        if (job && job->direction == req->direction && job->next_lba == req->lba &&
+            job->iovcnt < DISK_MAX_IOV) {
+            // Önceki isteğin bittiği yerden devam ediyor: aynı komuta ekle
+            job->reqs_tail->next = req;
+            job->reqs_tail = req;
+            stats.merged++;
+        } else {
+            if (!job_free) break;   // Tüm komutlar uçuşta; kalanlar beklesin
+            if (job) job_launch(job);
+
+            job = job_free;
+            job_free = job->next;
+            job->dev = dev;
+            job->direction = req->direction;
+            job->lba = req->lba;
+            job->next_lba = req->lba;
+            job->iovcnt = 0;
+            job->reqs = job->reqs_tail = req;
+        }
+
+        job->iov[job->iovcnt].buffer = req->buffer;
+        job->iov[job->iovcnt].sectors = req->sectors;
+        job->iovcnt++;
+        job->next_lba += req->sectors;
+    }
+
+    if (job) {
+        job_launch(job);
+        head_lba = job->next_lba;
+    }
+
+    // Komuta dönüşemeyenler bir sonraki poll'u bekler
+    uint32_t left = pending_count - k;
+    memcpy(pending, sweep + k, left * sizeof(pending[0]));
+    pending_count = left;
+}
+
+static void job_execute(disk_queue_job_t* job) {
+    int status = disk_transfer(job->dev, job->direction, job->lba, job->iov, job->iovcnt);
+    for (disk_async_request_t* req = job->reqs; req; req = req->next) {
+        req->result = status;
+    }
+}
+
+// Komutun isteklerini tamamlananlara taşı, komutu serbest bırak (kilit altında)
+static void job_complete(disk_queue_job_t* job) {
+    if (done_tail) done_tail->next = job->reqs;
+    else done_head = job->reqs;
+    done_tail = job->reqs_tail;
+
+    job->next = job_free;
+    job_free = job;
+    running--;
+}
+
+#if DISK_QUEUE_THREADS
+static void* worker_main(void* arg) {
+    (void) arg;
+
+    QUEUE_LOCK();
+    for (;;) {
+        while (!run_head && !stopping) {
+            pthread_cond_wait(&work_cond, &queue_lock);
+        }
+        disk_queue_job_t* job = run_head;
+        if (!job) break;
+        run_head = job->next;
+        if (!run_head) run_tail = 0;
+
+        QUEUE_UNLOCK();
+        job_execute(job);
+        QUEUE_LOCK();
+
+        job_complete(job);
+        pthread_cond_broadcast(&done_cond);
+    }
+    QUEUE_UNLOCK();
+    return 0;
+}
+#endif
+
+// Gönder, (eşzamanlı modda) yürüt ve tamamlananların callback'lerini çağır.
+// block != 0 ise uçuşta komut varken en az biri tamamlanana kadar bekler.
+static int queue_poll(int block) {
+    disk_async_request_t* done;
+    int count = 0;
+
+    QUEUE_LOCK();
+    queue_setup();
+    queue_dispatch();
+
+    if (worker_count == 0) {
+        disk_queue_job_t* job;
+        while ((job = run_head) != 0) {
+            run_head = job->next;
+            if (!run_head) run_tail = 0;
+            QUEUE_UNLOCK();
+            job_execute(job);
+            QUEUE_LOCK();
+            job_complete(job);
+        }
+    }
+#if DISK_QUEUE_THREADS
+    while (block && !done_head && running > 0) {
+        pthread_cond_wait(&done_cond, &queue_lock);
+    }
+#else
+    (void) block;
+#endif
+
+    done = done_head;
+    done_head = done_tail = 0;
+    QUEUE_UNLOCK();
+
+    // Callback'ler kilit dışında çağrılır; içlerinden yeni istek gönderilebilir
+    while (done) {
+        disk_async_request_t* req = done;
+        done = req->next;
+        req->next = 0;
+
+        outstanding--;
+        stats.completed++;
+        if (req->result != 0) errors++;
+        count++;
+
+        req->status = req->result;
+        if (req->callback) req->callback(req);
+    }
+    return count;
+}
+
+/* ================ GENEL FONKSİYONLAR ================ */
+
+int disk_queue_init(uint32_t workers_wanted) {
+    if (outstanding > 0) return -1;
+    disk_queue_shutdown();
+
+    QUEUE_LOCK();
+    queue_setup();
+    QUEUE_UNLOCK();
+
+#if DISK_QUEUE_THREADS
+    if (workers_wanted > DISK_QUEUE_MAX_WORKERS) workers_wanted = DISK_QUEUE_MAX_WORKERS;
+    for (uint32_t i = 0; i < workers_wanted; i++) {
+        if (pthread_create(&workers[i], 0, worker_main, 0) != 0) break;
+        worker_count++;
+    }
+    if (worker_count < workers_wanted) return -1;
+#else
+    if (workers_wanted > 0) return -1;
+#endif
+    return 0;
+}
+
+void disk_queue_shutdown(void) {
+    disk_queue_drain();
+
+#if DISK_QUEUE_THREADS
+    QUEUE_LOCK();
+    stopping = 1;
+    pthread_cond_broadcast(&work_cond);
+    QUEUE_UNLOCK();
+
+    for (uint32_t i = 0; i < worker_count; i++) {
+        pthread_join(workers[i], 0);
+    }
+
+    QUEUE_LOCK();
+    worker_count = 0;
+    stopping = 0;
+    QUEUE_UNLOCK();
+#endif
+}
+
+int disk_queue_submit(disk_async_request_t* req) {
+    QUEUE_LOCK();
+    queue_setup();
+    if (outstanding >= DISK_QUEUE_DEPTH) {
+        stats.rejected++;
+        QUEUE_UNLOCK();
+        return -1;
+    }
+
+    req->status = DISK_REQ_PENDING;
+    req->result = 0;
+    req->next = 0;
+    pending[pending_count++] = req;
+    outstanding++;
+    stats.submitted++;
+    QUEUE_UNLOCK();
+    return 0;
+}
+
+int disk_queue_poll(void) {
+    return queue_poll(0);
+}
+
+int disk_queue_wait(disk_async_request_t* req) {
+    while (req->status == DISK_REQ_PENDING) {
+        if (outstanding == 0) return -1;   // Kuyrukta olmayan istek
+        queue_poll(1);
+    }
+    return req->status;
+}
+
+int disk_queue_drain(void) {
+    uint64_t before = errors;
+    while (outstanding > 0) {
+        queue_poll(1);
+    }
+    return errors == before ? 0 : -1;
+}
+
+uint32_t disk_queue_pending(void) {
+    return outstanding;
+}
+
+void disk_queue_get_stats(disk_queue_stats_t* out) {
+    QUEUE_LOCK();
+    *out = stats;
+    QUEUE_UNLOCK();
+}
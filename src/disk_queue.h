@@ -0,0 +1,77 @@
+#ifndef DISK_QUEUE_H
+#define DISK_QUEUE_H
+
+#include <stdint.h>
+#include "disk_io.h"
+
+// Asenkron disk istek kuyruğu: submit / poll / complete.
+//
+// Gönderilen istekler bir sonraki disk_queue_poll çağrısına kadar bekletilir
+// (plug); böylece art arda gönderilenler birleştirilebilir. Poll bekleyenleri
+// asansör (C-SCAN) sırasına dizer, aynı yönde bitişik olanları tek komutta
+// birleştirir ve aygıta gönderir. Host derlemesinde komutlar bir iş parçacığı
+// havuzunda yürütülür, birden fazla komut aynı anda uçuşta olabilir;
+// bootloader'da (veya havuz başlatılmadıysa) poll içinde eşzamanlı yürütülür.
+//
+// Tamamlanma callback'leri RT_DMATransfer'daki gibi void (*)(void*) biçimindedir,
+// isteğin kendi adresiyle ve her zaman disk_queue_poll/wait çağıran iş
+// parçacığında çağrılır; bu yüzden callback içinde önbellek gibi thread-safe
+// olmayan yapılara dokunulabilir. Aynı sektöre bekleyen okuma ve yazmanın
+// sırası garanti edilmez; bağımlı istekler arasında disk_queue_wait kullanılmalı.
+// Kuyruk (bcache gibi) tek bir iş parçacığından kullanılmalıdır; yalnızca
+// havuzdaki worker'lar eşzamanlı çalışır.
+
+#define DISK_QUEUE_DEPTH       256  // Tamamlanmamış en fazla istek
+#define DISK_QUEUE_JOBS        32   // Aynı anda uçuşta olabilecek en fazla komut
+#define DISK_QUEUE_MAX_WORKERS 8
+
+#define DISK_REQ_PENDING 1          // status: henüz tamamlanmadı
+
+typedef struct disk_async_request {
+    uint32_t lba;                   // Başlangıç sektörü
+    uint8_t* buffer;                // Bellek adresi
+    uint32_t sectors;               // Sektör sayısı
+    uint8_t  direction;             // 0: okuma, 1: yazma
+    int      status;                // DISK_REQ_PENDING, 0: başarılı, -1: hata
+    void (*callback)(void*);        // Tamamlandığında isteğin adresiyle çağrılır
+    void*    context;               // Çağıranın verisi
+    // Kuyruğa ait alanlar
+    struct disk_async_request* next;
+    int      result;
+} disk_async_request_t;
+
+typedef struct {
+    uint64_t submitted;             // Gönderilen istek
+    uint64_t completed;             // Callback'i çağrılan istek
+    uint64_t commands;              // Aygıta gönderilen birleştirilmiş komut
+    uint64_t merged;                // Başka istekle birleştirilen istek
+    uint64_t rejected;              // Kuyruk dolu olduğu için reddedilen istek
+    uint32_t max_in_flight;         // Aynı anda uçuşta görülen en fazla komut
+} disk_queue_stats_t;
+
+// İş parçacığı havuzunu başlat (workers = 0: eşzamanlı mod). Bekleyen
+// istek varsa -1 döner.
+int disk_queue_init(uint32_t workers);
+
+// Bekleyen istekleri tamamlar ve iş parçacıklarını durdurur
+void disk_queue_shutdown(void);
+
+// İsteği kuyruğa ekle; kuyruk doluysa -1 döner (istek gönderilmemiş sayılır)
+int disk_queue_submit(disk_async_request_t* req);
+
+// Bekleyenleri aygıta gönder, tamamlananların callback'lerini çağır.
+// Tamamlanan istek sayısını döndürür; beklemez.
+int disk_queue_poll(void);
+
+// İstek tamamlanana (callback'i çağrılana) kadar bekle; isteğin durumunu döner
+int disk_queue_wait(disk_async_request_t* req);
+
+// Kuyruktaki tüm istekler tamamlanana kadar bekle; hata olduysa -1 döner
+int disk_queue_drain(void);
+
+// Tamamlanmamış istek sayısı
+uint32_t disk_queue_pending(void);
+
+void disk_queue_get_stats(disk_queue_stats_t* stats);
+
+#endif
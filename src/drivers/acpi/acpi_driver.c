@@ -9,6 +9,7 @@
 #include "common/io_port.h"
 #include "common/rt_types.h"
 #include <string.h>
+#include "../../boot_profile.h"
 
 /* ================ LOCAL DEĞİŞKENLER ================ */
 
@@ -72,6 +73,7 @@ RT_ErrorCode ACPI_Init(RT_ACPIDriver* driver) {
     if (!driver) {
         return RT_ERROR_INVALID_PARAMETER;
     }
+    BOOT_KERNEL_PHASE_BEGIN(started);
 
     // RSDP bul
     if (!ACPI_FindRSDP()) {
@@ -90,6 +92,7 @@ RT_ErrorCode ACPI_Init(RT_ACPIDriver* driver) {
     }
 
     driver->base.state = DRIVER_STATE_READY;
+    BOOT_KERNEL_PHASE_END("acpi_init", started);
     return RT_SUCCESS;
 }
 
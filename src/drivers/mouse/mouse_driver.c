@@ -8,6 +8,7 @@
 #include "mouse_driver.h"
 #include "common/io_port.h"
 #include "common/rt_types.h"
+#include "../../boot_profile.h"
 
 /* ================ LOCAL DEĞİŞKENLER ================ */
 
@@ -66,6 +67,7 @@ RT_ErrorCode Mouse_Init(RT_MouseDriver* driver) {
     if (!driver) {
         return RT_ERROR_INVALID_PARAMETER;
     }
+    BOOT_KERNEL_PHASE_BEGIN(started);
 
     // Komut göndermeden önce fareyi devre dışı bırak
     IO_Out8(MOUSE_COMMAND_REGISTER, 0xA7);
@@ -104,6 +106,7 @@ RT_ErrorCode Mouse_Init(RT_MouseDriver* driver) {
     driver->packet_index = 0;
 
     driver->base.state = DRIVER_STATE_READY;
+    BOOT_KERNEL_PHASE_END("mouse_init", started);
     return RT_SUCCESS;
 }
 
@@ -9,6 +9,7 @@
 #include "common/io_port.h"
 #include "common/rt_types.h"
 #include <string.h>
+#include "../../boot_profile.h"
 
 /* ================ LOCAL DEĞİŞKENLER ================ */
 
@@ -61,8 +62,10 @@ RT_ErrorCode Network_Init(RT_NetworkDriver* driver) {
     if (!driver) {
         return RT_ERROR_INVALID_PARAMETER;
     }
+    BOOT_KERNEL_PHASE_BEGIN(started);
 
     driver->base.state = DRIVER_STATE_READY;
+    BOOT_KERNEL_PHASE_END("network_init", started);
     return RT_SUCCESS;
 }
 
@@ -9,6 +9,7 @@
 #include "common/io_port.h"
 #include "common/rt_types.h"
 #include <string.h>
+#include "../../boot_profile.h"
 
 /* ================ LOCAL DEĞİŞKENLER ================ */
 
@@ -56,6 +57,7 @@ RT_ErrorCode USB_Init(RT_USBDriver* driver) {
     if (!driver) {
         return RT_ERROR_INVALID_PARAMETER;
     }
+    BOOT_KERNEL_PHASE_BEGIN(started);
 
     // USB portunu resetle
     RT_ErrorCode err = USB_ResetPort(driver);
@@ -64,6 +66,7 @@ RT_ErrorCode USB_Init(RT_USBDriver* driver) {
     }
 
     driver->base.state = DRIVER_STATE_READY;
+    BOOT_KERNEL_PHASE_END("usb_init", started);
     return RT_SUCCESS;
 }
 
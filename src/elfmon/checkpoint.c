@@ -0,0 +1,159 @@
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "checkpoint.h"
+
+#define CHECKPOINT_MAGIC   0x504B4345   // "ECKP"
+#define CHECKPOINT_VERSION 1
+
+// Başlıktan sonra NUL ile biten kök ve count adet dizin yolu gelir
+// (yollar yeni satır içerebilir)
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t generation;
+    uint32_t count;
+} checkpoint_header_t;
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static char **pending = NULL;
+static size_t count = 0, capacity = 0;
+
+void checkpoint_add(const char *path) {
+    char *copy = strdup(path);
+    if (!copy) return;
+
+    pthread_mutex_lock(&lock);
+    if (count == capacity) {
+        size_t size = capacity ? capacity * 2 : 256;
+        char **items = realloc(pending, size * sizeof(char *));
+        if (!items) {
+            pthread_mutex_unlock(&lock);
+            free(copy);
+            return;
+        }
+        pending = items;
+        capacity = size;
+    }
+    pending[count++] = copy;
+    pthread_mutex_unlock(&lock);
+}
+
+size_t checkpoint_pending(void) {
+    pthread_mutex_lock(&lock);
+    size_t n = count;
+    pthread_mutex_unlock(&lock);
+    return n;
+}
+
+void checkpoint_reset(void) {
+    pthread_mutex_lock(&lock);
+    for (size_t i = 0; i < count; i++) free(pending[i]);
+    free(pending);
+    pending = NULL;
+    count = capacity = 0;
+    pthread_mutex_unlock(&lock);
+}
+
+// Sahte bir kontrol noktası devam eden taramayı başka yöne çevirebilir:
+// dosya umask'tan bağımsız olarak yalnızca sahibine açık oluşturulur
+static FILE *create_private(const char *path) {
+    unlink(path);
+    int fd = open(path, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if (fd < 0) return NULL;
+    FILE *file = fdopen(fd, "w");
+    if (!file) close(fd);
+    return file;
+}
+
+int checkpoint_save(const char *file, const char *root, uint32_t generation) {
+    char tmp[PATH_MAX];
+
+    pthread_mutex_lock(&lock);
+    if (!count) {
+        pthread_mutex_unlock(&lock);
+        unlink(file);
+        return 0;
+    }
+    checkpoint_header_t header = { CHECKPOINT_MAGIC, CHECKPOINT_VERSION, generation, (uint32_t) count };
+    if (snprintf(tmp, sizeof(tmp), "%s.tmp", file) >= (int) sizeof(tmp)) {
+        pthread_mutex_unlock(&lock);
+        return -1;
+    }
+    FILE *out = create_private(tmp);
+    if (!out) {
+        pthread_mutex_unlock(&lock);
+        return -1;
+    }
+
+    int ok = fwrite(&header, sizeof(header), 1, out) == 1 &&
+             fwrite(root, strlen(root) + 1, 1, out) == 1;
+    for (size_t i = 0; ok && i < count; i++) ok = fwrite(pending[i], strlen(pending[i]) + 1, 1, out) == 1;
+    pthread_mutex_unlock(&lock);
+    if (fclose(out) != 0) ok = 0;
+
+    // Yarım yazılmış dosya eskisinin yerini almaz
+    if (!ok || rename(tmp, file) != 0) {
+        unlink(tmp);
+        return -1;
+    }
+    return 0;
+}
+
+// NUL'a kadar bir yol oku; yol çok uzunsa ya da dosya bittiyse -1
+static int read_path(FILE *in, char *buffer, size_t size) {
+    size_t length = 0;
+    int c;
+
+    while ((c = getc(in)) != EOF) {
+        if (length + 1 >= size) return -1;
+        buffer[length++] = (char) c;
+        if (c == '\0') return 0;
+    }
+    return -1;
+}
+
+int checkpoint_load(const char *file, const char *root, uint32_t generation, char ***dirs) {
+    checkpoint_header_t header;
+    char path[PATH_MAX];
+
+    FILE *in = fopen(file, "r");
+    if (!in) return -1;
+    if (fread(&header, sizeof(header), 1, in) != 1 || header.magic != CHECKPOINT_MAGIC ||
+        header.version != CHECKPOINT_VERSION || header.generation != generation ||
+        read_path(in, path, sizeof(path)) != 0 || strcmp(path, root) != 0) {
+        fclose(in);
+        return -1;
+    }
+
+    char **list = calloc(header.count ? header.count : 1, sizeof(char *));
+    int n = 0;
+    if (!list) {
+        fclose(in);
+        return -1;
+    }
+    while (n < (int) header.count && read_path(in, path, sizeof(path)) == 0) {
+        list[n] = strdup(path);
+        if (!list[n]) break;
+        n++;
+    }
+    fclose(in);
+
+    // Eksik okunan kontrol noktası güvenilmez; tam tarama yapılır
+    if (n != (int) header.count) {
+        checkpoint_free(list, n);
+        return -1;
+    }
+    *dirs = list;
+    return n;
+}
+
+void checkpoint_free(char **dirs, int n) {
+    for (int i = 0; i < n; i++) free(dirs[i]);
+    free(dirs);
+}
@@ -0,0 +1,32 @@
+#ifndef ELFMON_CHECKPOINT_H
+#define ELFMON_CHECKPOINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Yarıda kesilen tam taramanın kontrol noktası. Gezgin kesildiğinde
+// okunmadan kalan ya da yarıda bırakılan dizinler checkpoint_add ile
+// toplanır ve kapanışta durum önbelleğinin nesliyle birlikte diske
+// yazılır. Sonraki çalışma önbellek aynı nesilden yüklendiyse taramayı
+// kökten değil bu dizinlerden sürdürür; nesil ya da kök tutmazsa dosya
+// yok sayılır ve tam tarama baştan yapılır.
+
+// Toplanan dizin (tam yol); birden fazla iş parçacığından çağrılabilir
+void checkpoint_add(const char *path);
+
+size_t checkpoint_pending(void);
+
+// Toplananları bırak
+void checkpoint_reset(void);
+
+// Toplananları dosyaya yaz (0 başarı, -1 hata; yazılacak dizin yoksa
+// dosya silinir)
+int checkpoint_save(const char *file, const char *root, uint32_t generation);
+
+// Dosyadaki dizinleri oku. Kök ve nesil eşleşirse dizin sayısı döner ve
+// *dirs checkpoint_free ile bırakılmalıdır; dosya yok, bozuk ya da
+// eşleşmiyorsa -1.
+int checkpoint_load(const char *file, const char *root, uint32_t generation, char ***dirs);
+void checkpoint_free(char **dirs, int count);
+
+#endif
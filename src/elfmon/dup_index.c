@@ -0,0 +1,206 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "dup_index.h"
+
+#define SHARDS         64           // Bağımsız kilitli alt tablo
+#define INITIAL_SLOTS  64           // Parça başına ilk yuva (2'nin kuvveti)
+
+typedef struct {
+    uint64_t hash;
+    uint64_t dev;
+    uint64_t ino;
+    char *path;                     // NULL: boş yuva
+} dup_entry_t;
+
+typedef struct {
+    pthread_mutex_t lock;
+    dup_entry_t *slots;
+    uint32_t capacity;
+    uint32_t count;
+} shard_t;
+
+static shard_t shards[SHARDS];
+
+// XXH3 zaten iyi dağılır: üst bitler parçayı, alt bitler yuvayı seçer
+static inline shard_t *shard_of(uint64_t hash) {
+    return &shards[(hash >> 58) % SHARDS];
+}
+
+static dup_entry_t *find_slot(dup_entry_t *table, uint32_t size, uint64_t hash) {
+    uint32_t mask = size - 1;
+    uint32_t i = (uint32_t) hash & mask;
+
+    while (table[i].path && table[i].hash != hash) i = (i + 1) & mask;
+    return &table[i];
+}
+
+// Kayıtlı sahip hâlâ yolunda mı? Tohumlanan (yolsuz) kayıt denetlenemez
+static int owner_present(const dup_entry_t *e) {
+    struct stat st;
+    if (!*e->path) return 1;
+    return lstat(e->path, &st) == 0 && (uint64_t) st.st_dev == e->dev && (uint64_t) st.st_ino == e->ino;
+}
+
+// Kilit çağıranda
+static int grow(shard_t *shard) {
+    uint32_t size = shard->capacity * 2;
+    dup_entry_t *table = calloc(size, sizeof(dup_entry_t));
+    if (!table) return -1;
+
+    for (uint32_t i = 0; i < shard->capacity; i++) {
+        if (shard->slots[i].path) *find_slot(table, size, shard->slots[i].hash) = shard->slots[i];
+    }
+    free(shard->slots);
+    shard->slots = table;
+    shard->capacity = size;
+    return 0;
+}
+
+int dup_index_init(void) {
+    dup_index_free();
+    for (int i = 0; i < SHARDS; i++) {
+        shards[i].slots = calloc(INITIAL_SLOTS, sizeof(dup_entry_t));
+        if (!shards[i].slots) {
+            dup_index_free();
+            return -1;
+        }
+        shards[i].capacity = INITIAL_SLOTS;
+        pthread_mutex_init(&shards[i].lock, NULL);
+    }
+    return 0;
+}
+
+void dup_index_free(void) {
+    for (int i = 0; i < SHARDS; i++) {
+        if (!shards[i].capacity) continue;
+        for (uint32_t k = 0; k < shards[i].capacity; k++) free(shards[i].slots[k].path);
+        pthread_mutex_destroy(&shards[i].lock);
+        free(shards[i].slots);
+        shards[i].slots = NULL;
+        shards[i].capacity = shards[i].count = 0;
+    }
+}
+
+void dup_index_clear(void) {
+    for (int i = 0; i < SHARDS; i++) {
+        shard_t *shard = &shards[i];
+        pthread_mutex_lock(&shard->lock);
+        for (uint32_t k = 0; k < shard->capacity; k++) {
+            free(shard->slots[k].path);
+            shard->slots[k].path = NULL;
+        }
+        shard->count = 0;
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+int dup_index_claim(uint64_t hash, const struct stat *st, const char *path,
+                    char *first, size_t size) {
+    shard_t *shard = shard_of(hash);
+    int state = DUP_FIRST;
+
+    pthread_mutex_lock(&shard->lock);
+    dup_entry_t *e = find_slot(shard->slots, shard->capacity, hash);
+    if (e->path) {
+        if ((e->dev == (uint64_t) st->st_dev && e->ino == (uint64_t) st->st_ino) ||
+            strcmp(e->path, path) == 0) {
+            // Aynı yol yeni inode ile (ör. paket yöneticisinin rename'i)
+            e->dev = st->st_dev;
+            e->ino = st->st_ino;
+            // Tohumlanan kaydın yolu artık biliniyor
+            char *copy = *e->path ? NULL : strdup(path);
+            if (copy) {
+                free(e->path);
+                e->path = copy;
+            }
+            state = DUP_KNOWN;
+        } else if (!owner_present(e)) {
+            // Sahip silinmiş ya da yerine başka dosya gelmiş: yeni sahip bu
+            // dosyadır. Bellek yoksa eski yol kalır, bir kez yanlış kopya
+            // bildirilmesi sahipsiz kalmasından iyidir.
+            char *copy = strdup(path);
+            if (copy) {
+                free(e->path);
+                e->path = copy;
+            }
+            e->dev = st->st_dev;
+            e->ino = st->st_ino;
+        } else {
+            if (first && size) snprintf(first, size, "%s", *e->path ? e->path : DUP_UNKNOWN_PATH);
+            state = DUP_COPY;
+        }
+    } else if ((shard->count + 1) * 2 <= shard->capacity || grow(shard) == 0) {
+        // Büyütme yuvaları taşır; boş yuva yeniden aranır. Bellek yoksa
+        // kayıt atlanır, dosya yalnızca kopya olarak tanınmaz.
+        char *copy = strdup(path);
+        if (copy) {
+            e = find_slot(shard->slots, shard->capacity, hash);
+            e->hash = hash;
+            e->dev = st->st_dev;
+            e->ino = st->st_ino;
+            e->path = copy;
+            shard->count++;
+        }
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return state;
+}
+
+void dup_index_seed(uint64_t hash, uint64_t dev, uint64_t ino) {
+    shard_t *shard = shard_of(hash);
+
+    pthread_mutex_lock(&shard->lock);
+    dup_entry_t *e = find_slot(shard->slots, shard->capacity, hash);
+    if (!e->path && ((shard->count + 1) * 2 <= shard->capacity || grow(shard) == 0)) {
+        // Boş yol "bilinmiyor" demektir; yuvanın dolu olduğunu path gösterir
+        char *copy = strdup("");
+        if (copy) {
+            e = find_slot(shard->slots, shard->capacity, hash);
+            e->hash = hash;
+            e->dev = dev;
+            e->ino = ino;
+            e->path = copy;
+            shard->count++;
+        }
+    }
+    pthread_mutex_unlock(&shard->lock);
+}
+
+void dup_index_release(uint64_t hash, const struct stat *st, const char *path) {
+    shard_t *shard = shard_of(hash);
+
+    pthread_mutex_lock(&shard->lock);
+    dup_entry_t *e = find_slot(shard->slots, shard->capacity, hash);
+    if (e->path && ((e->dev == (uint64_t) st->st_dev && e->ino == (uint64_t) st->st_ino) ||
+                    strcmp(e->path, path) == 0)) {
+        free(e->path);
+        e->path = NULL;
+        shard->count--;
+
+        // Doğrusal yoklama zinciri kopmasın: boşluktan sonraki girdiler
+        // ilk boş yuvaya kadar yeniden yerleştirilir
+        uint32_t mask = shard->capacity - 1;
+        for (uint32_t i = ((uint32_t) (e - shard->slots) + 1) & mask; shard->slots[i].path;
+             i = (i + 1) & mask) {
+            dup_entry_t moved = shard->slots[i];
+            shard->slots[i].path = NULL;
+            *find_slot(shard->slots, shard->capacity, moved.hash) = moved;
+        }
+    }
+    pthread_mutex_unlock(&shard->lock);
+}
+
+uint32_t dup_index_count(void) {
+    uint32_t total = 0;
+
+    for (int i = 0; i < SHARDS; i++) {
+        pthread_mutex_lock(&shards[i].lock);
+        total += shards[i].count;
+        pthread_mutex_unlock(&shards[i].lock);
+    }
+    return total;
+}
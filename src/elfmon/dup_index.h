@@ -0,0 +1,50 @@
+#ifndef ELFMON_DUP_INDEX_H
+#define ELFMON_DUP_INDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/stat.h>
+
+// İçerik özeti (XXH3) -> o içeriğe sahip ilk dosya. Aynı içerik başka bir
+// inode'da yeniden görülünce kopya olarak tek satırla raporlanır; aynı
+// inode'un ikinci adı (hardlink) ya da aynı yola yeniden kurulan aynı
+// içerik hiç raporlanmaz.
+//
+// Dizin yalnızca bellektedir: her tam taramanın başında temizlenir ve
+// değişmemiş dosyaların önbellekteki özetleriyle yeniden dolar (dosyalar
+// yeniden okunmaz). Sürdürülen taramada kesintiden önce incelenen
+// dosyalar gezilmez; onlar durum önbelleğinden yolsuz olarak tohumlanır.
+// İçeriği değişen dosyanın eski özeti release ile bırakılır. claim ve
+// release birden fazla iş parçacığından çağrılabilir.
+
+// dup_index_claim sonucu
+#define DUP_FIRST 0     // Bu içerik ilk kez görüldü, dosya kaydedildi
+#define DUP_KNOWN 1     // Aynı inode ya da aynı yol zaten kayıtlı
+#define DUP_COPY  2     // Farklı dosyada aynı içerik; first'e ilk yol yazılır
+
+int dup_index_init(void);
+void dup_index_free(void);
+
+// Tüm kayıtları at (tam tarama başında)
+void dup_index_clear(void);
+
+// Özeti yolu bilinmeyen bir dosyayla kaydet (yoksa). Bu içeriğin
+// kopyasında first'e DUP_UNKNOWN_PATH yazılır; dosyanın kendisi yeniden
+// görülünce yolu öğrenilir.
+#define DUP_UNKNOWN_PATH "(kesilen taramada incelenen dosya)"
+void dup_index_seed(uint64_t hash, uint64_t dev, uint64_t ino);
+
+// Özeti ara, yoksa dosyayı bu içeriğin sahibi olarak kaydet. Silinen
+// dosyalar için olay gelmez; kayıtlı sahip kopya bulunduğunda lstat ile
+// denetlenir, yolu yoksa ya da başka bir inode'a aitse dosya sahipliği
+// devralır (DUP_FIRST). Tohumlanan kaydın yolu bilinmediğinden sahibi
+// silinmiş olsa da bir sonraki tam taramaya kadar kopya bildirilir.
+int dup_index_claim(uint64_t hash, const struct stat *st, const char *path,
+                    char *first, size_t size);
+
+// Özetin kaydı bu dosyaya (aynı inode ya da aynı yol) aitse kaldır
+void dup_index_release(uint64_t hash, const struct stat *st, const char *path);
+
+uint32_t dup_index_count(void);
+
+#endif
@@ -0,0 +1,334 @@
+#define _GNU_SOURCE
+#include <elf.h>
+#include <string.h>
+#include "elf_parse.h"
+
+#define NOTE_BUILD_ID_NAME "GNU"
+
+/* ================ SINIR DENETİMLİ OKUMA ================ */
+
+// [offset, offset + length) dosyanın içinde mi?
+static inline int in_bounds(const elf_info_t *e, uint64_t offset, uint64_t length) {
+    return offset <= e->size && length <= e->size - offset;
+}
+
+// Çağıran sınırı denetlemiş olmalı; hizasız ve ters sıralı okumaya uygun
+static uint16_t rd16(const elf_info_t *e, uint64_t offset) {
+    uint16_t v;
+    memcpy(&v, e->base + offset, sizeof(v));
+    return e->msb ? __builtin_bswap16(v) : v;
+}
+
+static uint32_t rd32(const elf_info_t *e, uint64_t offset) {
+    uint32_t v;
+    memcpy(&v, e->base + offset, sizeof(v));
+    return e->msb ? __builtin_bswap32(v) : v;
+}
+
+static uint64_t rd64(const elf_info_t *e, uint64_t offset) {
+    uint64_t v;
+    memcpy(&v, e->base + offset, sizeof(v));
+    return e->msb ? __builtin_bswap64(v) : v;
+}
+
+// Adres boyutlu alan (ELF32'de 4, ELF64'te 8 byte)
+static uint64_t rd_word(const elf_info_t *e, uint64_t offset) {
+    return e->elf_class == ELFCLASS64 ? rd64(e, offset) : rd32(e, offset);
+}
+
+// Tablodaki NUL ile biten dizgi; sonlandırıcısı tablo içinde değilse NULL
+static const char *string_at(const elf_info_t *e, uint64_t table, uint64_t table_size,
+                             uint64_t index, size_t *length) {
+    if (index >= table_size || !in_bounds(e, table, table_size)) return NULL;
+    const char *start = (const char *) e->base + table + index;
+    const char *end = memchr(start, '\0', table_size - index);
+    if (!end) return NULL;
+    *length = (size_t) (end - start);
+    return start;
+}
+
+/* ================ PROGRAM BAŞLIKLARI ================ */
+
+typedef struct {
+    uint32_t type, flags;
+    uint64_t offset, vaddr, filesz, memsz, align;
+} phdr_t;
+
+static void read_phdr(const elf_info_t *e, uint64_t at, phdr_t *p) {
+    p->type = rd32(e, at);
+    if (e->elf_class == ELFCLASS64) {
+        p->flags  = rd32(e, at + 4);
+        p->offset = rd64(e, at + 8);
+        p->vaddr  = rd64(e, at + 16);
+        p->filesz = rd64(e, at + 32);
+        p->memsz  = rd64(e, at + 40);
+        p->align  = rd64(e, at + 48);
+    } else {
+        p->offset = rd32(e, at + 4);
+        p->vaddr  = rd32(e, at + 8);
+        p->filesz = rd32(e, at + 16);
+        p->memsz  = rd32(e, at + 20);
+        p->flags  = rd32(e, at + 24);
+        p->align  = rd32(e, at + 28);
+    }
+}
+
+// Not bölgesinde NT_GNU_BUILD_ID ara
+static void scan_notes(elf_info_t *e, uint64_t offset, uint64_t size, uint64_t align) {
+    uint64_t end;
+
+    if (!in_bounds(e, offset, size)) return;
+    end = offset + size;
+    align = align == 8 ? 8 : 4;
+
+    while (e->build_id == NULL && end - offset >= 12) {
+        uint32_t namesz = rd32(e, offset);
+        uint32_t descsz = rd32(e, offset + 4);
+        uint32_t type = rd32(e, offset + 8);
+        uint64_t name = offset + 12;
+        uint64_t desc = name + ((namesz + align - 1) & ~(align - 1));
+        uint64_t next = desc + ((descsz + align - 1) & ~(align - 1));
+
+        if (desc > end || next > end || desc + descsz > end) return;
+        if (type == NT_GNU_BUILD_ID && namesz == sizeof(NOTE_BUILD_ID_NAME) &&
+            memcmp(e->base + name, NOTE_BUILD_ID_NAME, sizeof(NOTE_BUILD_ID_NAME)) == 0) {
+            e->build_id = e->base + desc;
+            e->build_id_length = descsz;
+        }
+        offset = next;
+    }
+}
+
+// Sanal adresi dosya konumuna çevir (DT_STRTAB bir adrestir)
+static int vaddr_to_offset(const elf_info_t *e, uint64_t phoff, uint32_t phentsize,
+                           uint64_t vaddr, uint64_t *offset) {
+    phdr_t p;
+
+    for (uint32_t i = 0; i < e->phnum; i++) {
+        read_phdr(e, phoff + (uint64_t) i * phentsize, &p);
+        if (p.type != PT_LOAD) continue;
+        if (vaddr >= p.vaddr && vaddr - p.vaddr < p.filesz) {
+            *offset = p.offset + (vaddr - p.vaddr);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static void parse_dynamic(elf_info_t *e, uint64_t phoff, uint32_t phentsize) {
+    uint64_t entsize = e->elf_class == ELFCLASS64 ? 16 : 8;
+    uint64_t strtab = 0, strsz = 0;
+
+    if (!in_bounds(e, e->dynamic_offset, e->dynamic_size)) {
+        e->dynamic_size = 0;
+        return;
+    }
+    for (uint64_t at = e->dynamic_offset; at + entsize <= e->dynamic_offset + e->dynamic_size;
+         at += entsize) {
+        uint64_t tag = rd_word(e, at);
+        uint64_t value = rd_word(e, at + entsize / 2);
+        if (tag == DT_NULL) break;
+        if (tag == DT_STRTAB) strtab = value;
+        if (tag == DT_STRSZ) strsz = value;
+    }
+    if (strtab && strsz && vaddr_to_offset(e, phoff, phentsize, strtab, &e->dynstr_offset) == 0 &&
+        in_bounds(e, e->dynstr_offset, strsz)) {
+        e->dynstr_size = strsz;
+    }
+}
+
+static void parse_program_headers(elf_info_t *e, uint64_t phoff, uint32_t phentsize) {
+    uint32_t min_entsize = e->elf_class == ELFCLASS64 ? 56 : 32;
+    phdr_t p;
+
+    if (e->phnum == 0 || phentsize < min_entsize ||
+        !in_bounds(e, phoff, (uint64_t) e->phnum * phentsize)) {
+        e->phnum = 0;
+        return;
+    }
+
+    for (uint32_t i = 0; i < e->phnum; i++) {
+        read_phdr(e, phoff + (uint64_t) i * phentsize, &p);
+        switch (p.type) {
+        case PT_LOAD:
+            if (e->load_count < ELF_PARSE_MAX_LOADS) {
+                elf_load_t *load = &e->loads[e->load_count];
+                load->offset = p.offset;
+                load->vaddr = p.vaddr;
+                load->filesz = p.filesz;
+                load->memsz = p.memsz;
+                load->flags = p.flags;
+            }
+            e->load_count++;
+            break;
+        case PT_INTERP:
+            // Sonlandırıcı dahil dosyada olmalı
+            if (p.filesz > 1 && in_bounds(e, p.offset, p.filesz) &&
+                e->base[p.offset + p.filesz - 1] == '\0') {
+                e->interp = (const char *) e->base + p.offset;
+                e->interp_length = strnlen(e->interp, p.filesz - 1);
+            }
+            break;
+        case PT_DYNAMIC:
+            e->dynamic_offset = p.offset;
+            e->dynamic_size = p.filesz;
+            break;
+        case PT_NOTE:
+            scan_notes(e, p.offset, p.filesz, p.align);
+            break;
+        default:
+            break;
+        }
+    }
+    if (e->dynamic_size) parse_dynamic(e, phoff, phentsize);
+}
+
+/* ================ SECTION BAŞLIKLARI ================ */
+
+static void read_section(const elf_info_t *e, uint32_t index, uint32_t *name, uint32_t *type,
+                         uint64_t *offset, uint64_t *size, uint32_t *link) {
+    uint64_t at = e->shoff + (uint64_t) index * e->shentsize;
+
+    *name = rd32(e, at);
+    *type = rd32(e, at + 4);
+    if (e->elf_class == ELFCLASS64) {
+        *offset = rd64(e, at + 24);
+        *size = rd64(e, at + 32);
+        *link = rd32(e, at + 40);
+    } else {
+        *offset = rd32(e, at + 16);
+        *size = rd32(e, at + 20);
+        *link = rd32(e, at + 24);
+    }
+}
+
+static void parse_section_headers(elf_info_t *e, uint32_t shstrndx) {
+    uint32_t min_entsize = e->elf_class == ELFCLASS64 ? 64 : 40;
+    uint32_t name, type, link;
+    uint64_t offset, size;
+
+    if (e->shoff == 0 || e->shentsize < min_entsize || !in_bounds(e, e->shoff, e->shentsize)) {
+        e->shnum = 0;
+        return;
+    }
+
+    // 0xFF00'den fazla section varsa sayı ve .shstrtab indeksi 0. başlıkta
+    read_section(e, 0, &name, &type, &offset, &size, &link);
+    if (e->shnum == 0) e->shnum = (uint32_t) size;
+    if (shstrndx == SHN_XINDEX) shstrndx = link;
+    if (!in_bounds(e, e->shoff, (uint64_t) e->shnum * e->shentsize)) {
+        e->shnum = 0;
+        return;
+    }
+
+    if (shstrndx != SHN_UNDEF && shstrndx < e->shnum) {
+        read_section(e, shstrndx, &name, &type, &offset, &size, &link);
+        if (type == SHT_STRTAB && in_bounds(e, offset, size)) {
+            e->shstrtab_offset = offset;
+            e->shstrtab_size = size;
+        }
+    }
+
+    // PT_NOTE'suz (ör. yalnızca bağlanabilir) dosyalarda build-id section'da
+    for (uint32_t i = 1; i < e->shnum && e->build_id == NULL; i++) {
+        read_section(e, i, &name, &type, &offset, &size, &link);
+        if (type == SHT_NOTE) scan_notes(e, offset, size, 4);
+    }
+}
+
+/* ================ ARAYÜZ ================ */
+
+int elf_parse(const void *data, size_t size, elf_info_t *info) {
+    const uint8_t *ident = data;
+
+    memset(info, 0, sizeof(*info));
+    info->base = data;
+    info->size = size;
+
+    if (size < EI_NIDENT || memcmp(ident, ELFMAG, SELFMAG) != 0) return -1;
+    if (ident[EI_CLASS] != ELFCLASS32 && ident[EI_CLASS] != ELFCLASS64) return -1;
+    if (ident[EI_DATA] != ELFDATA2LSB && ident[EI_DATA] != ELFDATA2MSB) return -1;
+    info->elf_class = ident[EI_CLASS];
+    info->msb = ident[EI_DATA] == ELFDATA2MSB;
+
+    int is64 = info->elf_class == ELFCLASS64;
+    if (size < (is64 ? sizeof(Elf64_Ehdr) : sizeof(Elf32_Ehdr))) return -1;
+
+    info->type = rd16(info, 16);
+    info->machine = rd16(info, 18);
+    info->entry = rd_word(info, 24);
+    uint64_t phoff = rd_word(info, is64 ? 32 : 28);
+    info->shoff = rd_word(info, is64 ? 40 : 32);
+    uint32_t phentsize = rd16(info, is64 ? 54 : 42);
+    info->phnum = rd16(info, is64 ? 56 : 44);
+    info->shentsize = rd16(info, is64 ? 58 : 46);
+    info->shnum = rd16(info, is64 ? 60 : 48);
+    uint32_t shstrndx = rd16(info, is64 ? 62 : 50);
+
+    parse_program_headers(info, phoff, phentsize);
+    parse_section_headers(info, shstrndx);
+    return 0;
+}
+
+uint32_t elf_for_each_needed(const elf_info_t *e, elf_name_fn fn, void *ctx) {
+    uint64_t entsize = e->elf_class == ELFCLASS64 ? 16 : 8;
+    uint32_t count = 0;
+    size_t length;
+
+    if (e->dynstr_size == 0) return 0;
+    for (uint64_t at = e->dynamic_offset; at + entsize <= e->dynamic_offset + e->dynamic_size;
+         at += entsize) {
+        uint64_t tag = rd_word(e, at);
+        if (tag == DT_NULL) break;
+        if (tag != DT_NEEDED) continue;
+
+        const char *name = string_at(e, e->dynstr_offset, e->dynstr_size, rd_word(e, at + entsize / 2),
+                                     &length);
+        if (!name) continue;
+        count++;
+        if (fn(name, length, ctx) != 0) break;
+    }
+    return count;
+}
+
+uint32_t elf_for_each_section(const elf_info_t *e, elf_name_fn fn, void *ctx) {
+    uint32_t name, type, link, count = 0;
+    uint64_t offset, size;
+    size_t length;
+
+    if (e->shstrtab_size == 0) return 0;
+    for (uint32_t i = 1; i < e->shnum; i++) {
+        read_section(e, i, &name, &type, &offset, &size, &link);
+        const char *text = string_at(e, e->shstrtab_offset, e->shstrtab_size, name, &length);
+        if (!text || length == 0) continue;
+        count++;
+        if (fn(text, length, ctx) != 0) break;
+    }
+    return count;
+}
+
+const char *elf_machine_name(uint16_t machine) {
+    switch (machine) {
+    case EM_386:     return "x86";
+    case EM_X86_64:  return "x86-64";
+    case EM_ARM:     return "ARM";
+    case EM_AARCH64: return "AArch64";
+    case EM_RISCV:   return "RISC-V";
+    case EM_PPC:     return "PowerPC";
+    case EM_PPC64:   return "PowerPC64";
+    case EM_MIPS:    return "MIPS";
+    case EM_S390:    return "S390";
+    case EM_SPARCV9: return "SPARCv9";
+    default:         return NULL;
+    }
+}
+
+const char *elf_type_name(uint16_t type) {
+    switch (type) {
+    case ET_REL:  return "REL";
+    case ET_EXEC: return "EXEC";
+    case ET_DYN:  return "DYN";
+    case ET_CORE: return "CORE";
+    default:      return NULL;
+    }
+}
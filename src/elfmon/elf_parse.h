@@ -0,0 +1,70 @@
+#ifndef ELFMON_ELF_PARSE_H
+#define ELFMON_ELF_PARSE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Kopyasız ELF çözümleyici. Dosyanın tamamı (ör. mmap ile) bellekteyken
+// ELF32/ELF64 ve her iki bayt sırası için başlık, program başlıkları
+// (PT_LOAD, PT_INTERP, PT_DYNAMIC, PT_NOTE) ve section başlıkları
+// okunur. Her erişim dosya sınırına göre denetlenir; bozuk ya da kırpılmış
+// bir dosya yalnızca eksik bilgi verir, sınır dışına okunmaz. Dizgiler ve
+// build-id eşlemin içini gösterir, eşlem açık kaldıkça geçerlidir.
+
+#define ELF_PARSE_MAX_LOADS 8
+
+typedef struct {
+    uint64_t offset;
+    uint64_t vaddr;
+    uint64_t filesz;
+    uint64_t memsz;
+    uint32_t flags;                 // PF_R / PF_W / PF_X
+} elf_load_t;
+
+typedef struct {
+    const uint8_t *base;
+    size_t size;
+    int elf_class;                  // ELFCLASS32 / ELFCLASS64
+    int msb;                        // 1: büyük sonlu (ELFDATA2MSB)
+    uint16_t type;                  // ET_EXEC, ET_DYN, ...
+    uint16_t machine;
+    uint64_t entry;
+    uint16_t phnum;
+    uint32_t shnum;
+
+    uint32_t load_count;            // Tüm PT_LOAD'lar (dizi ilk 8'ini tutar)
+    elf_load_t loads[ELF_PARSE_MAX_LOADS];
+
+    const char *interp;             // PT_INTERP (NULL: statik)
+    size_t interp_length;
+
+    const uint8_t *build_id;        // NT_GNU_BUILD_ID açıklaması
+    uint32_t build_id_length;
+
+    // DT_NEEDED için dinamik bölüm ve dizgi tablosu (dosya içi)
+    uint64_t dynamic_offset, dynamic_size;
+    uint64_t dynstr_offset, dynstr_size;
+
+    // Section adları için başlık tablosu ve .shstrtab (dosya içi)
+    uint64_t shoff;
+    uint32_t shentsize;
+    uint64_t shstrtab_offset, shstrtab_size;
+} elf_info_t;
+
+// ELF değilse ya da ELF başlığı okunamıyorsa -1; aksi halde 0 ve info
+// dolar (bulunamayan alanlar sıfır/NULL kalır)
+int elf_parse(const void *data, size_t size, elf_info_t *info);
+
+// Dizgi geri çağrısı: uzunluk sonlandırıcı hariç; 0 dışı dönüş durdurur
+typedef int (*elf_name_fn)(const char *name, size_t length, void *ctx);
+
+// DT_NEEDED kayıtlarını / section adlarını sırayla ver; verilen sayıyı
+// döndürür
+uint32_t elf_for_each_needed(const elf_info_t *info, elf_name_fn fn, void *ctx);
+uint32_t elf_for_each_section(const elf_info_t *info, elf_name_fn fn, void *ctx);
+
+// Yazdırma için kısa adlar ("x86-64", "DYN", ...); bilinmiyorsa NULL
+const char *elf_machine_name(uint16_t machine);
+const char *elf_type_name(uint16_t type);
+
+#endif
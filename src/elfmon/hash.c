@@ -0,0 +1,604 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "hash.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HASH_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+/* ================ ORTAK ================ */
+
+static inline uint64_t read64(const uint8_t *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+static inline uint32_t read32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+static inline uint32_t read32_be(const uint8_t *p) {
+    return (uint32_t) p[0] << 24 | (uint32_t) p[1] << 16 | (uint32_t) p[2] << 8 | p[3];
+}
+
+static inline uint64_t rotl64(uint64_t v, int r) {
+    return (v << r) | (v >> (64 - r));
+}
+
+static inline uint32_t rotr32(uint32_t v, int r) {
+    return (v >> r) | (v << (32 - r));
+}
+
+/* ================ XXH3-64 ================ */
+
+#define PRIME32_1 0x9E3779B1U
+#define PRIME32_2 0x85EBCA77U
+#define PRIME32_3 0xC2B2AE3DU
+#define PRIME64_1 0x9E3779B185EBCA87ULL
+#define PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define PRIME64_3 0x165667B19E3779F9ULL
+#define PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define PRIME64_5 0x27D4EB2F165667C5ULL
+#define PRIME_MX1 0x165667919E3779F9ULL
+#define PRIME_MX2 0x9FB21C651E98DF25ULL
+
+#define STRIPE_LEN        64
+#define SECRET_SIZE       192
+#define SECRET_CONSUME    8
+#define STRIPES_PER_BLOCK ((SECRET_SIZE - STRIPE_LEN) / SECRET_CONSUME)
+#define SECRET_LASTACC    7
+#define SECRET_MERGEACCS  11
+#define MID_SIZE_MAX      240
+#define BUFFER_SIZE       256
+
+static const uint8_t secret[SECRET_SIZE] __attribute__((aligned(64))) = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+static inline uint64_t mul128_fold64(uint64_t a, uint64_t b) {
+    unsigned __int128 product = (unsigned __int128) a * b;
+    return (uint64_t) product ^ (uint64_t) (product >> 64);
+}
+
+static inline uint64_t xxh64_avalanche(uint64_t h) {
+    h ^= h >> 33;
+    h *= PRIME64_2;
+    h ^= h >> 29;
+    h *= PRIME64_3;
+    return h ^ (h >> 32);
+}
+
+static inline uint64_t xxh3_avalanche(uint64_t h) {
+    h ^= h >> 37;
+    h *= PRIME_MX1;
+    return h ^ (h >> 32);
+}
+
+static inline uint64_t rrmxmx(uint64_t h, uint64_t length) {
+    h ^= rotl64(h, 49) ^ rotl64(h, 24);
+    h *= PRIME_MX2;
+    h ^= (h >> 35) + length;
+    h *= PRIME_MX2;
+    return h ^ (h >> 28);
+}
+
+static inline uint64_t mix16(const uint8_t *input, const uint8_t *key) {
+    return mul128_fold64(read64(input) ^ read64(key), read64(input + 8) ^ read64(key + 8));
+}
+
+// Kısa girdiler (<= 240 byte) biriktiricisiz yollarla özetlenir
+static uint64_t hash_short(const uint8_t *input, size_t length) {
+    if (length == 0) return xxh64_avalanche(read64(secret + 56) ^ read64(secret + 64));
+
+    if (length <= 3) {
+        uint32_t combined = (uint32_t) input[0] << 16 | (uint32_t) input[length >> 1] << 24 |
+                            (uint32_t) input[length - 1] | (uint32_t) length << 8;
+        uint64_t flip = read32(secret) ^ read32(secret + 4);
+        return xxh64_avalanche(combined ^ flip);
+    }
+
+    if (length <= 8) {
+        uint64_t flip = read64(secret + 8) ^ read64(secret + 16);
+        uint64_t input64 = read32(input + length - 4) + ((uint64_t) read32(input) << 32);
+        return rrmxmx(input64 ^ flip, length);
+    }
+
+    if (length <= 16) {
+        uint64_t lo = read64(input) ^ (read64(secret + 24) ^ read64(secret + 32));
+        uint64_t hi = read64(input + length - 8) ^ (read64(secret + 40) ^ read64(secret + 48));
+        return xxh3_avalanche(length + __builtin_bswap64(lo) + hi + mul128_fold64(lo, hi));
+    }
+
+    uint64_t acc = length * PRIME64_1;
+    if (length <= 128) {
+        if (length > 32) {
+            if (length > 64) {
+                if (length > 96) {
+                    acc += mix16(input + 48, secret + 96);
+                    acc += mix16(input + length - 64, secret + 112);
+                }
+                acc += mix16(input + 32, secret + 64);
+                acc += mix16(input + length - 48, secret + 80);
+            }
+            acc += mix16(input + 16, secret + 32);
+            acc += mix16(input + length - 32, secret + 48);
+        }
+        acc += mix16(input, secret);
+        acc += mix16(input + length - 16, secret + 16);
+        return xxh3_avalanche(acc);
+    }
+
+    size_t rounds = length / 16;
+    for (size_t i = 0; i < 8; i++) acc += mix16(input + 16 * i, secret + 16 * i);
+    acc = xxh3_avalanche(acc);
+    for (size_t i = 8; i < rounds; i++) acc += mix16(input + 16 * i, secret + 16 * (i - 8) + 3);
+    acc += mix16(input + length - 16, secret + 136 - 17);
+    return xxh3_avalanche(acc);
+}
+
+// Biriktirici yolları: stripes adet 64 byte'lık şeridi işle / blok
+// sonunda biriktiricileri karıştır
+typedef void (*accumulate_fn)(uint64_t *acc, const uint8_t *input, const uint8_t *key, size_t stripes);
+typedef void (*scramble_fn)(uint64_t *acc, const uint8_t *key);
+
+static void accumulate_scalar(uint64_t *acc, const uint8_t *input, const uint8_t *key, size_t stripes) {
+    for (size_t s = 0; s < stripes; s++, input += STRIPE_LEN, key += SECRET_CONSUME) {
+        for (int i = 0; i < 8; i++) {
+            uint64_t value = read64(input + 8 * i);
+            uint64_t keyed = value ^ read64(key + 8 * i);
+            acc[i ^ 1] += value;
+            acc[i] += (keyed & 0xFFFFFFFF) * (keyed >> 32);
+        }
+    }
+}
+
+static void scramble_scalar(uint64_t *acc, const uint8_t *key) {
+    for (int i = 0; i < 8; i++) {
+        uint64_t a = acc[i];
+        a ^= a >> 47;
+        a ^= read64(key + 8 * i);
+        acc[i] = a * PRIME32_1;
+    }
+}
+
+#ifdef HASH_X86
+__attribute__((target("sse2")))
+static void accumulate_sse2(uint64_t *acc, const uint8_t *input, const uint8_t *key, size_t stripes) {
+    __m128i *xacc = (__m128i *) acc;
+
+    for (size_t s = 0; s < stripes; s++, input += STRIPE_LEN, key += SECRET_CONSUME) {
+        for (int i = 0; i < 4; i++) {
+            __m128i data = _mm_loadu_si128((const __m128i *) (input + 16 * i));
+            __m128i keyed = _mm_xor_si128(data, _mm_loadu_si128((const __m128i *) (key + 16 * i)));
+            __m128i product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+            __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+            xacc[i] = _mm_add_epi64(product, _mm_add_epi64(xacc[i], swapped));
+        }
+    }
+}
+
+__attribute__((target("sse2")))
+static void scramble_sse2(uint64_t *acc, const uint8_t *key) {
+    __m128i *xacc = (__m128i *) acc;
+    const __m128i prime = _mm_set1_epi32((int) PRIME32_1);
+
+    for (int i = 0; i < 4; i++) {
+        __m128i a = _mm_xor_si128(xacc[i], _mm_srli_epi64(xacc[i], 47));
+        __m128i keyed = _mm_xor_si128(a, _mm_loadu_si128((const __m128i *) (key + 16 * i)));
+        __m128i lo = _mm_mul_epu32(keyed, prime);
+        __m128i hi = _mm_mul_epu32(_mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+        xacc[i] = _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+    }
+}
+
+__attribute__((target("avx2")))
+static void accumulate_avx2(uint64_t *acc, const uint8_t *input, const uint8_t *key, size_t stripes) {
+    __m256i a0 = _mm256_load_si256((const __m256i *) acc);
+    __m256i a1 = _mm256_load_si256((const __m256i *) acc + 1);
+
+    for (size_t s = 0; s < stripes; s++, input += STRIPE_LEN, key += SECRET_CONSUME) {
+        __m256i d0 = _mm256_loadu_si256((const __m256i *) input);
+        __m256i d1 = _mm256_loadu_si256((const __m256i *) (input + 32));
+        __m256i k0 = _mm256_xor_si256(d0, _mm256_loadu_si256((const __m256i *) key));
+        __m256i k1 = _mm256_xor_si256(d1, _mm256_loadu_si256((const __m256i *) (key + 32)));
+        a0 = _mm256_add_epi64(a0, _mm256_shuffle_epi32(d0, _MM_SHUFFLE(1, 0, 3, 2)));
+        a1 = _mm256_add_epi64(a1, _mm256_shuffle_epi32(d1, _MM_SHUFFLE(1, 0, 3, 2)));
+        a0 = _mm256_add_epi64(a0, _mm256_mul_epu32(k0, _mm256_srli_epi64(k0, 32)));
+        a1 = _mm256_add_epi64(a1, _mm256_mul_epu32(k1, _mm256_srli_epi64(k1, 32)));
+    }
+    _mm256_store_si256((__m256i *) acc, a0);
+    _mm256_store_si256((__m256i *) acc + 1, a1);
+}
+
+__attribute__((target("avx2")))
+static void scramble_avx2(uint64_t *acc, const uint8_t *key) {
+    __m256i *xacc = (__m256i *) acc;
+    const __m256i prime = _mm256_set1_epi32((int) PRIME32_1);
+
+    for (int i = 0; i < 2; i++) {
+        __m256i a = _mm256_xor_si256(xacc[i], _mm256_srli_epi64(xacc[i], 47));
+        __m256i keyed = _mm256_xor_si256(a, _mm256_loadu_si256((const __m256i *) (key + 32 * i)));
+        __m256i lo = _mm256_mul_epu32(keyed, prime);
+        __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(keyed, 32), prime);
+        xacc[i] = _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+    }
+}
+#endif
+
+static accumulate_fn accumulate = accumulate_scalar;
+static scramble_fn scramble = scramble_scalar;
+static const char *xxh3_name = "scalar";
+
+static const uint64_t initial_acc[8] = {
+    PRIME32_3, PRIME64_1, PRIME64_2, PRIME64_3, PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1
+};
+
+// Secret'ın 128 byte'ı 16 şeritlik bir bloğu karşılar; blok sonunda
+// biriktiriciler karıştırılır. Bloktaki yeni şerit konumunu döndürür.
+static uint32_t consume_stripes(uint64_t *acc, uint32_t done, const uint8_t *input, size_t stripes) {
+    while (done + stripes >= STRIPES_PER_BLOCK) {
+        size_t now = STRIPES_PER_BLOCK - done;
+        accumulate(acc, input, secret + done * SECRET_CONSUME, now);
+        scramble(acc, secret + SECRET_SIZE - STRIPE_LEN);
+        input += now * STRIPE_LEN;
+        stripes -= now;
+        done = 0;
+    }
+    accumulate(acc, input, secret + done * SECRET_CONSUME, stripes);
+    return done + (uint32_t) stripes;
+}
+
+void xxh3_reset(xxh3_state_t *state) {
+    memcpy(state->acc, initial_acc, sizeof(initial_acc));
+    state->buffered = 0;
+    state->stripes = 0;
+    state->total = 0;
+}
+
+// Tampon her zaman en az bir byte tutar: son şerit özet sırasında ayrı
+// işlendiği için son parça erken tüketilmez
+void xxh3_update(xxh3_state_t *state, const void *data, size_t size) {
+    const uint8_t *input = data;
+
+    state->total += size;
+    if (state->buffered + size <= BUFFER_SIZE) {
+        memcpy(state->buffer + state->buffered, input, size);
+        state->buffered += (uint32_t) size;
+        return;
+    }
+
+    if (state->buffered) {
+        size_t fill = BUFFER_SIZE - state->buffered;
+        memcpy(state->buffer + state->buffered, input, fill);
+        input += fill;
+        size -= fill;
+        state->stripes = consume_stripes(state->acc, state->stripes, state->buffer, BUFFER_SIZE / STRIPE_LEN);
+        state->buffered = 0;
+    }
+
+    // Büyük girdi kopyalanmadan işlenir; sondaki <= BUFFER_SIZE byte kalır
+    if (size > BUFFER_SIZE) {
+        size_t whole = ((size - 1) / BUFFER_SIZE) * BUFFER_SIZE;
+        state->stripes = consume_stripes(state->acc, state->stripes, input, whole / STRIPE_LEN);
+        input += whole;
+        size -= whole;
+        // Tampona düşen kısa son parça için önceki şerit gerekebilir
+        memcpy(state->buffer + BUFFER_SIZE - STRIPE_LEN, input - STRIPE_LEN, STRIPE_LEN);
+    }
+
+    memcpy(state->buffer, input, size);
+    state->buffered = (uint32_t) size;
+}
+
+uint64_t xxh3_digest(const xxh3_state_t *state) {
+    if (state->total <= MID_SIZE_MAX) return hash_short(state->buffer, (size_t) state->total);
+
+    uint64_t acc[8] __attribute__((aligned(64)));
+    uint8_t last[STRIPE_LEN];
+    const uint8_t *tail;
+
+    memcpy(acc, state->acc, sizeof(acc));
+    if (state->buffered >= STRIPE_LEN) {
+        size_t stripes = (state->buffered - 1) / STRIPE_LEN;
+        consume_stripes(acc, state->stripes, state->buffer, stripes);
+        tail = state->buffer + state->buffered - STRIPE_LEN;
+    } else {
+        // Son şeridin eksiği önceki parçanın sonundan tamamlanır
+        size_t catchup = STRIPE_LEN - state->buffered;
+        memcpy(last, state->buffer + BUFFER_SIZE - catchup, catchup);
+        memcpy(last + catchup, state->buffer, state->buffered);
+        tail = last;
+    }
+    accumulate(acc, tail, secret + SECRET_SIZE - STRIPE_LEN - SECRET_LASTACC, 1);
+
+    uint64_t result = state->total * PRIME64_1;
+    for (int i = 0; i < 4; i++) {
+        const uint8_t *key = secret + SECRET_MERGEACCS + 16 * i;
+        result += mul128_fold64(acc[2 * i] ^ read64(key), acc[2 * i + 1] ^ read64(key + 8));
+    }
+    return xxh3_avalanche(result);
+}
+
+uint64_t xxh3_64(const void *data, size_t size) {
+    xxh3_state_t state;
+
+    if (size <= MID_SIZE_MAX) return hash_short(data, size);
+    xxh3_reset(&state);
+    xxh3_update(&state, data, size);
+    return xxh3_digest(&state);
+}
+
+/* ================ SHA-256 ================ */
+
+static const uint32_t K[64] __attribute__((aligned(16))) = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+typedef void (*sha256_blocks_fn)(uint32_t *h, const uint8_t *data, size_t blocks);
+
+static void sha256_blocks_scalar(uint32_t *h, const uint8_t *data, size_t blocks) {
+    uint32_t w[64];
+
+    for (; blocks; blocks--, data += 64) {
+        for (int i = 0; i < 16; i++) w[i] = read32_be(data + 4 * i);
+        for (int i = 16; i < 64; i++) {
+            uint32_t s0 = rotr32(w[i - 15], 7) ^ rotr32(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotr32(w[i - 2], 17) ^ rotr32(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], k = h[7];
+        for (int i = 0; i < 64; i++) {
+            uint32_t t1 = k + (rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+            uint32_t t2 = (rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            k = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+        h[4] += e; h[5] += f; h[6] += g; h[7] += k;
+    }
+}
+
+#ifdef HASH_X86
+// SHA-NI: durum ABEF/CDGH yazmaçlarında tutulur, her sha256rnds2 iki tur
+// işler. g. dörtlü turda mesaj kelimeleri cur'dadır; sonraki kelimeler
+// (next) msg1/msg2 ile önceden genişletilir.
+#define SHA_QROUND(g, cur, prev, next)                                                   \
+    do {                                                                                 \
+        msg = _mm_add_epi32(cur, _mm_load_si128((const __m128i *) (K + 4 * (g))));       \
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);                             \
+        if ((g) >= 3 && (g) <= 14) {                                                     \
+            next = _mm_add_epi32(next, _mm_alignr_epi8(cur, prev, 4));                   \
+            next = _mm_sha256msg2_epu32(next, cur);                                      \
+        }                                                                                \
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));    \
+        if ((g) >= 1 && (g) <= 12) prev = _mm_sha256msg1_epu32(prev, cur);               \
+    } while (0)
+
+__attribute__((target("sha,sse4.1,ssse3")))
+static void sha256_blocks_shani(uint32_t *h, const uint8_t *data, size_t blocks) {
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0, state1, msg, m0, m1, m2, m3;
+
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) h), 0xB1);        // CDAB
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *) (h + 4)), 0x1B);       // EFGH
+    state0 = _mm_alignr_epi8(tmp, state1, 8);                                           // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);                                        // CDGH
+
+    for (; blocks; blocks--, data += 64) {
+        __m128i abef = state0, cdgh = state1;
+
+        m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) data), mask);
+        m1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (data + 16)), mask);
+        m2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (data + 32)), mask);
+        m3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *) (data + 48)), mask);
+
+        SHA_QROUND(0, m0, m3, m1);
+        SHA_QROUND(1, m1, m0, m2);
+        SHA_QROUND(2, m2, m1, m3);
+        SHA_QROUND(3, m3, m2, m0);
+        SHA_QROUND(4, m0, m3, m1);
+        SHA_QROUND(5, m1, m0, m2);
+        SHA_QROUND(6, m2, m1, m3);
+        SHA_QROUND(7, m3, m2, m0);
+        SHA_QROUND(8, m0, m3, m1);
+        SHA_QROUND(9, m1, m0, m2);
+        SHA_QROUND(10, m2, m1, m3);
+        SHA_QROUND(11, m3, m2, m0);
+        SHA_QROUND(12, m0, m3, m1);
+        SHA_QROUND(13, m1, m0, m2);
+        SHA_QROUND(14, m2, m1, m3);
+        SHA_QROUND(15, m3, m2, m0);
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);                                              // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);                                           // DCHG
+    _mm_storeu_si128((__m128i *) h, _mm_blend_epi16(tmp, state1, 0xF0));                // DCBA
+    _mm_storeu_si128((__m128i *) (h + 4), _mm_alignr_epi8(state1, tmp, 8));             // HGFE
+}
+#endif
+
+static sha256_blocks_fn sha256_blocks = sha256_blocks_scalar;
+static const char *sha256_name = "scalar";
+
+void sha256_reset(sha256_state_t *state) {
+    static const uint32_t initial[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    memcpy(state->h, initial, sizeof(initial));
+    state->buffered = 0;
+    state->total = 0;
+}
+
+void sha256_update(sha256_state_t *state, const void *data, size_t size) {
+    const uint8_t *input = data;
+
+    state->total += size;
+    if (state->buffered) {
+        size_t fill = 64 - state->buffered;
+        if (fill > size) fill = size;
+        memcpy(state->buffer + state->buffered, input, fill);
+        state->buffered += (uint32_t) fill;
+        input += fill;
+        size -= fill;
+        if (state->buffered < 64) return;
+        sha256_blocks(state->h, state->buffer, 1);
+        state->buffered = 0;
+    }
+    if (size >= 64) {
+        sha256_blocks(state->h, input, size / 64);
+        input += size & ~(size_t) 63;
+        size &= 63;
+    }
+    memcpy(state->buffer, input, size);
+    state->buffered = (uint32_t) size;
+}
+
+void sha256_final(sha256_state_t *state, uint8_t digest[32]) {
+    uint64_t bits = state->total * 8;
+    uint8_t pad[72] = { 0x80 };
+    size_t padding = (state->buffered < 56 ? 56 : 120) - state->buffered;
+
+    for (int i = 0; i < 8; i++) pad[padding + i] = (uint8_t) (bits >> (56 - 8 * i));
+    sha256_update(state, pad, padding + 8);
+    for (int i = 0; i < 8; i++) {
+        digest[4 * i] = (uint8_t) (state->h[i] >> 24);
+        digest[4 * i + 1] = (uint8_t) (state->h[i] >> 16);
+        digest[4 * i + 2] = (uint8_t) (state->h[i] >> 8);
+        digest[4 * i + 3] = (uint8_t) state->h[i];
+    }
+}
+
+/* ================ SEÇİM VE DOSYA ÖZETİ ================ */
+
+static char impl_text[64] = "xxh3=scalar sha256=scalar";
+
+#ifdef HASH_X86
+// AVX2 için işlemci desteği yetmez, çekirdeğin YMM durumunu kaydetmesi
+// de gerekir (OSXSAVE + XCR0)
+static int os_saves_ymm(void) {
+    uint32_t lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    (void) hi;
+    return (lo & 0x6) == 0x6;
+}
+#endif
+
+void hash_init(int allow_simd) {
+    accumulate = accumulate_scalar;
+    scramble = scramble_scalar;
+    xxh3_name = "scalar";
+    sha256_blocks = sha256_blocks_scalar;
+    sha256_name = "scalar";
+
+#ifdef HASH_X86
+    unsigned int eax, ebx, ecx, edx;
+    unsigned int ebx7 = 0;
+
+    if (allow_simd && __get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        int sse2 = (edx >> 26) & 1, ssse3 = (ecx >> 9) & 1, sse41 = (ecx >> 19) & 1;
+        int avx = ((ecx >> 27) & 1) && ((ecx >> 28) & 1) && os_saves_ymm();
+
+        unsigned int unused;
+        if (__get_cpuid_max(0, NULL) >= 7) __cpuid_count(7, 0, unused, ebx7, unused, unused);
+
+        if (avx && ((ebx7 >> 5) & 1)) {
+            accumulate = accumulate_avx2;
+            scramble = scramble_avx2;
+            xxh3_name = "avx2";
+        } else if (sse2) {
+            accumulate = accumulate_sse2;
+            scramble = scramble_sse2;
+            xxh3_name = "sse2";
+        }
+        if (((ebx7 >> 29) & 1) && ssse3 && sse41) {
+            sha256_blocks = sha256_blocks_shani;
+            sha256_name = "sha-ni";
+        }
+    }
+#else
+    (void) allow_simd;
+#endif
+    snprintf(impl_text, sizeof(impl_text), "xxh3=%s sha256=%s", xxh3_name, sha256_name);
+}
+
+const char *hash_impl(void) {
+    return impl_text;
+}
+
+void hash_buffer(const void *data, size_t size, int flags, file_hash_t *out) {
+    out->xxh3 = xxh3_64(data, size);
+    out->bytes = size;
+    out->has_sha256 = (flags & HASH_SHA256) != 0;
+    if (out->has_sha256) {
+        sha256_state_t sha;
+        sha256_reset(&sha);
+        sha256_update(&sha, data, size);
+        sha256_final(&sha, out->sha256);
+    }
+}
+
+int hash_fd(int fd, int flags, file_hash_t *out) {
+    uint8_t chunk[HASH_CHUNK] __attribute__((aligned(64)));
+    xxh3_state_t xxh;
+    sha256_state_t sha;
+    off_t offset = 0;
+
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    xxh3_reset(&xxh);
+    if (flags & HASH_SHA256) sha256_reset(&sha);
+
+    for (;;) {
+        ssize_t n = pread(fd, chunk, sizeof(chunk), offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (n == 0) break;
+        xxh3_update(&xxh, chunk, (size_t) n);
+        if (flags & HASH_SHA256) sha256_update(&sha, chunk, (size_t) n);
+        offset += n;
+    }
+
+    out->xxh3 = xxh3_digest(&xxh);
+    out->bytes = (uint64_t) offset;
+    out->has_sha256 = (flags & HASH_SHA256) != 0;
+    if (out->has_sha256) sha256_final(&sha, out->sha256);
+    return 0;
+}
@@ -0,0 +1,62 @@
+#ifndef ELFMON_HASH_H
+#define ELFMON_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// İçerik özetleri. XXH3-64 (varsayılan secret, seed 0) değişiklik tespiti
+// ve kopya eşleştirmesi için, SHA-256 denetim kaydı için hesaplanır.
+// Her ikisi de akış halinde beslenir: eşlenmiş dosya tek seferde, açık
+// dosya pread ile HASH_CHUNK'lık parçalar halinde.
+//
+// hash_init CPUID'ye bakıp en hızlı yolu seçer: XXH3 için AVX2 / SSE2 /
+// skaler biriktirici, SHA-256 için SHA-NI / skaler blok işleyici. Sonuç
+// tüm yollarda bit bit aynıdır.
+
+#define HASH_CHUNK   (128 * 1024)   // pread parça boyutu
+#define HASH_SHA256  0x01           // hash_fd/hash_buffer: SHA-256 de hesapla
+
+typedef struct {
+    uint64_t acc[8];
+    uint8_t buffer[256];
+    uint32_t buffered;
+    uint32_t stripes;               // Mevcut bloktaki işlenmiş şerit
+    uint64_t total;
+} __attribute__((aligned(64))) xxh3_state_t;
+
+typedef struct {
+    uint32_t h[8];
+    uint8_t buffer[64];
+    uint32_t buffered;
+    uint64_t total;
+} sha256_state_t;
+
+typedef struct {
+    uint64_t xxh3;
+    uint8_t sha256[32];
+    int has_sha256;
+    uint64_t bytes;                 // Özetlenen byte
+} file_hash_t;
+
+// Uygulamaları seç; allow_simd == 0 ise yalnızca skaler yollar
+void hash_init(int allow_simd);
+
+// Seçilen yollar, ör. "xxh3=avx2 sha256=sha-ni"
+const char *hash_impl(void);
+
+void xxh3_reset(xxh3_state_t *state);
+void xxh3_update(xxh3_state_t *state, const void *data, size_t size);
+uint64_t xxh3_digest(const xxh3_state_t *state);
+uint64_t xxh3_64(const void *data, size_t size);
+
+void sha256_reset(sha256_state_t *state);
+void sha256_update(sha256_state_t *state, const void *data, size_t size);
+void sha256_final(sha256_state_t *state, uint8_t digest[32]);
+
+// Bellekteki içeriği özetle (flags: HASH_SHA256)
+void hash_buffer(const void *data, size_t size, int flags, file_hash_t *out);
+
+// Açık dosyayı baştan sona pread ile özetle; 0 başarı, -1 okuma hatası
+int hash_fd(int fd, int flags, file_hash_t *out);
+
+#endif
@@ -0,0 +1,536 @@
+#define _GNU_SOURCE
+#include <elf.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <syslog.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include "log_writer.h"
+
+#define LOG_BATCH      256          // Tek writev'deki en fazla kayıt
+#define LOG_FORMATTED  (LOG_PATH_MAX + 3 * LOG_STRINGS + 1024)
+#define LOG_IDLE_MS    100          // Boş halkada en uzun bekleme
+#define STALL_SPINS    64
+
+// Halka hücresi: seq == konum ise boş (üretici yazabilir), konum + 1 ise
+// dolu (tüketici okuyabilir)
+typedef struct {
+    size_t seq;
+    log_record_t record;
+} __attribute__((aligned(64))) cell_t;
+
+static cell_t *ring = NULL;
+static size_t ring_mask = 0;
+static size_t enqueue_pos __attribute__((aligned(64))) = 0;
+static size_t dequeue_pos __attribute__((aligned(64))) = 0;
+
+static log_options_t options;
+static char log_path[PATH_MAX];
+static int log_fd = -1;
+static uint64_t file_size = 0;
+static time_t opened_at = 0;
+
+static pthread_t thread;
+static pthread_mutex_t wake_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake_cond = PTHREAD_COND_INITIALIZER;
+static int sleeping = 0;
+static int stopping = 0;
+static int started = 0;
+
+static log_stats_t stats;
+static uint64_t dropped_reported = 0;
+
+static inline void count(uint64_t *counter, uint64_t n) {
+    __atomic_add_fetch(counter, n, __ATOMIC_RELAXED);
+}
+
+/* ================ HALKA ================ */
+
+// Boş hücre ayır ve kaydı yayınla; halka doluysa 0 döndürür
+static int ring_push(const log_record_t *record) {
+    size_t pos = __atomic_load_n(&enqueue_pos, __ATOMIC_RELAXED);
+
+    for (;;) {
+        cell_t *cell = &ring[pos & ring_mask];
+        size_t seq = __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE);
+        intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&enqueue_pos, &pos, pos + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                cell->record = *record;
+                __atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+                return 1;
+            }
+        } else if (diff < 0) {
+            return 0;
+        } else {
+            pos = __atomic_load_n(&enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+// Tek tüketici: sıradaki dolu hücreyi al
+static int ring_pop(log_record_t *record) {
+    cell_t *cell = &ring[dequeue_pos & ring_mask];
+
+    if (__atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE) != dequeue_pos + 1) return 0;
+    *record = cell->record;
+    __atomic_store_n(&cell->seq, dequeue_pos + ring_mask + 1, __ATOMIC_RELEASE);
+    dequeue_pos++;
+    return 1;
+}
+
+static int ring_empty(void) {
+    cell_t *cell = &ring[dequeue_pos & ring_mask];
+    return __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE) != dequeue_pos + 1;
+}
+
+/* ================ DOSYA ================ */
+
+static int open_log(void) {
+    struct stat st;
+
+    log_fd = open(log_path, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+    if (log_fd < 0) return -1;
+    file_size = fstat(log_fd, &st) == 0 ? (uint64_t) st.st_size : 0;
+    opened_at = time(NULL);
+    return 0;
+}
+
+// LOG.(n-1) -> LOG.n, ..., LOG -> LOG.1
+static void rotate(void) {
+    char from[PATH_MAX + 8], to[PATH_MAX + 8];
+
+    close(log_fd);
+    for (int i = LOG_KEEP - 1; i >= 1; i--) {
+        snprintf(from, sizeof(from), "%s.%d", log_path, i);
+        snprintf(to, sizeof(to), "%s.%d", log_path, i + 1);
+        rename(from, to);
+    }
+    snprintf(to, sizeof(to), "%s.1", log_path);
+    rename(log_path, to);
+
+    if (open_log() != 0) syslog(LOG_ERR, "Log dosyası açılamadı: %s", log_path);
+    count(&stats.rotations, 1);
+}
+
+static int needs_rotation(time_t now) {
+    if (log_fd < 0) return 0;
+    if (options.max_size && file_size >= options.max_size) return 1;
+    return options.max_age && now - opened_at >= (time_t) options.max_age;
+}
+
+/* ================ BİÇİMLEME ================ */
+
+// Zaman damgası saniyede bir kez üretilir
+static const char *timestamp(time_t t) {
+    static char text[32];
+    static time_t cached = -1;
+    struct tm local;
+
+    if (t != cached) {
+        strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", localtime_r(&t, &local));
+        cached = t;
+    }
+    return text;
+}
+
+// snprintf'i sınır içinde art arda eklemek için
+typedef struct {
+    char *out;
+    size_t size, used;
+} text_t;
+
+static void append(text_t *t, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+static void append(text_t *t, const char *fmt, ...) {
+    va_list args;
+
+    if (t->used + 1 >= t->size) return;
+    va_start(args, fmt);
+    int n = vsnprintf(t->out + t->used, t->size - t->used, fmt, args);
+    va_end(args);
+    if (n < 0) return;
+    t->used += (size_t) n < t->size - t->used ? (size_t) n : t->size - t->used - 1;
+}
+
+// Derin analiz satırları: sınıf, interpreter, build-id, bağımlılıklar,
+// yüklenen segmentler ve section adları
+static void format_deep(const log_record_t *r, text_t *t) {
+    const char *machine = elf_machine_name(r->machine);
+    const char *type = elf_type_name(r->elf_type);
+    const char *s = r->strings;
+    const char *end = r->strings + r->strings_used;
+
+    append(t, "Sinif: ELF%d", r->elf_class == ELFCLASS64 ? 64 : 32);
+    if (machine) append(t, " Makine: %s", machine); else append(t, " Makine: 0x%x", r->machine);
+    if (type) append(t, " Tur: %s\n", type); else append(t, " Tur: 0x%x\n", r->elf_type);
+
+    if (s < end && *s) append(t, "Interpreter: %s\n", s);
+    s += strnlen(s, (size_t) (end - s)) + 1;
+
+    if (r->build_id_length) {
+        append(t, "Build-ID: ");
+        for (uint32_t i = 0; i < r->build_id_length; i++) append(t, "%02x", r->build_id[i]);
+        append(t, "\n");
+    }
+
+    if (r->needed_count) {
+        append(t, "Bagimliliklar:");
+        for (uint32_t i = 0; i < r->needed_count && s < end; i++) {
+            append(t, "%s%s", i ? ", " : " ", s);
+            s += strnlen(s, (size_t) (end - s)) + 1;
+        }
+        append(t, "\n");
+    }
+
+    uint32_t loads = r->load_count < ELF_PARSE_MAX_LOADS ? r->load_count : ELF_PARSE_MAX_LOADS;
+    for (uint32_t i = 0; i < loads; i++) {
+        const elf_load_t *l = &r->loads[i];
+        append(t, "LOAD off=0x%llx vaddr=0x%llx filesz=0x%llx memsz=0x%llx %c%c%c\n",
+               (unsigned long long) l->offset, (unsigned long long) l->vaddr,
+               (unsigned long long) l->filesz, (unsigned long long) l->memsz,
+               (l->flags & PF_R) ? 'R' : '-', (l->flags & PF_W) ? 'W' : '-',
+               (l->flags & PF_X) ? 'X' : '-');
+    }
+    if (r->load_count > loads) append(t, "LOAD ... (+%u)\n", r->load_count - loads);
+
+    if (r->section_count) {
+        append(t, "Sectionlar:");
+        for (uint32_t i = 0; i < r->section_count && s < end; i++) {
+            append(t, " %s", s);
+            s += strnlen(s, (size_t) (end - s)) + 1;
+        }
+        append(t, "\n");
+    }
+    if (r->flags & LOG_STRINGS_CUT) append(t, "(liste kirpildi)\n");
+}
+
+static void format_hash(const log_record_t *r, text_t *t) {
+    if (r->flags & LOG_HASH) append(t, "XXH3: %016llx\n", (unsigned long long) r->xxh3);
+    if (r->flags & LOG_SHA256) {
+        append(t, "SHA-256: ");
+        for (int i = 0; i < 32; i++) append(t, "%02x", r->sha256[i]);
+        append(t, "\n");
+    }
+}
+
+static int format_record(const log_record_t *r, char *out, size_t size) {
+    const char *path_suffix = (r->flags & LOG_TRUNCATED) ? "..." : "";
+    const char *ts = timestamp((time_t) r->time);
+    const char *kind = r->elf_class == ELFCLASS32 ? "ELF32" : "x64 ELF";
+    text_t t = { out, size, 0 };
+
+    out[0] = '\0';
+    if (r->type == LOG_ELF_GONE) {
+        append(&t, "[%s] Artik ELF degil: %s%s\n\n", ts, r->path, path_suffix);
+        return (int) t.used;
+    }
+    if (r->type == LOG_ELF_COPY) {
+        append(&t, "[%s] Kopya %s: %s%s\nAyni icerik: %s\n", ts, kind, r->path, path_suffix, r->strings);
+        format_hash(r, &t);
+        append(&t, "\n");
+        return (int) t.used;
+    }
+
+    append(&t, "[%s] %s %s: %s%s\n"
+               "Entry Point: 0x%llx\n"
+               "Section sayisi: %u\n"
+               "Program header sayisi: %u\n",
+           ts, r->type == LOG_ELF_CHANGED ? "Degisen" : "Tespit edilen", kind,
+           r->path, path_suffix, (unsigned long long) r->entry, r->shnum, r->phnum);
+    format_hash(r, &t);
+    if (r->flags & LOG_DEEP) format_deep(r, &t);
+    append(&t, "\n");
+    return (int) t.used;
+}
+
+static void syslog_record(const log_record_t *r) {
+    const char *kind = r->elf_class == ELFCLASS32 ? "ELF32" : "X64 ELF";
+
+    switch (r->type) {
+    case LOG_ELF_FOUND:   syslog(LOG_INFO, "%s tespit edildi: %s", kind, r->path); break;
+    case LOG_ELF_CHANGED: syslog(LOG_INFO, "%s degisti: %s", kind, r->path); break;
+    case LOG_ELF_GONE:    syslog(LOG_INFO, "Artik ELF degil: %s", r->path); break;
+    case LOG_ELF_COPY:
+        syslog(LOG_INFO, "Kopya %s: %s (%s ile ayni)", kind, r->path, r->strings);
+        break;
+    default: break;
+    }
+}
+
+/* ================ LOG İŞ PARÇACIĞI ================ */
+
+static void write_all(struct iovec *iov, int iovcnt) {
+    while (iovcnt > 0 && log_fd >= 0) {
+        ssize_t n = writev(log_fd, iov, iovcnt);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        count(&stats.bytes, (uint64_t) n);
+        file_size += (uint64_t) n;
+
+        // Kısmi yazma: tamamlanan parçaları atla
+        while (iovcnt > 0 && (size_t) n >= iov->iov_len) {
+            n -= (ssize_t) iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0) {
+            iov->iov_base = (char *) iov->iov_base + n;
+            iov->iov_len -= (size_t) n;
+        }
+    }
+}
+
+// Halkadan en fazla LOG_BATCH kayıt al ve tek writev ile yaz; alınan
+// kayıt sayısını döndürür
+static int drain_batch(char *arena, struct iovec *iov) {
+    log_record_t record;
+    int n = 0, records;
+
+    while (n < LOG_BATCH && ring_pop(&record)) {
+        char *out = arena + (size_t) n * LOG_FORMATTED;
+        iov[n].iov_base = out;
+        iov[n].iov_len = (size_t) format_record(&record, out, LOG_FORMATTED);
+        n++;
+        if (options.use_syslog) syslog_record(&record);
+    }
+    records = n;
+
+    // Atılan kayıtlar da loga düşülür
+    uint64_t dropped = __atomic_load_n(&stats.dropped, __ATOMIC_RELAXED);
+    if (dropped != dropped_reported) {
+        char *out = arena + (size_t) n * LOG_FORMATTED;
+        int len = snprintf(out, LOG_FORMATTED, "[%s] Log halkasi dolu: %llu kayit atildi\n\n",
+                           timestamp(time(NULL)), (unsigned long long) (dropped - dropped_reported));
+        iov[n].iov_base = out;
+        iov[n].iov_len = (size_t) len;
+        n++;
+        dropped_reported = dropped;
+    }
+
+    if (n > 0) {
+        write_all(iov, n);
+        count(&stats.batches, 1);
+    }
+    return records;
+}
+
+static void *log_main(void *arg) {
+    (void) arg;
+    char *arena = malloc((size_t) (LOG_BATCH + 1) * LOG_FORMATTED);
+    struct iovec *iov = malloc((LOG_BATCH + 1) * sizeof(struct iovec));
+
+    for (;;) {
+        int n = (arena && iov) ? drain_batch(arena, iov) : 0;
+        if (needs_rotation(time(NULL))) rotate();
+        if (n > 0) {
+            count(&stats.written, (uint64_t) n);
+            continue;
+        }
+
+        // Boşken uyu; üretici sleeping'i görünce kilidi alıp uyandırır
+        pthread_mutex_lock(&wake_lock);
+        if (__atomic_load_n(&stopping, __ATOMIC_SEQ_CST) && ring_empty()) {
+            pthread_mutex_unlock(&wake_lock);
+            break;
+        }
+        __atomic_store_n(&sleeping, 1, __ATOMIC_SEQ_CST);
+        if (ring_empty()) {
+            struct timespec until;
+            clock_gettime(CLOCK_REALTIME, &until);
+            until.tv_nsec += LOG_IDLE_MS * 1000000L;
+            if (until.tv_nsec >= 1000000000L) {
+                until.tv_sec++;
+                until.tv_nsec -= 1000000000L;
+            }
+            pthread_cond_timedwait(&wake_cond, &wake_lock, &until);
+        }
+        __atomic_store_n(&sleeping, 0, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&wake_lock);
+    }
+    free(arena);
+    free(iov);
+    return NULL;
+}
+
+/* ================ ARAYÜZ ================ */
+
+int log_writer_start(const char *path, const log_options_t *opts) {
+    size_t size = opts->ring_size ? opts->ring_size : LOG_RING_SIZE;
+
+    if (started || (size & (size - 1)) != 0) return -1;
+    options = *opts;
+    snprintf(log_path, sizeof(log_path), "%s", path);
+
+    ring = aligned_alloc(64, size * sizeof(cell_t));
+    if (!ring) return -1;
+    for (size_t i = 0; i < size; i++) ring[i].seq = i;
+    ring_mask = size - 1;
+    enqueue_pos = dequeue_pos = 0;
+    memset(&stats, 0, sizeof(stats));
+    dropped_reported = 0;
+    stopping = 0;
+
+    // Dosya açılamazsa kayıtlar yine syslog'a gider
+    if (open_log() != 0) syslog(LOG_ERR, "Log dosyası açılamadı: %s", log_path);
+
+    if (pthread_create(&thread, NULL, log_main, NULL) != 0) {
+        if (log_fd >= 0) close(log_fd);
+        log_fd = -1;
+        free(ring);
+        ring = NULL;
+        return -1;
+    }
+    started = 1;
+    return 0;
+}
+
+void log_writer_stop(void) {
+    if (!started) return;
+
+    pthread_mutex_lock(&wake_lock);
+    __atomic_store_n(&stopping, 1, __ATOMIC_SEQ_CST);
+    pthread_cond_signal(&wake_cond);
+    pthread_mutex_unlock(&wake_lock);
+    pthread_join(thread, NULL);
+
+    if (log_fd >= 0) close(log_fd);
+    log_fd = -1;
+    free(ring);
+    ring = NULL;
+    started = 0;
+}
+
+int log_submit(const log_record_t *record) {
+    int spins = 0;
+
+    if (!__atomic_load_n(&started, __ATOMIC_ACQUIRE) || __atomic_load_n(&stopping, __ATOMIC_ACQUIRE)) {
+        return -1;
+    }
+
+    while (!ring_push(record)) {
+        if (options.policy == LOG_DROP) {
+            count(&stats.dropped, 1);
+            return -1;
+        }
+        // Geri basınç: tüketici yer açana kadar bekle
+        if (spins++ == 0) count(&stats.stalls, 1);
+        if (spins < STALL_SPINS) {
+            sched_yield();
+        } else {
+            struct timespec ts = { 0, 1000000 };
+            nanosleep(&ts, NULL);
+        }
+    }
+    count(&stats.submitted, 1);
+
+    if (__atomic_load_n(&sleeping, __ATOMIC_SEQ_CST)) {
+        pthread_mutex_lock(&wake_lock);
+        pthread_cond_signal(&wake_cond);
+        pthread_mutex_unlock(&wake_lock);
+    }
+    return 0;
+}
+
+void log_record_init(log_record_t *record, uint32_t type, const char *path) {
+    size_t length = strlen(path);
+
+    memset(record, 0, offsetof(log_record_t, path));
+    record->type = type;
+    record->elf_class = ELFCLASS64;
+    record->time = (int64_t) time(NULL);
+    if (length >= LOG_PATH_MAX) {
+        length = LOG_PATH_MAX - 1;
+        record->flags |= LOG_TRUNCATED;
+    }
+    memcpy(record->path, path, length);
+    record->path[length] = '\0';
+}
+
+void log_writer_get_stats(log_stats_t *out) {
+    out->submitted = __atomic_load_n(&stats.submitted, __ATOMIC_RELAXED);
+    out->written = __atomic_load_n(&stats.written, __ATOMIC_RELAXED);
+    out->dropped = __atomic_load_n(&stats.dropped, __ATOMIC_RELAXED);
+    out->stalls = __atomic_load_n(&stats.stalls, __ATOMIC_RELAXED);
+    out->batches = __atomic_load_n(&stats.batches, __ATOMIC_RELAXED);
+    out->bytes = __atomic_load_n(&stats.bytes, __ATOMIC_RELAXED);
+    out->rotations = __atomic_load_n(&stats.rotations, __ATOMIC_RELAXED);
+}
+
+/* ================ DERİN ANALİZ KAYDI ================ */
+
+// Dizgiyi strings alanına ekle; yer yoksa kayıt kırpıldı olarak işaretlenir
+static int add_string(log_record_t *record, const char *text, size_t length) {
+    if ((size_t) record->strings_used + length + 1 > LOG_STRINGS) {
+        record->flags |= LOG_STRINGS_CUT;
+        return -1;
+    }
+    memcpy(record->strings + record->strings_used, text, length);
+    record->strings_used += (uint16_t) (length + 1);
+    record->strings[record->strings_used - 1] = '\0';
+    return 0;
+}
+
+static int add_needed(const char *name, size_t length, void *ctx) {
+    log_record_t *record = ctx;
+    if (add_string(record, name, length) != 0) return 1;
+    record->needed_count++;
+    return 0;
+}
+
+static int add_section(const char *name, size_t length, void *ctx) {
+    log_record_t *record = ctx;
+    if (add_string(record, name, length) != 0) return 1;
+    record->section_count++;
+    return 0;
+}
+
+void log_record_set_elf(log_record_t *record, const elf_info_t *info) {
+    record->flags |= LOG_DEEP;
+    record->elf_class = (uint8_t) info->elf_class;
+    record->machine = info->machine;
+    record->elf_type = info->type;
+    record->entry = info->entry;
+    record->phnum = info->phnum;
+    record->shnum = info->shnum;
+    record->load_count = (uint16_t) (info->load_count > 0xFFFF ? 0xFFFF : info->load_count);
+    memcpy(record->loads, info->loads, sizeof(record->loads));
+
+    record->build_id_length = (uint8_t) (info->build_id_length < LOG_BUILD_ID ?
+                                         info->build_id_length : LOG_BUILD_ID);
+    if (record->build_id_length) memcpy(record->build_id, info->build_id, record->build_id_length);
+
+    // Statik dosyada interpreter boş dizgi olarak yer tutar
+    record->strings_used = 0;
+    add_string(record, info->interp ? info->interp : "", info->interp ? info->interp_length : 0);
+    elf_for_each_needed(info, add_needed, record);
+    elf_for_each_section(info, add_section, record);
+}
+
+void log_record_set_origin(log_record_t *record, const char *first) {
+    size_t length = strnlen(first, LOG_STRINGS - 1);
+
+    record->strings_used = 0;
+    add_string(record, first, length);
+}
+
+void log_record_set_hash(log_record_t *record, uint64_t xxh3, const uint8_t *sha256) {
+    record->flags |= LOG_HASH;
+    record->xxh3 = xxh3;
+    if (sha256) {
+        record->flags |= LOG_SHA256;
+        memcpy(record->sha256, sha256, sizeof(record->sha256));
+    }
+}
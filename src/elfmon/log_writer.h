@@ -0,0 +1,109 @@
+#ifndef ELFMON_LOG_WRITER_H
+#define ELFMON_LOG_WRITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+#include "elf_parse.h"
+
+// Asenkron log yazıcı. Gezgin iş parçacıkları sabit boyutlu kayıtları
+// kilitsiz bir çok-üretici/tek-tüketici halkasına koyar (sıra numaralı
+// hücreler); tek bir log iş parçacığı kayıtları toplu olarak biçimler,
+// açık kalan log dosyasına writev ile yazar ve syslog'a iletir. Dosya
+// boyut ya da yaş sınırını aşınca döndürülür (LOG.1, LOG.2, ...).
+//
+// Halka dolduğunda LOG_BLOCK politikasında üretici yer açılana kadar
+// bekler (tarama yavaşlar), LOG_DROP politikasında kayıt atılır ve
+// sayılır; atılan kayıt sayısı log dosyasına da yazılır.
+
+#define LOG_PATH_MAX   512          // Kayıttaki yol (daha uzunu kırpılır)
+#define LOG_STRINGS    1024         // Derin analiz dizgileri (interp, bağımlılık, section)
+#define LOG_BUILD_ID   32
+#define LOG_RING_SIZE  2048         // Varsayılan halka kapasitesi (2'nin kuvveti)
+#define LOG_KEEP       4            // Saklanan eski log dosyası
+
+#define LOG_BLOCK 0
+#define LOG_DROP  1
+
+// Kayıt türü
+#define LOG_ELF_FOUND    0          // Yeni ELF
+#define LOG_ELF_CHANGED  1          // Değişen ELF
+#define LOG_ELF_GONE     2          // Artık ELF olmayan dosya
+#define LOG_ELF_COPY     3          // Başka bir yoldaki ELF ile aynı içerik
+
+#define LOG_TRUNCATED   0x01        // Yol kırpıldı
+#define LOG_DEEP        0x02        // Derin analiz alanları dolu
+#define LOG_STRINGS_CUT 0x04        // Dizgi alanı doldu, liste eksik
+#define LOG_HASH        0x08        // xxh3 dolu
+#define LOG_SHA256      0x10        // sha256 dolu
+
+// Derin analizde strings sırayla NUL ile biten dizgileri tutar: önce
+// interpreter (statik dosyada boş), sonra needed_count bağımlılık, sonra
+// section_count section adı. LOG_ELF_COPY kaydında strings aynı içeriğin
+// ilk görüldüğü yoldur.
+typedef struct {
+    uint32_t type;
+    uint32_t flags;
+    int64_t  time;
+    uint64_t entry;
+    uint32_t shnum;
+    uint16_t phnum;
+    uint8_t  elf_class;             // ELFCLASS32 / ELFCLASS64
+    uint8_t  build_id_length;
+    uint16_t machine;
+    uint16_t elf_type;
+    uint16_t load_count;            // Tüm PT_LOAD'lar; ilk ELF_PARSE_MAX_LOADS'u loads'ta
+    uint16_t needed_count;
+    uint16_t section_count;
+    uint16_t strings_used;
+    uint8_t  build_id[LOG_BUILD_ID];
+    uint64_t xxh3;
+    uint8_t  sha256[32];
+    elf_load_t loads[ELF_PARSE_MAX_LOADS];
+    char     path[LOG_PATH_MAX];
+    char     strings[LOG_STRINGS];
+} log_record_t;
+
+typedef struct {
+    uint32_t ring_size;             // 0: LOG_RING_SIZE
+    int policy;                     // LOG_BLOCK / LOG_DROP
+    uint64_t max_size;              // Döndürme boyutu (byte, 0: yok)
+    uint32_t max_age;               // Döndürme yaşı (saniye, 0: yok)
+    int use_syslog;                 // Kayıtlar syslog'a da gitsin mi
+} log_options_t;
+
+typedef struct {
+    uint64_t submitted;
+    uint64_t written;
+    uint64_t dropped;               // LOG_DROP: halka doluyken atılan
+    uint64_t stalls;                // LOG_BLOCK: halka doluyken bekleyen üretici
+    uint64_t batches;               // writev çağrısı
+    uint64_t bytes;
+    uint64_t rotations;
+} log_stats_t;
+
+// Log dosyasını aç ve log iş parçacığını başlat (0 başarı, -1 hata)
+int log_writer_start(const char *path, const log_options_t *options);
+
+// Halkadaki her şeyi yaz, iş parçacığını durdur ve dosyayı kapat
+void log_writer_stop(void);
+
+// Kaydı kuyruğa koy; birden fazla iş parçacığından çağrılabilir.
+// 0 başarı, -1 atıldı (LOG_DROP ya da yazıcı çalışmıyor)
+int log_submit(const log_record_t *record);
+
+// Kayıt hazırla: yol kopyalanır (gerekirse kırpılır), zaman doldurulur
+void log_record_init(log_record_t *record, uint32_t type, const char *path);
+
+// Derin analiz sonucunu kayda ekle (info'nun eşlemi hâlâ açık olmalı)
+void log_record_set_elf(log_record_t *record, const elf_info_t *info);
+
+// Kopya kaydına içeriğin ilk görüldüğü yolu ekle
+void log_record_set_origin(log_record_t *record, const char *first);
+
+// İçerik özetlerini kayda ekle (sha256 NULL olabilir)
+void log_record_set_hash(log_record_t *record, uint64_t xxh3, const uint8_t *sha256);
+
+void log_writer_get_stats(log_stats_t *stats);
+
+#endif
@@ -0,0 +1,335 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "metrics.h"
+#include "log_writer.h"
+
+#define METRIC_SLOTS   64           // İş parçacığı yuvası (fazlası paylaşır)
+#define MAX_BUCKETS    14
+#define RENDER_SIZE    16384
+#define CLIENT_WAIT_MS 100          // İstemcinin isteğini gönderme süresi
+
+typedef struct {
+    uint64_t counters[M_COUNTERS];
+    uint64_t buckets[M_HISTOGRAMS][MAX_BUCKETS + 1];   // Son kova +Inf
+    uint64_t sum[M_HISTOGRAMS];                        // Nanosaniye
+} __attribute__((aligned(64))) slot_t;
+
+static slot_t slots[METRIC_SLOTS];
+static __thread slot_t *my_slot = NULL;
+static unsigned next_slot = 0;
+static uint64_t gauges[M_GAUGES];
+static time_t started_at = 0;
+
+// divisor 0 değil ise ham değer ona bölünüp ondalık yazılır (ör. ns -> s)
+typedef struct {
+    const char *name;
+    const char *help;
+    uint64_t divisor;
+} metric_name_t;
+
+static const metric_name_t counter_names[M_COUNTERS] = {
+    { "elfmon_directories_visited_total", "Okunan dizin", 0 },
+    { "elfmon_files_seen_total", "Incelenen duzenli dosya", 0 },
+    { "elfmon_files_statted_total", "stat/fstatat cagrisi", 0 },
+    { "elfmon_files_opened_total", "Icerigi okumak icin acilan dosya", 0 },
+    { "elfmon_files_unchanged_total", "Durum onbellegi sayesinde acilmayan dosya", 0 },
+    { "elfmon_elf_found_total", "Yeni bulunan ELF", 0 },
+    { "elfmon_elf_changed_total", "Icerigi degisen ELF", 0 },
+    { "elfmon_elf_gone_total", "Artik ELF olmayan dosya", 0 },
+    { "elfmon_elf_copies_total", "Baska bir ELF ile ayni icerikte bulunan dosya", 0 },
+    { "elfmon_bytes_read_total", "Okunan ya da eslemden ozetlenen byte", 0 },
+    { "elfmon_bytes_mapped_total", "Derin analizde eslenen byte", 0 },
+    { "elfmon_events_total", "Olay kaynagindan gelen degisiklik", 0 },
+    { "elfmon_passes_total", "Tamamlanan tam tarama", 0 },
+    { "elfmon_throttle_wait_seconds_total", "Hiz siniri ve IO baskisi nedeniyle beklenen sure", 1000000000ULL },
+    { "elfmon_paths_filtered_total", "Include/exclude kurallari ya da dosya sistemi turuyle budanan yol", 0 },
+};
+
+static const metric_name_t gauge_names[M_GAUGES] = {
+    { "elfmon_stat_cache_entries", "Durum onbellegindeki dosya", 0 },
+    { "elfmon_hash_index_entries", "Kopya dizinindeki farkli icerik", 0 },
+    { "elfmon_last_pass_timestamp_seconds", "Son tam taramanin bittigi an", 0 },
+    { "elfmon_io_pressure_ratio", "/proc/pressure/io some avg10 (PSI acikken)", 10000 },
+};
+
+// Kova üst sınırları (nanosaniye), artan
+static const uint64_t file_bounds[MAX_BUCKETS] = {
+    10000, 50000, 100000, 250000, 500000, 1000000, 2500000, 5000000,
+    10000000, 25000000, 50000000, 100000000, 250000000, 1000000000
+};
+static const uint64_t pass_bounds[MAX_BUCKETS] = {
+    10000000, 50000000, 100000000, 500000000, 1000000000ULL, 5000000000ULL, 10000000000ULL,
+    30000000000ULL, 60000000000ULL, 120000000000ULL, 300000000000ULL, 600000000000ULL,
+    1800000000000ULL, 3600000000000ULL
+};
+
+static const struct {
+    const char *name;
+    const char *help;
+    const uint64_t *bounds;
+} histograms[M_HISTOGRAMS] = {
+    { "elfmon_pass_duration_seconds", "Tam tarama suresi", pass_bounds },
+    { "elfmon_file_analysis_seconds", "Acilan dosya basina analiz suresi", file_bounds },
+};
+
+/* ================ KAYIT ================ */
+
+// İş parçacığı ilk kayıtta bir yuva alır; yuvalar döngüsel dağıtılır ve
+// 64'ten fazla iş parçacığı olursa paylaşılır (artırmalar yine atomik)
+static inline slot_t *slot(void) {
+    if (!my_slot) my_slot = &slots[__atomic_fetch_add(&next_slot, 1, __ATOMIC_RELAXED) % METRIC_SLOTS];
+    return my_slot;
+}
+
+void metrics_add(int counter, uint64_t n) {
+    __atomic_add_fetch(&slot()->counters[counter], n, __ATOMIC_RELAXED);
+}
+
+void metrics_set(int gauge, uint64_t value) {
+    __atomic_store_n(&gauges[gauge], value, __ATOMIC_RELAXED);
+}
+
+void metrics_observe(int histogram, uint64_t ns) {
+    const uint64_t *bounds = histograms[histogram].bounds;
+    slot_t *s = slot();
+    int i = 0;
+
+    while (i < MAX_BUCKETS && ns > bounds[i]) i++;
+    __atomic_add_fetch(&s->buckets[histogram][i], 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&s->sum[histogram], ns, __ATOMIC_RELAXED);
+}
+
+uint64_t metrics_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+/* ================ BİÇİMLEME ================ */
+
+typedef struct {
+    char *out;
+    int size, used;
+} text_t;
+
+static void append(text_t *t, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+static void append(text_t *t, const char *fmt, ...) {
+    va_list args;
+
+    if (t->used + 1 >= t->size) return;
+    va_start(args, fmt);
+    int n = vsnprintf(t->out + t->used, (size_t) (t->size - t->used), fmt, args);
+    va_end(args);
+    if (n < 0) return;
+    t->used += n < t->size - t->used ? n : t->size - t->used - 1;
+}
+
+static void append_metric(text_t *t, const char *name, const char *help, const char *type,
+                          unsigned long long value) {
+    append(t, "# HELP %s %s\n# TYPE %s %s\n%s %llu\n", name, help, name, type, name, value);
+}
+
+static void append_named(text_t *t, const metric_name_t *m, const char *type, uint64_t value) {
+    if (!m->divisor) {
+        append_metric(t, m->name, m->help, type, (unsigned long long) value);
+        return;
+    }
+    append(t, "# HELP %s %s\n# TYPE %s %s\n%s %.9g\n", m->name, m->help, m->name, type, m->name,
+           (double) value / (double) m->divisor);
+}
+
+static uint64_t sum_slots(const uint64_t *first) {
+    size_t offset = (size_t) ((const char *) first - (const char *) &slots[0]);
+    uint64_t total = 0;
+
+    for (int i = 0; i < METRIC_SLOTS; i++) {
+        total += __atomic_load_n((const uint64_t *) ((const char *) &slots[i] + offset), __ATOMIC_RELAXED);
+    }
+    return total;
+}
+
+static void append_histogram(text_t *t, int h) {
+    const char *name = histograms[h].name;
+    uint64_t cumulative = 0;
+
+    append(t, "# HELP %s %s\n# TYPE %s histogram\n", name, histograms[h].help, name);
+    for (int i = 0; i <= MAX_BUCKETS; i++) {
+        cumulative += sum_slots(&slots[0].buckets[h][i]);
+        if (i < MAX_BUCKETS) {
+            append(t, "%s_bucket{le=\"%g\"} %llu\n", name, (double) histograms[h].bounds[i] / 1e9,
+                   (unsigned long long) cumulative);
+        } else {
+            append(t, "%s_bucket{le=\"+Inf\"} %llu\n", name, (unsigned long long) cumulative);
+        }
+    }
+    append(t, "%s_sum %.9f\n%s_count %llu\n", name, (double) sum_slots(&slots[0].sum[h]) / 1e9,
+           name, (unsigned long long) cumulative);
+}
+
+int metrics_render(char *out, int size) {
+    text_t t = { out, size, 0 };
+    log_stats_t log;
+
+    out[0] = '\0';
+    for (int i = 0; i < M_COUNTERS; i++) {
+        append_named(&t, &counter_names[i], "counter", sum_slots(&slots[0].counters[i]));
+    }
+    for (int i = 0; i < M_HISTOGRAMS; i++) append_histogram(&t, i);
+    for (int i = 0; i < M_GAUGES; i++) {
+        append_named(&t, &gauge_names[i], "gauge", __atomic_load_n(&gauges[i], __ATOMIC_RELAXED));
+    }
+    append_metric(&t, "elfmon_start_time_seconds", "Surecin basladigi an", "gauge",
+                  (unsigned long long) started_at);
+
+    log_writer_get_stats(&log);
+    append_metric(&t, "elfmon_log_records_total", "Log halkasina konan kayit", "counter",
+                  (unsigned long long) log.submitted);
+    append_metric(&t, "elfmon_log_dropped_total", "Halka doluyken atilan kayit", "counter",
+                  (unsigned long long) log.dropped);
+    append_metric(&t, "elfmon_log_stalls_total", "Halka doluyken bekleyen uretici", "counter",
+                  (unsigned long long) log.stalls);
+    append_metric(&t, "elfmon_log_bytes_total", "Log dosyasina yazilan byte", "counter",
+                  (unsigned long long) log.bytes);
+    return t.used;
+}
+
+/* ================ SOKET SUNUCUSU ================ */
+
+static char socket_path[sizeof(((struct sockaddr_un *) 0)->sun_path)];
+static int listen_fd = -1;
+static int stop_pipe[2] = { -1, -1 };
+static pthread_t thread;
+static int started = 0;
+
+static void write_all(int fd, const char *data, size_t size) {
+    while (size > 0) {
+        ssize_t n = write(fd, data, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        data += n;
+        size -= (size_t) n;
+    }
+}
+
+// İstek kısa bir süre beklenir: HTTP isteği gelirse başlıkla, hiçbir şey
+// gelmezse (socat, nc -U) çıplak metinle yanıt verilir
+static void serve(int client) {
+    static char body[RENDER_SIZE];
+    char request[1024], header[160];
+    struct pollfd pfd = { .fd = client, .events = POLLIN };
+    struct timeval timeout = { 1, 0 };
+    int http = 0;
+
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    if (poll(&pfd, 1, CLIENT_WAIT_MS) > 0) {
+        ssize_t n = read(client, request, sizeof(request) - 1);
+        if (n > 0) {
+            request[n] = '\0';
+            http = strncmp(request, "GET ", 4) == 0 || strncmp(request, "HEAD ", 5) == 0;
+        }
+    }
+
+    int length = metrics_render(body, sizeof(body));
+    if (http) {
+        int n = snprintf(header, sizeof(header),
+                         "HTTP/1.0 200 OK\r\n"
+                         "Content-Type: text/plain; version=0.0.4\r\n"
+                         "Content-Length: %d\r\n\r\n", length);
+        write_all(client, header, (size_t) n);
+        if (strncmp(request, "HEAD ", 5) == 0) return;
+    }
+    write_all(client, body, (size_t) length);
+}
+
+static void *server_main(void *arg) {
+    struct pollfd pfd[2] = {
+        { .fd = listen_fd, .events = POLLIN },
+        { .fd = stop_pipe[0], .events = POLLIN },
+    };
+    (void) arg;
+
+    for (;;) {
+        if (poll(pfd, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (pfd[1].revents) break;
+        if (!(pfd[0].revents & POLLIN)) continue;
+
+        int client = accept4(listen_fd, NULL, NULL, SOCK_CLOEXEC);
+        if (client < 0) continue;
+        serve(client);
+        close(client);
+    }
+    return NULL;
+}
+
+int metrics_start(const char *path) {
+    struct sockaddr_un addr;
+
+    started_at = time(NULL);
+    if (started) return 0;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) return -1;
+    snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path);
+    snprintf(socket_path, sizeof(socket_path), "%s", path);
+
+    // Dizin yoksa bir kez oluşturmayı dene; eski çalışmanın soketi silinir
+    char dir[sizeof(addr.sun_path)];
+    snprintf(dir, sizeof(dir), "%s", path);
+    char *slash = strrchr(dir, '/');
+    if (slash && slash != dir) {
+        *slash = '\0';
+        mkdir(dir, 0755);
+    }
+    unlink(path);
+
+    listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0) return -1;
+    if (bind(listen_fd, (struct sockaddr *) &addr, sizeof(addr)) != 0 ||
+        chmod(path, 0660) != 0 || listen(listen_fd, 16) != 0 ||
+        pipe2(stop_pipe, O_CLOEXEC) != 0) {
+        close(listen_fd);
+        listen_fd = -1;
+        unlink(path);
+        return -1;
+    }
+    if (pthread_create(&thread, NULL, server_main, NULL) != 0) {
+        close(stop_pipe[0]);
+        close(stop_pipe[1]);
+        close(listen_fd);
+        listen_fd = -1;
+        unlink(path);
+        return -1;
+    }
+    started = 1;
+    return 0;
+}
+
+void metrics_stop(void) {
+    if (!started) return;
+
+    write_all(stop_pipe[1], "x", 1);
+    pthread_join(thread, NULL);
+    close(stop_pipe[0]);
+    close(stop_pipe[1]);
+    close(listen_fd);
+    listen_fd = -1;
+    unlink(socket_path);
+    started = 0;
+}
@@ -0,0 +1,66 @@
+#ifndef ELFMON_METRICS_H
+#define ELFMON_METRICS_H
+
+#include <stdint.h>
+
+// Süreç içi sayaçlar ve gecikme histogramları. Değerler iş parçacığı
+// başına ayrı önbellek satırlarındaki yuvalarda biriktirilir (gezgin
+// iş parçacıkları aynı satır için yarışmaz); okuma sırasında yuvalar
+// toplanır.
+//
+// metrics_start bir Unix soketi açar ve ayrı bir iş parçacığında dinler:
+// her bağlantıya Prometheus metin biçiminde (0.0.4) anlık görüntü yazılıp
+// bağlantı kapatılır. İstemci bir HTTP isteği gönderirse yanıt HTTP/1.0
+// başlığıyla döner, böylece
+//   curl --unix-socket /run/elf_monitor/metrics.sock http://localhost/metrics
+// ve "socat - UNIX-CONNECT:/run/elf_monitor/metrics.sock" ikisi de çalışır.
+
+#define METRICS_SOCKET "/run/elf_monitor/metrics.sock"
+
+// Sayaçlar
+#define M_DIRECTORIES   0       // Okunan dizin
+#define M_FILES         1       // İncelenen düzenli dosya
+#define M_STATS         2       // stat/fstatat çağrısı
+#define M_OPENS         3       // İçeriği okumak için açılan dosya
+#define M_UNCHANGED     4       // Önbellek sayesinde açılmayan dosya
+#define M_ELF_FOUND     5
+#define M_ELF_CHANGED   6
+#define M_ELF_GONE      7
+#define M_ELF_COPIES    8
+#define M_BYTES_READ    9       // read/pread ile okunan ya da eşlemden özetlenen
+#define M_BYTES_MAPPED  10      // Derin analizde eşlenen
+#define M_EVENTS        11      // Olay kaynağından gelen değişiklik
+#define M_PASSES        12      // Tamamlanan tam tarama
+#define M_THROTTLE_NS   13      // Hız sınırı / IO baskısı nedeniyle beklenen süre (ns)
+#define M_FILTERED      14      // Yol süzgecinin budadığı ad ya da dosya sistemi
+#define M_COUNTERS      15
+
+// Histogramlar
+#define H_PASS          0       // Tam tarama süresi
+#define H_FILE          1       // Açılan dosya başına analiz süresi
+#define M_HISTOGRAMS    2
+
+// Göstergeler (son değer geçerli)
+#define G_CACHE_ENTRIES 0       // Durum önbelleğindeki dosya
+#define G_HASH_INDEX    1       // Kopya dizinindeki farklı içerik
+#define G_LAST_PASS     2       // Son tam taramanın bittiği an (Unix saniye)
+#define G_IO_PRESSURE   3       // /proc/pressure/io some avg10 * 100
+#define M_GAUGES        4
+
+void metrics_add(int counter, uint64_t n);
+void metrics_set(int gauge, uint64_t value);
+
+// Süreyi (nanosaniye) histograma ekle
+void metrics_observe(int histogram, uint64_t ns);
+
+// CLOCK_MONOTONIC, nanosaniye
+uint64_t metrics_now(void);
+
+// Soketi aç ve sunucu iş parçacığını başlat (0 başarı, -1 hata)
+int metrics_start(const char *path);
+void metrics_stop(void);
+
+// Anlık görüntüyü Prometheus metin biçiminde yaz; yazılan byte sayısı
+int metrics_render(char *out, int size);
+
+#endif
@@ -0,0 +1,679 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fnmatch.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <syslog.h>
+#include <sys/sysmacros.h>
+#include "path_filter.h"
+#include "watch.h"
+
+#define DEAD 0                      // Budanan yolların emici durumu
+
+// Trie düğüm bayrakları
+#define N_INCLUDE_END  0x01         // Bir include deseni burada biter
+#define N_EXCLUDE_END  0x02
+#define N_INCLUDE_PATH 0x04         // Bir include deseni buradan sürer
+#define N_EXCLUDE_PATH 0x08
+#define N_DOUBLESTAR   0x10         // ** düğümü: her bileşende yerinde kalır
+
+typedef struct {
+    char *name;                     // Sabit ad ya da fnmatch deseni
+    uint32_t target;
+    int wildcard;
+} edge_t;
+
+typedef struct {
+    edge_t *edges;
+    uint32_t count, capacity;
+    uint32_t doublestar;            // ** çocuğu; 0: yok (kök kimsenin çocuğu değil)
+    uint8_t flags;
+} trie_node_t;
+
+// Derlenmiş DFA durumu. Sabit adlar sıralı tablodan ikili aramayla
+// bulunur; tabloda olmayan ad için hangi jokerlerin uyduğu bir maske
+// oluşturur ve sonraki durum mask_next[mask_first + maske]'dir.
+typedef struct {
+    uint8_t verdict;
+    uint8_t wildcards;              // Farklı joker bileşen sayısı
+    uint32_t literal_count;
+    uint32_t literal_first;         // literal_names / literal_next
+    uint32_t wildcard_first;        // wildcard_patterns
+    uint32_t mask_first;            // mask_next (1 << wildcards girdi)
+} dfa_state_t;
+
+// Derleme sırasında DFA durumunun karşılığı olan trie düğümü kümesi
+typedef struct {
+    uint32_t *nodes;                // Sıralı
+    uint32_t size;
+    int all;                        // Bir include'a varıldı: exclude yoksa her şey dahil
+    uint64_t hash;
+} state_set_t;
+
+typedef struct {
+    uint32_t *items;
+    uint32_t count, capacity;
+} id_list_t;
+
+static int active = 0;
+static uint32_t rule_count = 0;
+static filter_state_t root_state = DEAD;
+
+static trie_node_t *nodes = NULL;
+static uint32_t node_count = 0, node_capacity = 0;
+
+static dfa_state_t *states = NULL;
+static uint32_t state_count = 0, state_capacity = 0;
+static const char **literal_names = NULL;
+static uint32_t *literal_next = NULL;
+static uint32_t literal_count = 0, literal_capacity = 0, literal_next_capacity = 0;
+static const char **wildcard_patterns = NULL;
+static uint32_t wildcard_count = 0, wildcard_capacity = 0;
+static uint32_t *mask_next = NULL;
+static uint32_t mask_count = 0, mask_capacity = 0;
+
+// Yalnızca derlemede
+static state_set_t *sets = NULL;
+static uint32_t set_capacity = 0;
+static uint32_t *intern_table = NULL;   // Durum numarası + 1; 0: boş
+static uint32_t intern_capacity = 0;
+
+static char **fs_types = NULL;
+static uint32_t fs_type_count = 0, fs_type_capacity = 0;
+static int fs_pseudo = 0;           // "exclude-fs pseudo": watch_pseudo_fs türleri
+static dev_t *excluded_devs = NULL;
+static uint32_t excluded_count = 0, excluded_capacity = 0;
+
+// Diziyi en az need elemanlık yap
+static int reserve(void *array, uint32_t *capacity, uint32_t need, size_t item) {
+    void **items = array;
+
+    if (need <= *capacity) return 0;
+    uint32_t size = *capacity ? *capacity : 16;
+    while (size < need) size *= 2;
+    void *grown = realloc(*items, (size_t) size * item);
+    if (!grown) return -1;
+    *items = grown;
+    *capacity = size;
+    return 0;
+}
+
+static int list_add(id_list_t *list, uint32_t id) {
+    for (uint32_t i = 0; i < list->count; i++) {
+        if (list->items[i] == id) return 0;
+    }
+    if (reserve(&list->items, &list->capacity, list->count + 1, sizeof(uint32_t)) != 0) return -1;
+    list->items[list->count++] = id;
+    return 0;
+}
+
+/* ================ TRIE ================ */
+
+static int64_t node_new(uint8_t flags) {
+    if (reserve(&nodes, &node_capacity, node_count + 1, sizeof(trie_node_t)) != 0) return -1;
+    memset(&nodes[node_count], 0, sizeof(trie_node_t));
+    nodes[node_count].flags = flags;
+    return node_count++;
+}
+
+// Düğümün aynı bileşen için çocuğu; yoksa oluşturulur
+static int64_t node_child(uint32_t parent, const char *name, int wildcard) {
+    trie_node_t *n = &nodes[parent];
+
+    for (uint32_t i = 0; i < n->count; i++) {
+        if (n->edges[i].wildcard == wildcard && strcmp(n->edges[i].name, name) == 0) return n->edges[i].target;
+    }
+    int64_t child = node_new(0);
+    char *copy = strdup(name);
+    n = &nodes[parent];
+    if (child < 0 || !copy || reserve(&n->edges, &n->capacity, n->count + 1, sizeof(edge_t)) != 0) {
+        free(copy);
+        return -1;
+    }
+    n->edges[n->count++] = (edge_t) { copy, (uint32_t) child, wildcard };
+    return child;
+}
+
+// Deseni trie'ye ekle; '/' ile başlamayan desen her derinlikte uyar
+static int add_pattern(int exclude, const char *pattern, const char **error) {
+    char buffer[PATH_MAX];
+    char *save = NULL;
+    uint32_t current = 0;
+    uint8_t path_flag = exclude ? N_EXCLUDE_PATH : N_INCLUDE_PATH;
+
+    if (snprintf(buffer, sizeof(buffer), "%s%s", pattern[0] == '/' ? "" : "**/", pattern) >= (int) sizeof(buffer)) {
+        *error = "desen çok uzun";
+        return -1;
+    }
+    for (char *part = strtok_r(buffer, "/", &save); part; part = strtok_r(NULL, "/", &save)) {
+        if (strcmp(part, ".") == 0) continue;
+        if (strcmp(part, "..") == 0) {
+            *error = "desende '..' olamaz";
+            return -1;
+        }
+        nodes[current].flags |= path_flag;
+
+        int64_t next;
+        if (strcmp(part, "**") == 0) {
+            next = nodes[current].doublestar;
+            if (!next) {
+                next = node_new(N_DOUBLESTAR);
+                if (next >= 0) nodes[current].doublestar = (uint32_t) next;
+            }
+        } else {
+            next = node_child(current, part, strpbrk(part, "*?[\\") != NULL);
+        }
+        if (next < 0) {
+            *error = "bellek yetmedi";
+            return -1;
+        }
+        current = (uint32_t) next;
+    }
+    nodes[current].flags |= exclude ? N_EXCLUDE_END : N_INCLUDE_END;
+    return 0;
+}
+
+/* ================ DFA ================ */
+
+static int compare_ids(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *) a, y = *(const uint32_t *) b;
+    return x < y ? -1 : x > y;
+}
+
+static int compare_names(const void *a, const void *b) {
+    return strcmp(*(const char *const *) a, *(const char *const *) b);
+}
+
+static uint64_t set_hash(const uint32_t *items, uint32_t count, int all) {
+    uint64_t h = 0xcbf29ce484222325ULL ^ (uint64_t) all;
+
+    for (uint32_t i = 0; i < count; i++) h = (h ^ items[i]) * 0x100000001b3ULL;
+    return h;
+}
+
+static int intern_grow(void) {
+    uint32_t size = intern_capacity ? intern_capacity * 2 : 256;
+    uint32_t *table = calloc(size, sizeof(uint32_t));
+    if (!table) return -1;
+
+    for (uint32_t id = 1; id < state_count; id++) {
+        uint32_t i = (uint32_t) sets[id].hash & (size - 1);
+        while (table[i]) i = (i + 1) & (size - 1);
+        table[i] = id + 1;
+    }
+    free(intern_table);
+    intern_table = table;
+    intern_capacity = size;
+    return 0;
+}
+
+// Kümeyi ** çocuklarıyla kapat, hükmünü belirle ve DFA durumuna çevir
+// (aynı küme aynı durum). Budanan her küme DEAD'dir.
+static int64_t intern(id_list_t *set, int all) {
+    for (uint32_t i = 0; i < set->count; i++) {
+        uint32_t ds = nodes[set->items[i]].doublestar;
+        if (ds && list_add(set, ds) != 0) return -1;
+    }
+
+    int include_path = 0;
+    for (uint32_t i = 0; i < set->count; i++) {
+        if (nodes[set->items[i]].flags & N_EXCLUDE_END) return DEAD;
+        if (nodes[set->items[i]].flags & N_INCLUDE_END) all = 1;
+    }
+    // Hükmü artık etkilemeyen düğümler atılır: include'a varıldıysa
+    // yalnızca sürebilecek exclude'lar önemlidir
+    uint8_t keep = all ? N_EXCLUDE_PATH : (N_INCLUDE_PATH | N_EXCLUDE_PATH);
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < set->count; i++) {
+        uint8_t flags = nodes[set->items[i]].flags;
+        if (!(flags & keep)) continue;
+        include_path |= flags & N_INCLUDE_PATH;
+        set->items[count++] = set->items[i];
+    }
+    set->count = count;
+    if (!all && !include_path) return DEAD;
+
+    if (set->count) qsort(set->items, set->count, sizeof(uint32_t), compare_ids);
+    uint64_t hash = set_hash(set->items, set->count, all);
+    if ((state_count + 1) * 2 > intern_capacity && intern_grow() != 0) return -1;
+
+    uint32_t i = (uint32_t) hash & (intern_capacity - 1);
+    for (; intern_table[i]; i = (i + 1) & (intern_capacity - 1)) {
+        const state_set_t *s = &sets[intern_table[i] - 1];
+        if (s->hash == hash && s->all == all && s->size == set->count &&
+            (!set->count || memcmp(s->nodes, set->items, set->count * sizeof(uint32_t)) == 0)) {
+            return intern_table[i] - 1;
+        }
+    }
+
+    if (state_count == FILTER_MAX_STATES ||
+        reserve(&states, &state_capacity, state_count + 1, sizeof(dfa_state_t)) != 0 ||
+        reserve(&sets, &set_capacity, state_count + 1, sizeof(state_set_t)) != 0) {
+        return -1;
+    }
+    uint32_t id = state_count;
+    uint32_t *members = malloc((set->count ? set->count : 1) * sizeof(uint32_t));
+    if (!members) return -1;
+    if (set->count) memcpy(members, set->items, set->count * sizeof(uint32_t));
+    sets[id] = (state_set_t) { members, set->count, all, hash };
+    memset(&states[id], 0, sizeof(dfa_state_t));
+    states[id].verdict = all ? FILTER_SCAN : FILTER_DESCEND;
+    intern_table[i] = id + 1;
+    state_count++;
+    return id;
+}
+
+static int64_t wildcard_index(uint32_t first, const char *pattern) {
+    for (uint32_t i = first; i < wildcard_count; i++) {
+        if (strcmp(wildcard_patterns[i], pattern) == 0) return i - first;
+    }
+    return -1;
+}
+
+// Durumun geçiş tablolarını kur; hedef durumlar gerekirse oluşturulur
+// ve sırası gelince onlar da kurulur
+static int build_state(uint32_t id, const char **error) {
+    const uint32_t *members = sets[id].nodes;
+    uint32_t size = sets[id].size;
+    int all = sets[id].all;
+    uint32_t literal_first = literal_count, wildcard_first = wildcard_count;
+    id_list_t next = { NULL, 0, 0 };
+
+    // Kümedeki farklı sabit adlar (sıralı) ve jokerler
+    for (uint32_t m = 0; m < size; m++) {
+        const trie_node_t *n = &nodes[members[m]];
+        for (uint32_t e = 0; e < n->count; e++) {
+            const char *name = n->edges[e].name;
+            if (n->edges[e].wildcard) {
+                if (wildcard_index(wildcard_first, name) >= 0) continue;
+                if (reserve(&wildcard_patterns, &wildcard_capacity, wildcard_count + 1, sizeof(char *)) != 0) goto nomem;
+                wildcard_patterns[wildcard_count++] = name;
+            } else {
+                uint32_t i = literal_first;
+                while (i < literal_count && strcmp(literal_names[i], name) != 0) i++;
+                if (i < literal_count) continue;
+                if (reserve(&literal_names, &literal_capacity, literal_count + 1, sizeof(char *)) != 0) goto nomem;
+                literal_names[literal_count++] = name;
+            }
+        }
+    }
+    uint32_t wildcards = wildcard_count - wildcard_first;
+    if (wildcards > FILTER_MAX_WILDCARDS) {
+        *error = "aynı dizinde uyabilecek joker bileşen sayısı FILTER_MAX_WILDCARDS'ı aşıyor";
+        return -1;
+    }
+    if (literal_count > literal_first) {
+        qsort(literal_names + literal_first, literal_count - literal_first, sizeof(char *), compare_names);
+    }
+    if (reserve(&literal_next, &literal_next_capacity, literal_count, sizeof(uint32_t)) != 0 ||
+        reserve(&mask_next, &mask_capacity, mask_count + (1u << wildcards), sizeof(uint32_t)) != 0) {
+        goto nomem;
+    }
+
+    // Sabit ad: hem aynı adlı kenarlar hem ona uyan jokerler
+    for (uint32_t i = literal_first; i < literal_count; i++) {
+        next.count = 0;
+        for (uint32_t m = 0; m < size; m++) {
+            const trie_node_t *n = &nodes[members[m]];
+            if ((n->flags & N_DOUBLESTAR) && list_add(&next, members[m]) != 0) goto nomem;
+            for (uint32_t e = 0; e < n->count; e++) {
+                const edge_t *edge = &n->edges[e];
+                int match = edge->wildcard ? fnmatch(edge->name, literal_names[i], 0) == 0
+                                           : strcmp(edge->name, literal_names[i]) == 0;
+                if (match && list_add(&next, edge->target) != 0) goto nomem;
+            }
+        }
+        int64_t target = intern(&next, all);
+        if (target < 0) goto nomem;
+        literal_next[i] = (uint32_t) target;
+    }
+
+    // Tabloda olmayan ad: uyan jokerlerin her birleşimi için
+    uint32_t mask_first = mask_count;
+    for (uint32_t mask = 0; mask < (1u << wildcards); mask++) {
+        next.count = 0;
+        for (uint32_t m = 0; m < size; m++) {
+            const trie_node_t *n = &nodes[members[m]];
+            if ((n->flags & N_DOUBLESTAR) && list_add(&next, members[m]) != 0) goto nomem;
+            for (uint32_t e = 0; e < n->count; e++) {
+                const edge_t *edge = &n->edges[e];
+                if (edge->wildcard && (mask & (1u << wildcard_index(wildcard_first, edge->name))) &&
+                    list_add(&next, edge->target) != 0) {
+                    goto nomem;
+                }
+            }
+        }
+        int64_t target = intern(&next, all);
+        if (target < 0) goto nomem;
+        mask_next[mask_count++] = (uint32_t) target;
+    }
+    free(next.items);
+
+    dfa_state_t *s = &states[id];
+    s->wildcards = (uint8_t) wildcards;
+    s->literal_count = literal_count - literal_first;
+    s->literal_first = literal_first;
+    s->wildcard_first = wildcard_first;
+    s->mask_first = mask_first;
+    return 0;
+
+nomem:
+    free(next.items);
+    *error = state_count == FILTER_MAX_STATES ? "DFA FILTER_MAX_STATES durumu aşıyor" : "bellek yetmedi";
+    return -1;
+}
+
+static int compile(const char **error) {
+    id_list_t start = { NULL, 0, 0 };
+
+    // DEAD: geçişleri kendine dönen boş durum
+    if (reserve(&states, &state_capacity, 1, sizeof(dfa_state_t)) != 0 ||
+        reserve(&sets, &set_capacity, 1, sizeof(state_set_t)) != 0 ||
+        reserve(&mask_next, &mask_capacity, 1, sizeof(uint32_t)) != 0 ||
+        list_add(&start, 0) != 0) {
+        free(start.items);
+        *error = "bellek yetmedi";
+        return -1;
+    }
+    memset(&states[0], 0, sizeof(dfa_state_t));
+    memset(&sets[0], 0, sizeof(state_set_t));
+    states[0].verdict = FILTER_PRUNE;
+    mask_next[mask_count++] = DEAD;
+    state_count = 1;
+
+    int64_t root = intern(&start, 0);
+    free(start.items);
+    if (root < 0) {
+        *error = "bellek yetmedi";
+        return -1;
+    }
+    root_state = (filter_state_t) root;
+
+    for (uint32_t id = 1; id < state_count; id++) {
+        if (build_state(id, error) != 0) return -1;
+    }
+    return 0;
+}
+
+// Derleme artığı kümeler çalışırken gerekmez
+static void drop_sets(void) {
+    for (uint32_t i = 0; i < state_count && sets; i++) free(sets[i].nodes);
+    free(sets);
+    free(intern_table);
+    sets = NULL;
+    intern_table = NULL;
+    set_capacity = intern_capacity = 0;
+}
+
+/* ================ YAPILANDIRMA ================ */
+
+static int add_fs_type(const char *type) {
+    if (strcmp(type, "pseudo") == 0) {
+        fs_pseudo = 1;
+        return 0;
+    }
+    char *copy = strdup(type);
+    if (!copy || reserve(&fs_types, &fs_type_capacity, fs_type_count + 1, sizeof(char *)) != 0) {
+        free(copy);
+        return -1;
+    }
+    fs_types[fs_type_count++] = copy;
+    return 0;
+}
+
+static int fs_type_excluded(const char *type) {
+    if (fs_pseudo && watch_pseudo_fs(type)) return 1;
+    for (uint32_t i = 0; i < fs_type_count; i++) {
+        if (strcmp(fs_types[i], type) == 0) return 1;
+    }
+    return 0;
+}
+
+// Bir satırı işle: 0 başarı, -1 hata (*error doldurulur)
+static int parse_line(char *line, int *includes, const char **error) {
+    char *save = NULL;
+
+    line[strcspn(line, "\r\n")] = '\0';
+    char *key = line + strspn(line, " \t");
+    if (*key == '\0' || *key == '#') return 0;
+
+    char *value = key + strcspn(key, " \t");
+    if (*value) *value++ = '\0';
+    value += strspn(value, " \t");
+    // Satır sonu yorumu: boşluktan sonra gelen '#'
+    for (char *p = value; *p; p++) {
+        if (*p == '#' && p > value && (p[-1] == ' ' || p[-1] == '\t')) {
+            *p = '\0';
+            break;
+        }
+    }
+    size_t length = strlen(value);
+    while (length > 0 && (value[length - 1] == ' ' || value[length - 1] == '\t')) value[--length] = '\0';
+
+    if (strcmp(key, "include") == 0 || strcmp(key, "exclude") == 0) {
+        if (!*value) {
+            *error = "desen eksik";
+            return -1;
+        }
+        int exclude = key[0] == 'e';
+        if (add_pattern(exclude, value, error) != 0) return -1;
+        if (!exclude) (*includes)++;
+    } else if (strcmp(key, "exclude-fs") == 0) {
+        if (!*value) {
+            *error = "dosya sistemi türü eksik";
+            return -1;
+        }
+        for (char *type = strtok_r(value, " \t", &save); type; type = strtok_r(NULL, " \t", &save)) {
+            if (add_fs_type(type) != 0) {
+                *error = "bellek yetmedi";
+                return -1;
+            }
+        }
+    } else {
+        *error = "bilinmeyen anahtar (include, exclude, exclude-fs)";
+        return -1;
+    }
+    rule_count++;
+    return 0;
+}
+
+int path_filter_load(const char *file) {
+    const char *error = NULL;
+    char *line = NULL;
+    size_t capacity = 0;
+    int number = 0, failed = 0, includes = 0, result = 0;
+
+    path_filter_free();
+    FILE *in = fopen(file, "r");
+    if (!in && errno != ENOENT) {
+        syslog(LOG_ERR, "%s okunamadı: %s", file, strerror(errno));
+        return -1;
+    }
+    if (node_new(0) < 0) {
+        if (in) fclose(in);
+        return -1;
+    }
+
+    if (in) {
+        while (getline(&line, &capacity, in) > 0) {
+            number++;
+            if (parse_line(line, &includes, &error) != 0) {
+                failed = number;
+                break;
+            }
+        }
+        free(line);
+        fclose(in);
+    } else {
+        // Dosya yoksa yalnızca sanal dosya sistemleri atlanır
+        fs_pseudo = 1;
+        result = 1;
+    }
+
+    // Hiç include yoksa kökün kendisi dahil
+    if (!error && !includes) nodes[0].flags |= N_INCLUDE_END;
+    if (!error && compile(&error) == 0) {
+        drop_sets();
+        active = 1;
+        return result;
+    }
+    if (failed) {
+        syslog(LOG_ERR, "%s:%d: %s", file, failed, error);
+    } else {
+        syslog(LOG_ERR, "%s: %s", file, error);
+    }
+    path_filter_free();
+    return -1;
+}
+
+void path_filter_free(void) {
+    drop_sets();
+    for (uint32_t i = 0; i < node_count; i++) {
+        for (uint32_t e = 0; e < nodes[i].count; e++) free(nodes[i].edges[e].name);
+        free(nodes[i].edges);
+    }
+    for (uint32_t i = 0; i < fs_type_count; i++) free(fs_types[i]);
+    free(nodes);
+    free(states);
+    free(literal_names);
+    free(literal_next);
+    free(wildcard_patterns);
+    free(mask_next);
+    free(fs_types);
+    free(excluded_devs);
+    nodes = NULL;
+    states = NULL;
+    literal_names = NULL;
+    literal_next = NULL;
+    wildcard_patterns = NULL;
+    mask_next = NULL;
+    fs_types = NULL;
+    excluded_devs = NULL;
+    node_count = node_capacity = state_count = state_capacity = 0;
+    literal_count = literal_capacity = literal_next_capacity = 0;
+    wildcard_count = wildcard_capacity = mask_count = mask_capacity = 0;
+    fs_type_count = fs_type_capacity = excluded_count = excluded_capacity = 0;
+    fs_pseudo = 0;
+    rule_count = 0;
+    root_state = DEAD;
+    active = 0;
+}
+
+/* ================ EŞLEME ================ */
+
+int path_filter_active(void) {
+    return active;
+}
+
+filter_state_t path_filter_step(filter_state_t state, const char *name) {
+    const dfa_state_t *s = &states[state];
+    const char *const *names = literal_names + s->literal_first;
+    uint32_t low = 0, high = s->literal_count;
+
+    while (low < high) {
+        uint32_t middle = (low + high) / 2;
+        int c = strcmp(name, names[middle]);
+        if (c == 0) return literal_next[s->literal_first + middle];
+        if (c < 0) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+
+    unsigned mask = 0;
+    for (uint32_t i = 0; i < s->wildcards; i++) {
+        if (fnmatch(wildcard_patterns[s->wildcard_first + i], name, 0) == 0) mask |= 1u << i;
+    }
+    return mask_next[s->mask_first + mask];
+}
+
+filter_state_t path_filter_start(const char *path) {
+    char component[NAME_MAX + 1];
+    filter_state_t state = root_state;
+
+    while (*path && state != DEAD) {
+        path += strspn(path, "/");
+        size_t length = strcspn(path, "/");
+        if (length == 0) break;
+        if (length > NAME_MAX) return DEAD;
+        memcpy(component, path, length);
+        component[length] = '\0';
+        path += length;
+        if (strcmp(component, ".") != 0) state = path_filter_step(state, component);
+    }
+    return state;
+}
+
+int path_filter_verdict(filter_state_t state) {
+    return states[state].verdict;
+}
+
+int path_filter_literals(filter_state_t state, const char *const **names) {
+    const dfa_state_t *s = &states[state];
+
+    if (s->verdict != FILTER_DESCEND || s->wildcards || mask_next[s->mask_first] != DEAD) return -1;
+    *names = literal_names + s->literal_first;
+    return (int) s->literal_count;
+}
+
+/* ================ DOSYA SİSTEMLERİ ================ */
+
+static int compare_devs(const void *a, const void *b) {
+    dev_t x = *(const dev_t *) a, y = *(const dev_t *) b;
+    return x < y ? -1 : x > y;
+}
+
+int path_filter_refresh_mounts(void) {
+    char *line = NULL;
+    size_t capacity = 0;
+
+    excluded_count = 0;
+    if (!fs_pseudo && !fs_type_count) return 0;
+
+    FILE *in = fopen("/proc/self/mountinfo", "r");
+    if (!in) return -1;
+
+    // "36 35 98:0 /kök /bağlama rw,... [isteğe bağlı alanlar] - tür kaynak seçenekler"
+    while (getline(&line, &capacity, in) > 0) {
+        unsigned major, minor;
+        char type[64];
+        if (sscanf(line, "%*u %*u %u:%u", &major, &minor) != 2) continue;
+        const char *separator = strstr(line, " - ");
+        if (!separator || sscanf(separator + 3, "%63s", type) != 1 || !fs_type_excluded(type)) continue;
+
+        dev_t dev = makedev(major, minor);
+        if (path_filter_excluded_dev(dev)) continue;
+        if (reserve(&excluded_devs, &excluded_capacity, excluded_count + 1, sizeof(dev_t)) != 0) break;
+        excluded_devs[excluded_count++] = dev;
+        qsort(excluded_devs, excluded_count, sizeof(dev_t), compare_devs);
+    }
+    free(line);
+    fclose(in);
+    return (int) excluded_count;
+}
+
+int path_filter_excluded_dev(dev_t dev) {
+    uint32_t low = 0, high = excluded_count;
+
+    while (low < high) {
+        uint32_t middle = (low + high) / 2;
+        if (excluded_devs[middle] == dev) return 1;
+        if (excluded_devs[middle] < dev) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return 0;
+}
+
+uint32_t path_filter_rules(void) {
+    return rule_count;
+}
+
+uint32_t path_filter_states(void) {
+    return state_count;
+}
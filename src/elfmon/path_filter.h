@@ -0,0 +1,68 @@
+#ifndef ELFMON_PATH_FILTER_H
+#define ELFMON_PATH_FILTER_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+// Taranacak yolları seçen include/exclude kuralları. Yapılandırma dosyası
+// satır satır okunur:
+//
+//   include /usr              # yol ve altı taranır
+//   include /opt/**/*.so      # ** sıfır ya da daha fazla bileşen
+//   exclude **/.git           # '/' ile başlamayan desen her derinlikte
+//   exclude-fs pseudo nfs     # dosya sistemi türü; pseudo: sanal türler
+//
+// Bir desen bir dizine uyarsa hükmü tüm alt ağaca geçer; exclude her
+// zaman include'u ezer. Hiç include yoksa "include /" varsayılır.
+// Bileşen desenleri fnmatch sözdizimindedir (*, ?, [..]).
+//
+// Desenler açılışta bileşen trie'sine, oradan alt küme kuruluşuyla bir
+// DFA'ya derlenir: her dizin ve dosya adı için durum tek adımda ilerler
+// (sabit adlar ikili arama, jokerler için en fazla FILTER_MAX_WILDCARDS
+// fnmatch) ve budanan dizinin altı hiç okunmaz. Yalnızca sabit adlı
+// çocuklara ilerleyebilen durumlarda dizin okunmadan o adlara gidilir.
+
+#define PATH_FILTER_FILE     "/etc/elf_monitor.conf"
+#define FILTER_MAX_WILDCARDS 8          // DFA durumu başına farklı joker bileşen
+#define FILTER_MAX_STATES    65536
+
+// path_filter_verdict sonucu
+#define FILTER_PRUNE   0    // Yol ve altı taranmaz
+#define FILTER_DESCEND 1    // Yolun kendisi dahil değil, altında dahil olan olabilir
+#define FILTER_SCAN    2    // Dahil
+
+typedef uint32_t filter_state_t;
+
+// Kuralları oku ve derle: 0 başarı, 1 dosya yok (varsayılan kurallar:
+// "exclude-fs pseudo"), -1 sözdizimi ya da derleme hatası (loglanır)
+int path_filter_load(const char *file);
+void path_filter_free(void);
+
+// Kurallar yüklü mü?
+int path_filter_active(void);
+
+// Mutlak yolun durumu (bileşen bileşen ilerleyerek)
+filter_state_t path_filter_start(const char *path);
+
+// Durumdan bir bileşen (dizin ya da dosya adı) ilerle
+filter_state_t path_filter_step(filter_state_t state, const char *name);
+
+int path_filter_verdict(filter_state_t state);
+
+// Durum yalnızca sabit adlara ilerleyebiliyorsa ad sayısını döndürür ve
+// *names'i doldurur (dizini okumak gerekmez); aksi halde -1
+int path_filter_literals(filter_state_t state, const char *const **names);
+
+// Bağlı dosya sistemlerini /proc/self/mountinfo'dan yeniden oku ve
+// türü hariç tutulanların aygıtlarını hatırla; hariç aygıt sayısını
+// döndürür. Gezinti sürmüyorken çağrılmalıdır.
+int path_filter_refresh_mounts(void);
+
+// Aygıt hariç tutulan bir dosya sistemine mi ait?
+int path_filter_excluded_dev(dev_t dev);
+
+// Derlenen kural ve DFA durumu sayısı (loglamak için)
+uint32_t path_filter_rules(void);
+uint32_t path_filter_states(void);
+
+#endif
@@ -0,0 +1,327 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "stat_cache.h"
+
+#define CACHE_MAGIC    0x43464C45   // "ELFC"
+#define CACHE_VERSION  2
+#define SHARDS         64           // Bağımsız kilitli alt tablo
+#define INITIAL_SLOTS  256          // Parça başına ilk yuva (2'nin kuvveti)
+
+// Kayıt diske olduğu gibi yazılır; alanlar sabit genişlikte
+typedef struct {
+    uint64_t dev;
+    uint64_t ino;
+    int64_t  size;
+    int64_t  mtime;         // Nanosaniye
+    int64_t  ctime;
+    uint32_t generation;    // En son görüldüğü tarama
+    uint8_t  result;
+    uint8_t  used;
+    uint8_t  reserved[2];
+    uint64_t hash;          // İçerik XXH3'ü (0: hesaplanmadı)
+} stat_entry_t;
+
+// Sürüm 1 kaydı: özet alanı yok, yüklenirken 0 kabul edilir
+typedef struct {
+    uint64_t dev;
+    uint64_t ino;
+    int64_t  size;
+    int64_t  mtime;
+    int64_t  ctime;
+    uint32_t generation;
+    uint8_t  result;
+    uint8_t  used;
+    uint8_t  reserved[2];
+} stat_entry_v1_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_size;
+    uint32_t count;
+} cache_header_t;
+
+// Gezgin iş parçacıkları aynı anda arar/ekler: tablo, anahtarın üst
+// bitlerine göre kendi kilidi olan parçalara bölünür
+typedef struct {
+    pthread_mutex_t lock;
+    stat_entry_t *slots;
+    uint32_t capacity;              // Yuva sayısı (2'nin kuvveti)
+    uint32_t count;
+} shard_t;
+
+static shard_t shards[SHARDS];
+static uint32_t generation = 1;
+
+static inline int64_t to_ns(const struct timespec *ts) {
+    return (int64_t) ts->tv_sec * 1000000000 + ts->tv_nsec;
+}
+
+static inline uint64_t hash_key(uint64_t dev, uint64_t ino) {
+    uint64_t h = (ino ^ (dev * 0x9E3779B97F4A7C15ULL)) * 0xBF58476D1CE4E5B9ULL;
+    return h ^ (h >> 31);
+}
+
+static inline shard_t *shard_of(uint64_t dev, uint64_t ino) {
+    return &shards[(hash_key(dev, ino) >> 58) % SHARDS];
+}
+
+// Anahtarın yuvası ya da eklenecek boş yuva (doğrusal yoklama)
+static stat_entry_t *find_slot(stat_entry_t *table, uint32_t size, uint64_t dev, uint64_t ino) {
+    uint32_t mask = size - 1;
+    uint32_t i = (uint32_t) hash_key(dev, ino) & mask;
+
+    while (table[i].used && (table[i].dev != dev || table[i].ino != ino)) {
+        i = (i + 1) & mask;
+    }
+    return &table[i];
+}
+
+// Parçayı yeni boyuta taşı; keep_all == 0 ise bu taramada görülmeyenler
+// atılır. Kilit çağıranda.
+static int rehash(shard_t *shard, uint32_t size, int keep_all) {
+    stat_entry_t *table = calloc(size, sizeof(stat_entry_t));
+    if (!table) return -1;
+
+    shard->count = 0;
+    for (uint32_t i = 0; i < shard->capacity; i++) {
+        stat_entry_t *e = &shard->slots[i];
+        if (!e->used) continue;
+        if (!keep_all && e->generation != generation) continue;
+        *find_slot(table, size, e->dev, e->ino) = *e;
+        shard->count++;
+    }
+    free(shard->slots);
+    shard->slots = table;
+    shard->capacity = size;
+    return 0;
+}
+
+// Kaydı ekle ya da güncelle; doluluk %50'yi geçmeden parça büyütülür,
+// büyütülemezse kayıt atlanır (dosya sonra yeniden incelenir). Kilit
+// çağıranda.
+static stat_entry_t *insert(shard_t *shard, uint64_t dev, uint64_t ino) {
+    if ((shard->count + 1) * 2 > shard->capacity && rehash(shard, shard->capacity * 2, 1) != 0) {
+        return NULL;
+    }
+    stat_entry_t *e = find_slot(shard->slots, shard->capacity, dev, ino);
+    if (!e->used) shard->count++;
+    return e;
+}
+
+int stat_cache_init(void) {
+    stat_cache_free();
+    for (int i = 0; i < SHARDS; i++) {
+        shards[i].slots = calloc(INITIAL_SLOTS, sizeof(stat_entry_t));
+        if (!shards[i].slots) {
+            stat_cache_free();
+            return -1;
+        }
+        shards[i].capacity = INITIAL_SLOTS;
+        pthread_mutex_init(&shards[i].lock, NULL);
+    }
+    return 0;
+}
+
+void stat_cache_free(void) {
+    for (int i = 0; i < SHARDS; i++) {
+        if (shards[i].capacity) pthread_mutex_destroy(&shards[i].lock);
+        free(shards[i].slots);
+        shards[i].slots = NULL;
+        shards[i].capacity = shards[i].count = 0;
+    }
+}
+
+int stat_cache_check(const struct stat *st, int *result, uint64_t *hash) {
+    shard_t *shard = shard_of(st->st_dev, st->st_ino);
+    int state = STAT_NEW;
+
+    pthread_mutex_lock(&shard->lock);
+    stat_entry_t *e = find_slot(shard->slots, shard->capacity, st->st_dev, st->st_ino);
+    if (e->used) {
+        e->generation = generation;
+        *result = e->result;
+        *hash = e->hash;
+        state = STAT_UNCHANGED;
+        if (e->size != (int64_t) st->st_size || e->mtime != to_ns(&st->st_mtim) ||
+            e->ctime != to_ns(&st->st_ctim)) {
+            state = STAT_CHANGED;
+        }
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return state;
+}
+
+void stat_cache_store(const struct stat *st, int result, uint64_t hash) {
+    shard_t *shard = shard_of(st->st_dev, st->st_ino);
+
+    pthread_mutex_lock(&shard->lock);
+    stat_entry_t *e = insert(shard, st->st_dev, st->st_ino);
+    if (e) {
+        e->dev = st->st_dev;
+        e->ino = st->st_ino;
+        e->size = st->st_size;
+        e->mtime = to_ns(&st->st_mtim);
+        e->ctime = to_ns(&st->st_ctim);
+        e->generation = generation;
+        e->result = (uint8_t) result;
+        e->used = 1;
+        e->hash = hash;
+    }
+    pthread_mutex_unlock(&shard->lock);
+}
+
+// Tarama sınırları gezinti dışında (tek iş parçacığından) çağrılır
+void stat_cache_begin_pass(void) {
+    generation++;
+}
+
+uint32_t stat_cache_end_pass(void) {
+    uint32_t removed = 0;
+
+    for (int i = 0; i < SHARDS; i++) {
+        shard_t *shard = &shards[i];
+        uint32_t before = shard->count;
+        uint32_t size = shard->capacity;
+
+        // Çok küçülen parça da küçültülür
+        pthread_mutex_lock(&shard->lock);
+        while (size > INITIAL_SLOTS && before * 8 < size) size /= 2;
+        if (rehash(shard, size, 0) == 0) removed += before - shard->count;
+        pthread_mutex_unlock(&shard->lock);
+    }
+    return removed;
+}
+
+uint32_t stat_cache_generation(void) {
+    return generation;
+}
+
+void stat_cache_for_each(stat_cache_fn fn, void *ctx) {
+    for (int i = 0; i < SHARDS; i++) {
+        shard_t *shard = &shards[i];
+        pthread_mutex_lock(&shard->lock);
+        for (uint32_t k = 0; k < shard->capacity; k++) {
+            const stat_entry_t *e = &shard->slots[k];
+            if (e->used && e->hash && e->generation == generation) fn(e->dev, e->ino, e->hash, ctx);
+        }
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+uint32_t stat_cache_count(void) {
+    uint32_t total = 0;
+
+    for (int i = 0; i < SHARDS; i++) {
+        pthread_mutex_lock(&shards[i].lock);
+        total += shards[i].count;
+        pthread_mutex_unlock(&shards[i].lock);
+    }
+    return total;
+}
+
+/* ================ KALICILIK ================ */
+
+// Daemon umask(0) ile çalışır: önbelleği değiştirebilen bir dosyayı
+// "değişmedi" gösterip izlemeden saklayabilir, bu yüzden dosya yalnızca
+// sahibine açıktır. Önceki çalışmadan kalan geçici dosyanın izinleri
+// devralınmasın diye önce silinir.
+static FILE *create_private(const char *path) {
+    unlink(path);
+    int fd = open(path, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+    if (fd < 0) return NULL;
+    FILE *file = fdopen(fd, "w");
+    if (!file) close(fd);
+    return file;
+}
+
+int stat_cache_save(const char *path) {
+    char tmp[PATH_MAX];
+    cache_header_t header = { CACHE_MAGIC, CACHE_VERSION, sizeof(stat_entry_t), stat_cache_count() };
+
+    if (snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= (int) sizeof(tmp)) return -1;
+
+    // Dizin yoksa bir kez oluşturmayı dene
+    FILE *file = create_private(tmp);
+    if (!file && errno == ENOENT) {
+        char dir[PATH_MAX];
+        snprintf(dir, sizeof(dir), "%s", path);
+        char *slash = strrchr(dir, '/');
+        if (slash && slash != dir) {
+            *slash = '\0';
+            mkdir(dir, 0755);
+            file = create_private(tmp);
+        }
+    }
+    if (!file) return -1;
+
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (int k = 0; k < SHARDS; k++) {
+        shard_t *shard = &shards[k];
+        pthread_mutex_lock(&shard->lock);
+        for (uint32_t i = 0; ok && i < shard->capacity; i++) {
+            if (shard->slots[i].used) ok = fwrite(&shard->slots[i], sizeof(stat_entry_t), 1, file) == 1;
+        }
+        pthread_mutex_unlock(&shard->lock);
+    }
+    if (fclose(file) != 0) ok = 0;
+
+    // Yarım yazılmış dosya eskisinin yerini almaz
+    if (!ok || rename(tmp, path) != 0) {
+        unlink(tmp);
+        return -1;
+    }
+    return 0;
+}
+
+int stat_cache_load(const char *path) {
+    cache_header_t header;
+    stat_entry_t entry;
+
+    FILE *file = fopen(path, "r");
+    if (!file) return -1;
+
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != CACHE_MAGIC) {
+        fclose(file);
+        return -1;
+    }
+    int v1 = header.version == 1 && header.entry_size == sizeof(stat_entry_v1_t);
+    if (!v1 && (header.version != CACHE_VERSION || header.entry_size != sizeof(stat_entry_t))) {
+        fclose(file);
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < header.count; i++) {
+        if (v1) {
+            // Eski önbellek korunur: dosyalar yeniden loglanmaz, özetleri
+            // bir sonraki değişiklikte hesaplanır
+            stat_entry_v1_t old;
+            if (fread(&old, sizeof(old), 1, file) != 1) break;
+            memset(&entry, 0, sizeof(entry));
+            memcpy(&entry, &old, sizeof(old));
+        } else if (fread(&entry, sizeof(entry), 1, file) != 1) {
+            break;
+        }
+        if (!entry.used) continue;
+
+        shard_t *shard = shard_of(entry.dev, entry.ino);
+        pthread_mutex_lock(&shard->lock);
+        stat_entry_t *e = insert(shard, entry.dev, entry.ino);
+        if (e) *e = entry;
+        pthread_mutex_unlock(&shard->lock);
+
+        // Kayıtların taraması korunur; yarıda kesilmiş tarama aynı
+        // nesilden sürdürülebilsin diye sayaç en yenisinden devam eder
+        if (entry.generation > generation) generation = entry.generation;
+    }
+    fclose(file);
+    return 0;
+}
@@ -0,0 +1,58 @@
+#ifndef ELFMON_STAT_CACHE_H
+#define ELFMON_STAT_CACHE_H
+
+#include <stdint.h>
+#include <sys/stat.h>
+
+// (st_dev, st_ino) anahtarlı dosya durumu önbelleği. Her dosya için son
+// görülen mtime/ctime/boyut, son sınıflandırma sonucu ve (istenirse)
+// içerik özeti tutulur; stat bilgisi değişmeyen dosya yeniden açılmaz.
+// Önbellek tam taramalar arasında bellekte kalır ve kapanışta diske
+// yazılır, böylece yeniden başlatılan daemon da yalnızca değişenleri
+// inceler.
+//
+// check/store birden fazla iş parçacığından aynı anda çağrılabilir.
+// Tam tarama stat_cache_begin_pass ile başlar; stat_cache_end_pass o
+// taramada hiç görülmeyen (silinmiş) dosyaları atar.
+
+#define STAT_CACHE_FILE "/var/lib/elf_monitor/stat.cache"
+
+// stat_cache_check sonucu
+#define STAT_NEW       0    // Önbellekte yok
+#define STAT_CHANGED   1    // Var ama mtime/ctime/boyut değişmiş
+#define STAT_UNCHANGED 2    // Değişmemiş; *result son sınıflandırma
+
+int stat_cache_init(void);
+void stat_cache_free(void);
+
+// Dosyayı önbellekte ara ve bu taramada görüldü olarak işaretle.
+// STAT_CHANGED / STAT_UNCHANGED durumunda *result önceki sonuç, *hash
+// önceki içerik özetidir (0: hesaplanmamış).
+int stat_cache_check(const struct stat *st, int *result, uint64_t *hash);
+
+// Yeni ya da değişmiş dosyanın inceleme sonucunu ve özetini kaydet
+void stat_cache_store(const struct stat *st, int result, uint64_t hash);
+
+void stat_cache_begin_pass(void);
+
+// Bu taramada görülmeyen kayıtları sil; silinen kayıt sayısını döndürür
+uint32_t stat_cache_end_pass(void);
+
+// Geçerli tarama nesli; stat_cache_load sonrası yüklenen en yeni kaydınki.
+// Kesilen bir taramanın kontrol noktası bununla eşleşiyorsa tarama
+// stat_cache_begin_pass çağrılmadan sürdürülür.
+uint32_t stat_cache_generation(void);
+
+// Geçerli nesilde görülmüş ve içerik özeti olan her kayıt için fn'yi
+// çağır (sürdürülen taramada kesintiden önce incelenen dosyalar)
+typedef void (*stat_cache_fn)(uint64_t dev, uint64_t ino, uint64_t hash, void *ctx);
+void stat_cache_for_each(stat_cache_fn fn, void *ctx);
+
+uint32_t stat_cache_count(void);
+
+// Diske kaydet / diskten yükle (0 başarı, -1 hata; bozuk ya da eski
+// sürüm dosya yok sayılır)
+int stat_cache_save(const char *path);
+int stat_cache_load(const char *path);
+
+#endif
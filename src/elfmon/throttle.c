@@ -0,0 +1,181 @@
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <syslog.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "throttle.h"
+#include "metrics.h"
+
+#define PSI_FILE        "/proc/pressure/io"
+#define PSI_INTERVAL    1000000000ULL   // PSI en fazla saniyede bir okunur (ns)
+#define PSI_MIN_FACTOR  0.1             // Baskı altında hızın düşebileceği en alt oran
+#define WAIT_SLICE      100000000ULL    // Uzun beklemeler running'e bakmak için dilimlenir (ns)
+
+// linux/ioprio.h her sistemde yok
+#define IOPRIO_CLASS_SHIFT  13
+#define IOPRIO_CLASS_IDLE   3
+#define IOPRIO_WHO_PROCESS  1
+
+// Borçlanan jeton kovası: çağıran jetonu hemen düşer, kova eksiye inerse
+// borç kapanana kadar (kilidin dışında) uyur. Birikim bir saniyelik hızla
+// sınırlıdır; uzun boşluktan sonra ani patlama olmaz.
+typedef struct {
+    pthread_mutex_t lock;
+    uint64_t rate;                  // Saniyede jeton; 0: sınırsız
+    double tokens;
+    uint64_t last;                  // Son dolum (ns)
+} bucket_t;
+
+static bucket_t opens = { PTHREAD_MUTEX_INITIALIZER, 0, 0, 0 };
+static bucket_t bytes = { PTHREAD_MUTEX_INITIALIZER, 0, 0, 0 };
+static int use_psi = 0;
+static volatile sig_atomic_t *running = NULL;
+
+static uint64_t psi_checked = 0;    // Son PSI okuması (ns)
+static int psi_centi = -1;          // avg10 * 100; -1: bilinmiyor
+
+static inline int still_running(void) {
+    return !running || *running;
+}
+
+// ns kadar uyu; running düşerse erken dön
+static void wait_ns(uint64_t ns) {
+    while (ns > 0 && still_running()) {
+        uint64_t slice = ns < WAIT_SLICE ? ns : WAIT_SLICE;
+        struct timespec ts = { (time_t) (slice / 1000000000ULL), (long) (slice % 1000000000ULL) };
+        nanosleep(&ts, NULL);
+        ns -= slice;
+    }
+}
+
+/* ================ PSI ================ */
+
+// "some avg10=12.34 avg60=... total=..." satırını oku
+static int read_pressure(void) {
+    char text[256];
+    double avg10;
+
+    int fd = open(PSI_FILE, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    ssize_t n = read(fd, text, sizeof(text) - 1);
+    close(fd);
+    if (n <= 0) return -1;
+    text[n] = '\0';
+    if (sscanf(text, "some avg10=%lf", &avg10) != 1) return -1;
+    return (int) (avg10 * 100.0 + 0.5);
+}
+
+// Son okumanın üzerinden PSI_INTERVAL geçtiyse yenile; aynı anda yalnızca
+// bir iş parçacığı okur, diğerleri son değeri kullanır
+static int pressure(uint64_t now) {
+    uint64_t last = __atomic_load_n(&psi_checked, __ATOMIC_RELAXED);
+
+    if (now - last >= PSI_INTERVAL &&
+        __atomic_compare_exchange_n(&psi_checked, &last, now, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        int centi = read_pressure();
+        __atomic_store_n(&psi_centi, centi, __ATOMIC_RELAXED);
+        metrics_set(G_IO_PRESSURE, centi < 0 ? 0 : (uint64_t) centi);
+    }
+    return __atomic_load_n(&psi_centi, __ATOMIC_RELAXED);
+}
+
+// Baskıya göre hız oranı (PSI_MIN_FACTOR..1); eşiğin üstündeyse baskı
+// düşene kadar burada beklenir
+static double pressure_factor(void) {
+    if (!use_psi) return 1.0;
+
+    uint64_t now = metrics_now();
+    int centi = pressure(now);
+    if (centi >= (int) (THROTTLE_PSI_HIGH * 100)) {
+        uint64_t started = now;
+        while (still_running() && pressure(metrics_now()) >= (int) (THROTTLE_PSI_HIGH * 100)) {
+            wait_ns(WAIT_SLICE);
+        }
+        metrics_add(M_THROTTLE_NS, metrics_now() - started);
+        centi = pressure(metrics_now());
+    }
+    if (centi <= (int) (THROTTLE_PSI_LOW * 100)) return 1.0;
+
+    double factor = 1.0 - (centi / 100.0 - THROTTLE_PSI_LOW) / (THROTTLE_PSI_HIGH - THROTTLE_PSI_LOW);
+    return factor < PSI_MIN_FACTOR ? PSI_MIN_FACTOR : factor;
+}
+
+/* ================ KOVALAR ================ */
+
+static void bucket_take(bucket_t *bucket, uint64_t n, double factor) {
+    uint64_t now = metrics_now();
+    uint64_t wait = 0;
+
+    pthread_mutex_lock(&bucket->lock);
+    double rate = (double) bucket->rate * factor;
+    if (bucket->last) {
+        bucket->tokens += (double) (now - bucket->last) * rate / 1e9;
+        if (bucket->tokens > rate) bucket->tokens = rate;
+    } else {
+        bucket->tokens = rate;
+    }
+    bucket->last = now;
+    bucket->tokens -= (double) n;
+    if (bucket->tokens < 0) wait = (uint64_t) (-bucket->tokens / rate * 1e9);
+    pthread_mutex_unlock(&bucket->lock);
+
+    if (wait) {
+        wait_ns(wait);
+        metrics_add(M_THROTTLE_NS, wait);
+    }
+}
+
+void throttle_init(const throttle_options_t *options) {
+    opens.rate = options->opens_per_sec;
+    bytes.rate = options->bytes_per_sec;
+    opens.tokens = bytes.tokens = 0;
+    opens.last = bytes.last = 0;
+    use_psi = options->psi;
+    running = options->running;
+    psi_checked = 0;
+    psi_centi = -1;
+    if (use_psi && read_pressure() < 0) {
+        syslog(LOG_WARNING, "%s okunamadı, PSI'ye göre yavaşlama kapalı", PSI_FILE);
+        use_psi = 0;
+    }
+}
+
+void throttle_open(void) {
+    double factor = pressure_factor();
+
+    if (opens.rate) {
+        bucket_take(&opens, 1, factor);
+    } else if (factor < 1.0) {
+        // Sınır verilmemişse baskı oranında açma başına gecikme
+        uint64_t wait = (uint64_t) ((1.0 - factor) * THROTTLE_PSI_DELAY * 1000.0);
+        wait_ns(wait);
+        metrics_add(M_THROTTLE_NS, wait);
+    }
+}
+
+void throttle_bytes(uint64_t n) {
+    if (bytes.rate && n) bucket_take(&bytes, n, pressure_factor());
+}
+
+int throttle_set_idle(void) {
+    struct sched_param param;
+    int result = 0;
+
+    if (syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0,
+                IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT) != 0) {
+        result = -1;
+    }
+    memset(&param, 0, sizeof(param));
+    if (sched_setscheduler(0, SCHED_IDLE, &param) != 0) result = -1;
+    return result;
+}
+
+double throttle_pressure(void) {
+    int centi = use_psi ? __atomic_load_n(&psi_centi, __ATOMIC_RELAXED) : -1;
+    return centi < 0 ? -1.0 : centi / 100.0;
+}
@@ -0,0 +1,41 @@
+#ifndef ELFMON_THROTTLE_H
+#define ELFMON_THROTTLE_H
+
+#include <signal.h>
+#include <stdint.h>
+
+// Tarama kaynak bütçesi. Açılan dosya/dizin ve okunan byte için iki jeton
+// kovası vardır; iş parçacıkları kovayı borçlandırır ve borçları kadar
+// uyur, böylece toplam hız tüm iş parçacıklarında sınırda kalır.
+//
+// PSI açıksa /proc/pressure/io'nun "some avg10" değeri en fazla saniyede
+// bir okunur: THROTTLE_PSI_LOW altında tam hız, aralıkta hızlar doğrusal
+// olarak (en az %10'a) düşürülür ve sınırsız açma kovası da açma başına
+// bekletilir, THROTTLE_PSI_HIGH üstünde baskı düşene kadar tarama durur.
+
+#define THROTTLE_PSI_LOW   10.0     // Yüzde
+#define THROTTLE_PSI_HIGH  40.0
+#define THROTTLE_PSI_DELAY 2000     // Baskı altında sınırsız kovada açma başına en çok bekleme (us)
+
+typedef struct {
+    uint64_t opens_per_sec;         // 0: sınırsız
+    uint64_t bytes_per_sec;         // 0: sınırsız
+    int psi;                        // /proc/pressure/io'ya göre yavaşla
+    volatile sig_atomic_t *running; // 0 olunca beklemeler hemen biter
+} throttle_options_t;
+
+void throttle_init(const throttle_options_t *options);
+
+// Bir açma / n byte için bütçeden düş, gerekirse bekle. Birden fazla iş
+// parçacığından çağrılabilir.
+void throttle_open(void);
+void throttle_bytes(uint64_t n);
+
+// Çağıran iş parçacığını (ve sonra oluşturduğu iş parçacıklarını)
+// IOPRIO_CLASS_IDLE ve SCHED_IDLE'a al; 0 başarı, -1 en az biri olmadı
+int throttle_set_idle(void);
+
+// Son okunan PSI değeri (yüzde; PSI kapalı ya da yoksa -1)
+double throttle_pressure(void);
+
+#endif
@@ -0,0 +1,629 @@
+#define _GNU_SOURCE
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <syslog.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include "walker.h"
+#include "path_filter.h"
+
+#define SEEN_SHARDS    64           // Ziyaret kümesi kilit parçası
+#define SEEN_INITIAL   256          // Parça başına ilk yuva sayısı (2'nin kuvveti)
+#define IDLE_SPINS     64           // Uyumadan önce çalma denemesi
+#define IDLE_SLEEP_NS  100000       // Boşta bekleme (100 us)
+#define DENTS_BUFFER   (128 * 1024) // getdents64 tamponu (iş parçacığı başına)
+#define FD_BUDGET_MAX  4096         // Çocukları için açık tutulan dizin sayısı
+
+#define OPEN_DIR_FLAGS (O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC)
+
+// Çekirdeğin getdents64 kaydı
+struct linux_dirent64 {
+    uint64_t       d_ino;
+    int64_t        d_off;
+    unsigned short d_reclen;
+    unsigned char  d_type;
+    char           d_name[];
+};
+
+// Dizin ağacındaki düğüm. Kuyruktaki ya da işlenmekte olan her çocuk
+// ebeveynine bir referans tutar; referans sıfıra inince tanıtıcı kapanır
+// ve düğüm serbest bırakılır. fd çocuklar kuyruğa girmeden önce yazılır
+// ve düğüm yaşadıkça değişmez.
+struct walk_node {
+    walk_node_t *parent;
+    int fd;                         // Çocuklar için açık tanıtıcı ya da -1
+    int refs;
+    filter_state_t match;           // Yol süzgecinin bu dizindeki durumu
+    dev_t dev;                      // Okununca yazılır; çocuklar bağlama sınırını buna göre anlar
+    size_t length;
+    char name[];                    // Başlangıç düğümünde yolun tamamı
+};
+
+// İş parçacığı başına dizin kuyruğu: sahibi alttan (bottom), hırsızlar
+// üstten (top) alır. Kısa kritik bölgeler için bir mutex yeterli.
+typedef struct {
+    pthread_mutex_t lock;
+    walk_node_t **items;
+    size_t top, bottom, capacity;
+} deque_t;
+
+typedef struct {
+    uint64_t dev, ino;
+} dir_key_t;
+
+typedef struct {
+    pthread_mutex_t lock;
+    dir_key_t *keys;                // ino == 0: boş yuva
+    uint32_t capacity, count;
+} seen_shard_t;
+
+typedef struct walk walk_t;
+
+typedef struct {
+    walk_t *walk;
+    deque_t queue;
+    char *dents;                    // getdents64 tamponu
+    unsigned seed;
+    walk_stats_t stats;
+} worker_t;
+
+struct walk {
+    const walk_options_t *options;
+    walk_file_fn fn;
+    void *ctx;
+    dev_t root_dev;
+    int threads;
+    long pending;                   // Kuyrukta ya da işlenmekte olan dizin
+    long open_fds;                  // Çocukları için açık tutulan tanıtıcı
+    long fd_budget;
+    worker_t workers[WALK_MAX_THREADS];
+    seen_shard_t seen[SEEN_SHARDS];
+};
+
+static inline int still_running(const walk_t *w) {
+    return !w->options->running || *w->options->running;
+}
+
+/* ================ KUYRUK ================ */
+
+static int deque_push(deque_t *q, walk_node_t *node) {
+    pthread_mutex_lock(&q->lock);
+    if (q->bottom == q->capacity) {
+        // Üstte boşalan yer varsa önce kaydır, yoksa büyüt
+        if (q->top > 0) {
+            memmove(q->items, q->items + q->top, (q->bottom - q->top) * sizeof(walk_node_t *));
+            q->bottom -= q->top;
+            q->top = 0;
+        } else {
+            size_t capacity = q->capacity ? q->capacity * 2 : 256;
+            walk_node_t **items = realloc(q->items, capacity * sizeof(walk_node_t *));
+            if (!items) {
+                pthread_mutex_unlock(&q->lock);
+                return -1;
+            }
+            q->items = items;
+            q->capacity = capacity;
+        }
+    }
+    q->items[q->bottom++] = node;
+    pthread_mutex_unlock(&q->lock);
+    return 0;
+}
+
+static walk_node_t *deque_pop(deque_t *q) {
+    walk_node_t *node = NULL;
+
+    pthread_mutex_lock(&q->lock);
+    if (q->bottom > q->top) node = q->items[--q->bottom];
+    if (q->bottom == q->top) q->bottom = q->top = 0;
+    pthread_mutex_unlock(&q->lock);
+    return node;
+}
+
+static walk_node_t *deque_steal(deque_t *q) {
+    walk_node_t *node = NULL;
+
+    // Sahibiyle yarışmamak için kilit alınamazsa başka kurbana geçilir
+    if (pthread_mutex_trylock(&q->lock) != 0) return NULL;
+    if (q->bottom > q->top) node = q->items[q->top++];
+    pthread_mutex_unlock(&q->lock);
+    return node;
+}
+
+/* ================ ZİYARET KÜMESİ ================ */
+
+static inline uint64_t key_hash(uint64_t dev, uint64_t ino) {
+    uint64_t h = (ino ^ (dev * 0x9E3779B97F4A7C15ULL)) * 0xBF58476D1CE4E5B9ULL;
+    return h ^ (h >> 31);
+}
+
+static int seen_insert_slot(dir_key_t *keys, uint32_t capacity, uint64_t h, dir_key_t key) {
+    uint32_t mask = capacity - 1;
+    uint32_t i = (uint32_t) h & mask;
+
+    while (keys[i].ino != 0) {
+        if (keys[i].ino == key.ino && keys[i].dev == key.dev) return 0;
+        i = (i + 1) & mask;
+    }
+    keys[i] = key;
+    return 1;
+}
+
+// Dizin ilk kez görülüyorsa 1, daha önce görüldüyse 0 döndürür
+static int seen_add(walk_t *w, const struct stat *st) {
+    dir_key_t key = { st->st_dev, st->st_ino ? st->st_ino : 1 };
+    uint64_t h = key_hash(key.dev, key.ino);
+    seen_shard_t *shard = &w->seen[(h >> 58) % SEEN_SHARDS];
+    int added;
+
+    pthread_mutex_lock(&shard->lock);
+    if ((shard->count + 1) * 2 > shard->capacity) {
+        uint32_t capacity = shard->capacity ? shard->capacity * 2 : SEEN_INITIAL;
+        dir_key_t *keys = calloc(capacity, sizeof(dir_key_t));
+        if (keys) {
+            for (uint32_t i = 0; i < shard->capacity; i++) {
+                if (shard->keys[i].ino == 0) continue;
+                seen_insert_slot(keys, capacity, key_hash(shard->keys[i].dev, shard->keys[i].ino),
+                                 shard->keys[i]);
+            }
+            free(shard->keys);
+            shard->keys = keys;
+            shard->capacity = capacity;
+        }
+    }
+    // Büyütülemeyen dolu tabloda dizin yeni sayılır (en kötü ihtimalle
+    // iki kez gezilir)
+    if (shard->count + 1 >= shard->capacity) {
+        added = 1;
+    } else {
+        added = seen_insert_slot(shard->keys, shard->capacity, h, key);
+        shard->count += added;
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return added;
+}
+
+/* ================ DÜĞÜMLER ================ */
+
+static walk_node_t *node_new(walk_node_t *parent, const char *name, size_t length) {
+    walk_node_t *node = malloc(sizeof(walk_node_t) + length + 1);
+    if (!node) return NULL;
+    node->parent = parent;
+    node->fd = -1;
+    node->refs = 1;
+    node->match = 0;
+    node->dev = 0;
+    node->length = length;
+    memcpy(node->name, name, length);
+    node->name[length] = '\0';
+    if (parent) __atomic_add_fetch(&parent->refs, 1, __ATOMIC_SEQ_CST);
+    return node;
+}
+
+// Referansı bırak; sıfıra inen düğüm kapanır ve ebeveyninin referansı da
+// bırakılır
+static void node_release(walk_t *w, walk_node_t *node) {
+    while (node && __atomic_sub_fetch(&node->refs, 1, __ATOMIC_SEQ_CST) == 0) {
+        walk_node_t *parent = node->parent;
+        if (node->fd >= 0) {
+            close(node->fd);
+            __atomic_sub_fetch(&w->open_fds, 1, __ATOMIC_SEQ_CST);
+        }
+        free(node);
+        node = parent;
+    }
+}
+
+// Düğümün dizinini aç: ebeveynin tanıtıcısı açıksa tek openat, değilse
+// en yakın açık atadan bileşen bileşen. Kökün tanıtıcısı hep açıktır;
+// walk_resume'un başlangıç düğümleri kapalıysa tam yollarından açılır.
+static int node_open(worker_t *self, const walk_node_t *node) {
+    const walk_node_t *ancestor = node->parent;
+    size_t depth = 1;
+
+    if (!ancestor) return open(node->name, OPEN_DIR_FLAGS);
+    if (ancestor->fd >= 0) return openat(ancestor->fd, node->name, OPEN_DIR_FLAGS);
+
+    while (ancestor->fd < 0 && ancestor->parent) {
+        ancestor = ancestor->parent;
+        depth++;
+    }
+    const walk_node_t **chain = malloc(depth * sizeof(*chain));
+    if (!chain) return -1;
+    const walk_node_t *n = node;
+    for (size_t i = depth; i > 0; i--, n = n->parent) chain[i - 1] = n;
+
+    int fd = ancestor->fd >= 0 ? ancestor->fd : open(ancestor->name, OPEN_DIR_FLAGS);
+    for (size_t i = 0; i < depth && fd >= 0; i++) {
+        int next = openat(fd, chain[i]->name, OPEN_DIR_FLAGS);
+        if (fd != ancestor->fd) close(fd);
+        fd = next;
+    }
+    free(chain);
+    self->stats.reopened++;
+    return fd;
+}
+
+// dir altındaki name'in tam yolu; dir NULL ise name zaten tam yoldur
+static int build_path(const walk_node_t *dir, const char *name, char *buffer, size_t size) {
+    size_t total = strlen(name);
+    const walk_node_t *n;
+
+    // Önce uzunluk, sonra sondan başa doldurma; "/" kökünde çift bölü yok
+    for (n = dir; n; n = n->parent) {
+        total += n->length + (n->length > 0 && n->name[n->length - 1] != '/');
+    }
+    if (total + 1 > size) return -1;
+
+    size_t end = total;
+    buffer[end] = '\0';
+    size_t length = strlen(name);
+    memcpy(buffer + end - length, name, length);
+    end -= length;
+    for (n = dir; n; n = n->parent) {
+        if (n->length > 0 && n->name[n->length - 1] != '/') buffer[--end] = '/';
+        memcpy(buffer + end - n->length, n->name, n->length);
+        end -= n->length;
+    }
+    return 0;
+}
+
+int walk_path(const walk_file_t *file, char *buffer, size_t size) {
+    return build_path(file->dir, file->name, buffer, size);
+}
+
+/* ================ GEZİNTİ ================ */
+
+static void push_directory(worker_t *self, walk_node_t *node) {
+    __atomic_add_fetch(&self->walk->pending, 1, __ATOMIC_SEQ_CST);
+    if (deque_push(&self->queue, node) != 0) {
+        __atomic_sub_fetch(&self->walk->pending, 1, __ATOMIC_SEQ_CST);
+        node_release(self->walk, node);
+    }
+}
+
+static void push_child(worker_t *self, walk_node_t *parent, const char *name, filter_state_t match) {
+    walk_node_t *child = node_new(parent, name, strlen(name));
+    if (!child) return;
+    child->match = match;
+    push_directory(self, child);
+}
+
+// Kesilen gezintide okunmayan ya da yarıda kalan dizini bildir
+static void report_unfinished(worker_t *self, const walk_node_t *node) {
+    char path[PATH_MAX];
+
+    if (!self->walk->options->unfinished) return;
+    if (build_path(node->parent, node->name, path, sizeof(path)) != 0) return;
+    self->walk->options->unfinished(path, self->walk->ctx);
+}
+
+// getdents64 hatası (EIO gibi): dizin eksik okunmuştur, loglanır ve
+// tamamlanmamış sayılır
+static void report_read_error(worker_t *self, const walk_node_t *node, int error) {
+    char path[PATH_MAX];
+
+    self->stats.read_errors++;
+    if (build_path(node->parent, node->name, path, sizeof(path)) != 0) return;
+    syslog(LOG_WARNING, "Dizin okunamadı: %s: %s", path, strerror(error));
+}
+
+static void emit_file(worker_t *self, walk_node_t *node, int fd, const char *name,
+                      const struct stat *st) {
+    walk_file_t file = { node, fd, name, st };
+
+    self->stats.files++;
+    self->walk->fn(&file, self->walk->ctx);
+}
+
+// Dizin girdisi: düzenli dosya geri çağrıya, dizin kuyruğa. Süzgeç
+// açıksa ad tek adımda eşlenir; budanan dizin kuyruğa hiç girmez.
+static void visit_entry(worker_t *self, walk_node_t *node, int fd, const char *name,
+                        unsigned char type) {
+    const walk_options_t *options = self->walk->options;
+    filter_state_t match = 0;
+    struct stat st;
+
+    if (type != DT_REG && type != DT_DIR && type != DT_UNKNOWN) return;
+    if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) return;
+    if (options->filter) {
+        match = path_filter_step(node->match, name);
+        if (path_filter_verdict(match) == FILTER_PRUNE) {
+            self->stats.filtered++;
+            return;
+        }
+    }
+
+    // Türü bildirmeyen dosya sistemleri (bazı XFS/NFS/FUSE): tür stat ile
+    // öğrenilir, stat bilgisi geri çağrıya da verilir
+    const struct stat *known = NULL;
+    if (type == DT_UNKNOWN) {
+        self->stats.unknown++;
+        if (fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) return;
+        if (S_ISDIR(st.st_mode)) {
+            type = DT_DIR;
+        } else if (S_ISREG(st.st_mode)) {
+            type = DT_REG;
+            known = &st;
+        } else {
+            return;
+        }
+    }
+
+    if (type == DT_DIR) {
+        push_child(self, node, name, match);
+    } else if (options->filter && path_filter_verdict(match) != FILTER_SCAN) {
+        // Yalnızca altında dahil olan bulunabilecek bir ad
+        self->stats.filtered++;
+    } else {
+        emit_file(self, node, fd, name, known);
+    }
+}
+
+static void read_directory(worker_t *self, walk_node_t *node) {
+    walk_t *w = self->walk;
+    struct stat st;
+    int complete = 0;
+
+    if (node->fd < 0 && w->options->pace) w->options->pace();
+    int fd = node->fd >= 0 ? node->fd : node_open(self, node);
+    if (fd < 0) return;
+
+    // Aynı dizine ikinci yoldan gelindiyse ya da başka dosya sistemiyse atla
+    int skip = fstat(fd, &st) != 0;
+    if (!skip && w->options->xdev && st.st_dev != w->root_dev) {
+        self->stats.other_fs++;
+        skip = 1;
+    } else if (!skip && w->options->filter && (!node->parent || node->parent->dev != st.st_dev) &&
+               path_filter_excluded_dev(st.st_dev)) {
+        // Bağlama sınırında türü hariç tutulan dosya sistemi
+        self->stats.excluded_fs++;
+        skip = 1;
+    } else if (!skip && !seen_add(w, &st)) {
+        self->stats.duplicates++;
+        skip = 1;
+    }
+    if (skip) {
+        if (fd != node->fd) close(fd);
+        return;
+    }
+    self->stats.directories++;
+    node->dev = st.st_dev;
+
+    // Bütçe izin verirse tanıtıcı çocuklar için açık kalır (kökünki zaten
+    // açık); çocuklar kuyruğa girmeden önce yazılmalı
+    if (fd != node->fd) {
+        if (__atomic_add_fetch(&w->open_fds, 1, __ATOMIC_SEQ_CST) <= w->fd_budget) {
+            node->fd = fd;
+        } else {
+            __atomic_sub_fetch(&w->open_fds, 1, __ATOMIC_SEQ_CST);
+        }
+    }
+
+    // Süzgeç yalnızca sabit adlı çocuklara izin veriyorsa dizin okunmaz,
+    // o adlara doğrudan bakılır (ör. "include /usr/lib" kökte yalnızca usr)
+    const char *const *names = NULL;
+    int literals = w->options->filter ? path_filter_literals(node->match, &names) : -1;
+    for (int i = 0; i < literals && still_running(w); i++) visit_entry(self, node, fd, names[i], DT_UNKNOWN);
+    if (literals >= 0) complete = still_running(w);
+
+    while (literals < 0 && still_running(w)) {
+        long n = syscall(SYS_getdents64, fd, self->dents, DENTS_BUFFER);
+        if (n < 0) {
+            report_read_error(self, node, errno);
+            break;
+        }
+        if (n == 0) {
+            complete = 1;
+            break;
+        }
+
+        for (long offset = 0; offset < n; ) {
+            struct linux_dirent64 *entry = (struct linux_dirent64 *) (self->dents + offset);
+            offset += entry->d_reclen;
+            visit_entry(self, node, fd, entry->d_name, entry->d_type);
+        }
+    }
+    if (!complete) report_unfinished(self, node);
+    if (fd != node->fd) close(fd);
+}
+
+// Kendi kuyruğu boşsa rastgele kurbanlardan çal
+static walk_node_t *find_work(worker_t *self) {
+    walk_t *w = self->walk;
+    walk_node_t *node = deque_pop(&self->queue);
+    if (node || w->threads == 1) return node;
+
+    int start = (int) (rand_r(&self->seed) % (unsigned) w->threads);
+    for (int i = 0; i < w->threads; i++) {
+        worker_t *victim = &w->workers[(start + i) % w->threads];
+        if (victim == self) continue;
+        node = deque_steal(&victim->queue);
+        if (node) {
+            self->stats.steals++;
+            return node;
+        }
+    }
+    return NULL;
+}
+
+static void *worker_main(void *arg) {
+    worker_t *self = arg;
+    walk_t *w = self->walk;
+    int idle = 0;
+
+    // Kuyruklarda ya da işlenmekte dizin kalmayınca herkes çıkar
+    while (__atomic_load_n(&w->pending, __ATOMIC_SEQ_CST) > 0) {
+        walk_node_t *node = find_work(self);
+        if (!node) {
+            if (++idle < IDLE_SPINS) {
+                sched_yield();
+            } else {
+                struct timespec ts = { 0, IDLE_SLEEP_NS };
+                nanosleep(&ts, NULL);
+            }
+            continue;
+        }
+        idle = 0;
+
+        // Kesilen gezintide kuyruktaki dizinler okunmadan boşaltılır
+        if (still_running(w)) {
+            read_directory(self, node);
+        } else {
+            report_unfinished(self, node);
+        }
+        node_release(w, node);
+        __atomic_sub_fetch(&w->pending, 1, __ATOMIC_SEQ_CST);
+    }
+    return NULL;
+}
+
+// Başlangıç dizininin süzgeç durumu; budanıyorsa 0
+static int start_filter(walk_node_t *start) {
+    start->match = path_filter_start(start->name);
+    return path_filter_verdict(start->match) != FILTER_PRUNE;
+}
+
+// Gezinti durumunu kur; kökün tanıtıcısı root_fd'ye yazılır
+static walk_t *walk_new(const char *root, const walk_options_t *options,
+                        walk_file_fn fn, void *ctx, int *root_fd) {
+    struct stat st;
+    struct rlimit limit;
+
+    *root_fd = open(root, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (*root_fd < 0) return NULL;
+    walk_t *w = calloc(1, sizeof(walk_t));
+    if (!w || fstat(*root_fd, &st) != 0) {
+        free(w);
+        close(*root_fd);
+        return NULL;
+    }
+    w->options = options;
+    w->fn = fn;
+    w->ctx = ctx;
+    w->root_dev = st.st_dev;
+    w->threads = options->threads > 0 ? options->threads : (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if (w->threads < 1) w->threads = 1;
+    if (w->threads > WALK_MAX_THREADS) w->threads = WALK_MAX_THREADS;
+
+    // Açık tutulan dizinler tanıtıcı limitinin yarısını geçmez; kalanı
+    // dosya açmak ve diğer modüller için
+    w->fd_budget = FD_BUDGET_MAX;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY &&
+        (long) (limit.rlim_cur / 2) < w->fd_budget) {
+        w->fd_budget = (long) (limit.rlim_cur / 2);
+    }
+
+    // Çağıranın tamponu şart; diğer iş parçacıkları tamponsuzsa başlatılmaz
+    w->workers[0].dents = malloc(DENTS_BUFFER);
+    if (!w->workers[0].dents) {
+        free(w);
+        close(*root_fd);
+        return NULL;
+    }
+    for (int i = 0; i < SEEN_SHARDS; i++) pthread_mutex_init(&w->seen[i].lock, NULL);
+    for (int i = 0; i < w->threads; i++) {
+        w->workers[i].walk = w;
+        w->workers[i].seed = (unsigned) i * 2654435761u + 1;
+        if (i > 0) w->workers[i].dents = malloc(DENTS_BUFFER);
+        pthread_mutex_init(&w->workers[i].queue.lock, NULL);
+    }
+    return w;
+}
+
+// Kuyruklar boşalana kadar gez, istatistikleri topla ve durumu serbest bırak
+static void walk_run(walk_t *w, walk_stats_t *stats) {
+    pthread_t threads[WALK_MAX_THREADS];
+
+    // İlk iş parçacığı çağıranın kendisi
+    int started = 1;
+    for (int i = 1; i < w->threads; i++) {
+        if (!w->workers[i].dents) break;
+        if (pthread_create(&threads[i], NULL, worker_main, &w->workers[i]) != 0) break;
+        started++;
+    }
+    worker_main(&w->workers[0]);
+    for (int i = 1; i < started; i++) pthread_join(threads[i], NULL);
+
+    if (stats) memset(stats, 0, sizeof(*stats));
+    for (int i = 0; i < w->threads; i++) {
+        worker_t *k = &w->workers[i];
+        if (stats) {
+            stats->directories += k->stats.directories;
+            stats->files += k->stats.files;
+            stats->duplicates += k->stats.duplicates;
+            stats->other_fs += k->stats.other_fs;
+            stats->steals += k->stats.steals;
+            stats->unknown += k->stats.unknown;
+            stats->reopened += k->stats.reopened;
+            stats->filtered += k->stats.filtered;
+            stats->excluded_fs += k->stats.excluded_fs;
+            stats->read_errors += k->stats.read_errors;
+        }
+        free(k->dents);
+        free(k->queue.items);
+        pthread_mutex_destroy(&k->queue.lock);
+    }
+    for (int i = 0; i < SEEN_SHARDS; i++) {
+        free(w->seen[i].keys);
+        pthread_mutex_destroy(&w->seen[i].lock);
+    }
+    free(w);
+}
+
+int walk_tree(const char *root, const walk_options_t *options,
+              walk_file_fn fn, void *ctx, walk_stats_t *stats) {
+    int root_fd;
+
+    walk_node_t *start = node_new(NULL, root, strlen(root));
+    if (!start) return -1;
+    walk_t *w = walk_new(root, options, fn, ctx, &root_fd);
+    if (!w) {
+        free(start);
+        return -1;
+    }
+    start->fd = root_fd;
+    w->open_fds = 1;
+    if (!options->filter || start_filter(start)) {
+        push_directory(&w->workers[0], start);
+    } else {
+        node_release(w, start);
+    }
+    walk_run(w, stats);
+    return 0;
+}
+
+int walk_resume(const char *root, const char *const *dirs, size_t count,
+                const walk_options_t *options, walk_file_fn fn, void *ctx,
+                walk_stats_t *stats) {
+    int root_fd;
+
+    // Kök yalnızca xdev için aygıtını öğrenmek üzere açılır
+    walk_t *w = walk_new(root, options, fn, ctx, &root_fd);
+    if (!w) return -1;
+    close(root_fd);
+
+    // Başlangıç düğümleri kapalı kuyruğa girer ve sırası gelince tam
+    // yollarından açılır; binlerce yarım dizin tanıtıcı limitini aşmaz
+    for (size_t i = 0; i < count; i++) {
+        walk_node_t *start = node_new(NULL, dirs[i], strlen(dirs[i]));
+        if (!start) continue;
+        if (!options->filter || start_filter(start)) {
+            push_directory(&w->workers[i % (size_t) w->threads], start);
+        } else {
+            node_release(w, start);
+        }
+    }
+    walk_run(w, stats);
+    return 0;
+}
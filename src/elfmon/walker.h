@@ -0,0 +1,85 @@
+#ifndef ELFMON_WALKER_H
+#define ELFMON_WALKER_H
+
+#include <signal.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/stat.h>
+
+// Paralel dizin gezgini. Her iş parçacığının kendi dizin kuyruğu (deque)
+// vardır: sahibi alttan alır (derinlik öncelikli, önbelleğe dost), işi
+// biten iş parçacığı rastgele bir kurbanın kuyruğunun üstünden çalar
+// (genelde köke yakın, büyük bir alt ağaç). Ziyaret edilen dizinler
+// (st_dev, st_ino) ile tekilleştirilir; bind mount döngüleri ve aynı
+// dizine ikinci yoldan ulaşmak tek ziyarete iner.
+//
+// Dizinler dosya tanıtıcısıyla gezilir (openat + getdents64); hiçbir
+// adımda tam yol kurulmaz. Kuyruktaki dizin ebeveyninin hâlâ açık
+// tanıtıcısına göre açılır; açık tanıtıcı bütçesi dolmuşsa en yakın açık
+// atadan bileşen bileşen inilir. Tam yol yalnızca istendiğinde
+// (walk_path, ör. loglarken) düğüm zincirinden üretilir.
+//
+// filter açıksa her dizin path_filter durumunu taşır; çocuğun durumu tek
+// adımda bulunur ve budanan alt ağaca hiç girilmez.
+
+#define WALK_MAX_THREADS 64
+
+typedef struct walk_node walk_node_t;
+
+// Bulunan düzenli dosya: dirfd'ye göre name. d_type bilinmediği için
+// gezginin stat ettiği dosyalarda st doludur, diğerlerinde NULL.
+typedef struct {
+    const walk_node_t *dir;
+    int dirfd;
+    const char *name;
+    const struct stat *st;
+} walk_file_t;
+
+// Düzenli dosya bulundu; birden fazla iş parçacığından aynı anda çağrılır
+typedef void (*walk_file_fn)(const walk_file_t *file, void *ctx);
+
+// Kesilen gezintide hiç okunmayan ya da yarıda kalan dizinin tam yolu;
+// walk_resume'a verilince gezinti kaldığı yerden sürer. Aynı anda
+// birden fazla iş parçacığından çağrılır.
+typedef void (*walk_dir_fn)(const char *path, void *ctx);
+
+typedef struct {
+    int threads;                        // 0: çevrimiçi CPU sayısı
+    int xdev;                           // 1: kökün dosya sisteminden çıkma
+    volatile sig_atomic_t *running;     // 0 olunca gezinti yarıda kesilir
+    walk_dir_fn unfinished;             // NULL olabilir; ctx geri çağrınınki
+    void (*pace)(void);                 // NULL olabilir; her dizin açılmadan önce (hız sınırı)
+    int filter;                         // 1: path_filter kurallarıyla buda (yüklü olmalı)
+} walk_options_t;
+
+typedef struct {
+    uint64_t directories;               // Okunan dizin
+    uint64_t files;                     // Geri çağrıya verilen dosya
+    uint64_t duplicates;                // Daha önce görüldüğü için atlanan dizin
+    uint64_t other_fs;                  // xdev nedeniyle atlanan dizin
+    uint64_t steals;                    // Başka kuyruktan çalınan iş
+    uint64_t unknown;                   // d_type'ı DT_UNKNOWN olup stat edilen
+    uint64_t reopened;                  // Atadan bileşen bileşen açılan dizin
+    uint64_t filtered;                  // Yol süzgecinin budadığı ad
+    uint64_t excluded_fs;               // Türü hariç tutulan dosya sistemindeki dizin
+    uint64_t read_errors;               // getdents64 hatasıyla yarım kalan dizin
+} walk_stats_t;
+
+// root altındaki her düzenli dosya için fn'yi çağır; 0 başarı, -1 kök
+// açılamadı ya da bellek yetmedi. stats NULL olabilir. Okuması hatayla
+// kesilen dizin read_errors'da sayılır ve unfinished'a bildirilir.
+int walk_tree(const char *root, const walk_options_t *options,
+              walk_file_fn fn, void *ctx, walk_stats_t *stats);
+
+// Kesilmiş bir gezintiyi unfinished'ın bildirdiği dizinlerden sürdür.
+// root yalnızca xdev için kökün aygıtını belirler; dizinler birbirinin
+// altındaysa ziyaret kümesi tekrarları eler. 0 başarı, -1 kök açılamadı
+// ya da bellek yetmedi.
+int walk_resume(const char *root, const char *const *dirs, size_t count,
+                const walk_options_t *options, walk_file_fn fn, void *ctx,
+                walk_stats_t *stats);
+
+// Dosyanın tam yolunu buffer'a yaz; sığmazsa -1
+int walk_path(const walk_file_t *file, char *buffer, size_t size);
+
+#endif
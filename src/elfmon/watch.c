@@ -0,0 +1,411 @@
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <limits.h>
+#include <mntent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <syslog.h>
+#include <unistd.h>
+#include <linux/magic.h>
+#include <sys/fanotify.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <sys/statfs.h>
+#include "watch.h"
+
+#define WATCH_MAX_FS     64         // fanotify ile işaretlenen dosya sistemi
+#define WATCH_EVENT_BUF  65536
+
+#define FAN_EVENTS   (FAN_CLOSE_WRITE | FAN_MODIFY | FAN_MOVED_TO | FAN_CREATE | FAN_ONDIR)
+#define IN_EVENTS    (IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_DONT_FOLLOW | IN_ONLYDIR)
+
+// Olay türü: hemen bildir / durulmayı bekle / alt ağaç
+enum { EV_CLOSED, EV_MODIFIED, EV_DIR };
+
+// fanotify ile işaretlenmiş dosya sistemi; olaydaki tanıtıcılar bu
+// dosya sisteminin bağlama noktasına göre açılır
+typedef struct {
+    fsid_t fsid;
+    int mount_fd;
+} watch_fs_t;
+
+// Durulmayı bekleyen değişiklik
+typedef struct {
+    char *path;
+    time_t last;
+} pending_t;
+
+static int mode = WATCH_NONE;
+static char watch_root[PATH_MAX];   // fanotify tüm dosya sistemini bildirir
+static size_t root_length = 0;
+static int notify_fd = -1;
+static int overflow = 0;
+
+static watch_fs_t filesystems[WATCH_MAX_FS];
+static int fs_count = 0;
+
+static char **wd_paths = NULL;      // inotify: izleme numarası -> dizin yolu
+static int wd_capacity = 0;
+
+static pending_t pending[WATCH_PENDING];
+static int pending_count = 0;
+
+static const char *pseudo_types[] = {
+    "proc", "sysfs", "devtmpfs", "devpts", "cgroup", "cgroup2", "pstore", "bpf",
+    "debugfs", "tracefs", "securityfs", "configfs", "fusectl", "mqueue",
+    "hugetlbfs", "autofs", "binfmt_misc", "efivarfs", "nsfs", "rpc_pipefs", NULL
+};
+
+int watch_pseudo_fs(const char *type) {
+    for (int i = 0; pseudo_types[i]; i++) {
+        if (strcmp(type, pseudo_types[i]) == 0) return 1;
+    }
+    return 0;
+}
+
+// inotify ağacı kurulurken mount tablosu yerine süper blok numarasına bakılır
+static int pseudo_magic(long type) {
+    switch (type) {
+    case PROC_SUPER_MAGIC: case SYSFS_MAGIC: case DEVPTS_SUPER_MAGIC:
+    case CGROUP_SUPER_MAGIC: case CGROUP2_SUPER_MAGIC: case PSTOREFS_MAGIC:
+    case BPF_FS_MAGIC: case DEBUGFS_MAGIC: case TRACEFS_MAGIC:
+    case SECURITYFS_MAGIC: case HUGETLBFS_MAGIC: case AUTOFS_SUPER_MAGIC:
+    case BINFMTFS_MAGIC: case EFIVARFS_MAGIC: case NSFS_MAGIC:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+/* ================ DURULMA ================ */
+
+static void pending_remove(int i) {
+    free(pending[i].path);
+    pending[i] = pending[--pending_count];
+}
+
+static int pending_find(const char *path) {
+    for (int i = 0; i < pending_count; i++) {
+        if (strcmp(pending[i].path, path) == 0) return i;
+    }
+    return -1;
+}
+
+// root altında mı?
+static int under_root(const char *path) {
+    if (root_length <= 1) return 1;
+    return strncmp(path, watch_root, root_length) == 0 &&
+           (path[root_length] == '/' || path[root_length] == '\0');
+}
+
+// Olayı ya hemen bildir ya da durulma tablosuna al
+static void deliver(const char *path, int type, watch_event_fn fn, void *ctx) {
+    if (!under_root(path)) return;
+
+    int i = pending_find(path);
+
+    if (type == EV_MODIFIED) {
+        if (i >= 0) {
+            pending[i].last = time(NULL);
+        } else if (pending_count < WATCH_PENDING && (pending[pending_count].path = strdup(path))) {
+            pending[pending_count++].last = time(NULL);
+        } else {
+            overflow = 1;
+        }
+        return;
+    }
+
+    if (i >= 0) pending_remove(i);
+    fn(path, type == EV_DIR, ctx);
+}
+
+int watch_flush(time_t now, watch_event_fn fn, void *ctx) {
+    int next = -1;
+
+    for (int i = 0; i < pending_count; ) {
+        time_t due = pending[i].last + WATCH_SETTLE;
+        if (due <= now) {
+            char *path = pending[i].path;
+            pending[i].path = NULL;
+            pending[i] = pending[--pending_count];
+            fn(path, 0, ctx);
+            free(path);
+            continue;
+        }
+        int ms = (int) (due - now) * 1000;
+        if (next < 0 || ms < next) next = ms;
+        i++;
+    }
+    return next;
+}
+
+/* ================ FANOTIFY ================ */
+
+static int fs_find(const fsid_t *fsid) {
+    for (int i = 0; i < fs_count; i++) {
+        if (memcmp(&filesystems[i].fsid, fsid, sizeof(*fsid)) == 0) return i;
+    }
+    return -1;
+}
+
+// Bağlama noktasının dosya sistemini işaretle (aynı dosya sistemi bir kez)
+static void fan_mark_mount(const char *dir) {
+    struct statfs st;
+
+    if (fs_count == WATCH_MAX_FS || statfs(dir, &st) != 0 || fs_find(&st.f_fsid) >= 0) return;
+
+    int fd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) return;
+
+    // fsid'si olmayan dosya sistemleri (bazı FUSE'lar) işaretlenemez;
+    // bunlar yalnızca uzlaştırma taramasıyla görülür
+    if (fanotify_mark(notify_fd, FAN_MARK_ADD | FAN_MARK_FILESYSTEM, FAN_EVENTS, AT_FDCWD, dir) != 0) {
+        syslog(LOG_NOTICE, "fanotify %s izlenemiyor: %s", dir, strerror(errno));
+        close(fd);
+        return;
+    }
+    filesystems[fs_count].fsid = st.f_fsid;
+    filesystems[fs_count].mount_fd = fd;
+    fs_count++;
+}
+
+static int fan_init(const char *root) {
+    notify_fd = fanotify_init(FAN_CLASS_NOTIF | FAN_REPORT_DFID_NAME | FAN_CLOEXEC | FAN_NONBLOCK,
+                              O_RDONLY | O_LARGEFILE);
+    if (notify_fd < 0) return -1;
+
+    FILE *mounts = setmntent("/proc/self/mounts", "r");
+    if (!mounts) {
+        close(notify_fd);
+        return -1;
+    }
+
+    size_t root_len = strlen(root);
+    struct mntent *m;
+    fan_mark_mount(root);
+    while ((m = getmntent(mounts)) != NULL) {
+        // Yalnızca root altındaki gerçek dosya sistemleri
+        if (watch_pseudo_fs(m->mnt_type)) continue;
+        if (strcmp(root, "/") != 0 &&
+            (strncmp(m->mnt_dir, root, root_len) != 0 ||
+             (m->mnt_dir[root_len] != '/' && m->mnt_dir[root_len] != '\0'))) {
+            continue;
+        }
+        fan_mark_mount(m->mnt_dir);
+    }
+    endmntent(mounts);
+
+    if (fs_count == 0) {
+        close(notify_fd);
+        notify_fd = -1;
+        return -1;
+    }
+    return 0;
+}
+
+// Dizin tanıtıcısı + ad: dizini açıp yolunu /proc'tan öğren
+static int fan_event_path(const struct fanotify_event_info_fid *fid, char *path, size_t size) {
+    struct file_handle *handle = (struct file_handle *) fid->handle;
+    const char *name = (const char *) handle->f_handle + handle->handle_bytes;
+    int i = fs_find((const fsid_t *) &fid->fsid);
+    char link[64];
+
+    if (i < 0) return -1;
+    int dir = open_by_handle_at(filesystems[i].mount_fd, handle, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir < 0) return -1;
+
+    snprintf(link, sizeof(link), "/proc/self/fd/%d", dir);
+    ssize_t n = readlink(link, path, size - 1);
+    close(dir);
+    if (n <= 0) return -1;
+    path[n] = '\0';
+
+    // Ad yoksa olay dizinin kendisine ait
+    if (name[0] == '\0' || strcmp(name, ".") == 0) return 0;
+    if ((size_t) n + 1 + strlen(name) >= size) return -1;
+    if (n > 1) path[n++] = '/';
+    strcpy(path + n, name);
+    return 0;
+}
+
+static int fan_dispatch(watch_event_fn fn, void *ctx) {
+    char buffer[WATCH_EVENT_BUF] __attribute__((aligned(8)));
+    char path[PATH_MAX];
+    int events = 0;
+
+    for (;;) {
+        ssize_t len = read(notify_fd, buffer, sizeof(buffer));
+        if (len < 0) return (errno == EAGAIN || errno == EINTR) ? events : -1;
+
+        struct fanotify_event_metadata *md = (struct fanotify_event_metadata *) buffer;
+        for (; FAN_EVENT_OK(md, len); md = FAN_EVENT_NEXT(md, len)) {
+            if (md->vers != FANOTIFY_METADATA_VERSION) return -1;
+            events++;
+
+            if (md->mask & FAN_Q_OVERFLOW) {
+                overflow = 1;
+                continue;
+            }
+
+            struct fanotify_event_info_fid *fid = (struct fanotify_event_info_fid *) (md + 1);
+            if (fid->hdr.info_type != FAN_EVENT_INFO_TYPE_DFID_NAME ||
+                fan_event_path(fid, path, sizeof(path)) != 0) {
+                continue;
+            }
+
+            // Yeni gelen dizinin içindekiler olay üretmeden oluşmuş olabilir
+            if (md->mask & FAN_ONDIR) {
+                if (md->mask & (FAN_MOVED_TO | FAN_CREATE)) deliver(path, EV_DIR, fn, ctx);
+            } else if (md->mask & (FAN_CLOSE_WRITE | FAN_MOVED_TO)) {
+                deliver(path, EV_CLOSED, fn, ctx);
+            } else if (md->mask & FAN_MODIFY) {
+                deliver(path, EV_MODIFIED, fn, ctx);
+            }
+        }
+    }
+}
+
+/* ================ INOTIFY ================ */
+
+static int in_add(const char *path) {
+    int wd = inotify_add_watch(notify_fd, path, IN_EVENTS);
+    if (wd < 0) {
+        // İzleme limiti doldu: kalan ağaç uzlaştırma taramasına kalır
+        if (errno == ENOSPC && !overflow) {
+            syslog(LOG_WARNING, "inotify izleme limiti doldu (fs.inotify.max_user_watches)");
+        }
+        if (errno == ENOSPC) overflow = 1;
+        return -1;
+    }
+
+    if (wd >= wd_capacity) {
+        int capacity = wd_capacity ? wd_capacity : 1024;
+        while (capacity <= wd) capacity *= 2;
+        char **grown = realloc(wd_paths, (size_t) capacity * sizeof(char *));
+        if (!grown) return -1;
+        memset(grown + wd_capacity, 0, (size_t) (capacity - wd_capacity) * sizeof(char *));
+        wd_paths = grown;
+        wd_capacity = capacity;
+    }
+    free(wd_paths[wd]);
+    wd_paths[wd] = strdup(path);
+    return 0;
+}
+
+static int in_visit(const char *path, const struct stat *st, int flag, struct FTW *ftw) {
+    struct statfs fs;
+    (void) st;
+    (void) ftw;
+
+    if (flag != FTW_D) return FTW_CONTINUE;
+    if (statfs(path, &fs) == 0 && pseudo_magic((long) fs.f_type)) return FTW_SKIP_SUBTREE;
+    if (in_add(path) != 0 && overflow) return FTW_STOP;
+    return FTW_CONTINUE;
+}
+
+static void in_add_tree(const char *root) {
+    nftw(root, in_visit, 64, FTW_PHYS | FTW_ACTIONRETVAL);
+}
+
+static int in_init(const char *root) {
+    notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (notify_fd < 0) return -1;
+    in_add_tree(root);
+    return 0;
+}
+
+static int in_dispatch(watch_event_fn fn, void *ctx) {
+    char buffer[WATCH_EVENT_BUF] __attribute__((aligned(8)));
+    char path[PATH_MAX];
+    int events = 0;
+
+    for (;;) {
+        ssize_t len = read(notify_fd, buffer, sizeof(buffer));
+        if (len < 0) return (errno == EAGAIN || errno == EINTR) ? events : -1;
+
+        for (char *p = buffer; p < buffer + len; ) {
+            struct inotify_event *ev = (struct inotify_event *) p;
+            p += sizeof(*ev) + ev->len;
+            events++;
+
+            if (ev->mask & IN_Q_OVERFLOW) {
+                overflow = 1;
+                continue;
+            }
+            if (ev->mask & IN_IGNORED) {
+                if (ev->wd >= 0 && ev->wd < wd_capacity) {
+                    free(wd_paths[ev->wd]);
+                    wd_paths[ev->wd] = NULL;
+                }
+                continue;
+            }
+            if (ev->wd < 0 || ev->wd >= wd_capacity || !wd_paths[ev->wd] || ev->len == 0) continue;
+
+            const char *dir = wd_paths[ev->wd];
+            if (snprintf(path, sizeof(path), "%s/%s", strcmp(dir, "/") ? dir : "", ev->name) >=
+                (int) sizeof(path)) {
+                continue;
+            }
+
+            if (ev->mask & IN_ISDIR) {
+                if (ev->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    in_add_tree(path);
+                    deliver(path, EV_DIR, fn, ctx);
+                }
+            } else if (ev->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                deliver(path, EV_CLOSED, fn, ctx);
+            } else if (ev->mask & IN_MODIFY) {
+                deliver(path, EV_MODIFIED, fn, ctx);
+            }
+        }
+    }
+}
+
+/* ================ ORTAK ================ */
+
+int watch_init(const char *root) {
+    snprintf(watch_root, sizeof(watch_root), "%s", root);
+    root_length = strlen(watch_root);
+    while (root_length > 1 && watch_root[root_length - 1] == '/') watch_root[--root_length] = '\0';
+
+    if (fan_init(root) == 0) {
+        mode = WATCH_FANOTIFY;
+    } else if (in_init(root) == 0) {
+        mode = WATCH_INOTIFY;
+    } else {
+        mode = WATCH_NONE;
+    }
+    return mode;
+}
+
+void watch_close(void) {
+    for (int i = 0; i < fs_count; i++) close(filesystems[i].mount_fd);
+    fs_count = 0;
+    for (int i = 0; i < wd_capacity; i++) free(wd_paths[i]);
+    free(wd_paths);
+    wd_paths = NULL;
+    wd_capacity = 0;
+    while (pending_count > 0) pending_remove(pending_count - 1);
+    if (notify_fd >= 0) close(notify_fd);
+    notify_fd = -1;
+    mode = WATCH_NONE;
+}
+
+int watch_fd(void) {
+    return notify_fd;
+}
+
+int watch_dispatch(watch_event_fn fn, void *ctx) {
+    if (mode == WATCH_FANOTIFY) return fan_dispatch(fn, ctx);
+    if (mode == WATCH_INOTIFY) return in_dispatch(fn, ctx);
+    return -1;
+}
+
+int watch_overflowed(void) {
+    int result = overflow;
+    overflow = 0;
+    return result;
+}
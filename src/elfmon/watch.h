@@ -0,0 +1,49 @@
+#ifndef ELFMON_WATCH_H
+#define ELFMON_WATCH_H
+
+#include <time.h>
+
+// Dosya sistemi olay kaynağı. Önce fanotify denenir: her gerçek dosya
+// sistemi FAN_MARK_FILESYSTEM ile işaretlenir, olaylar dizin tanıtıcısı +
+// ad olarak gelir (FAN_REPORT_DFID_NAME) ve yeniden adlandırmalar da
+// (FAN_MOVED_TO) yakalanır. fanotify yoksa ya da yetki yetmiyorsa ağaçtaki
+// her dizine inotify izlemesi eklenir. Sanal dosya sistemleri (/proc,
+// /sys, ...) hiç izlenmez.
+//
+// FAN_MODIFY / IN_MODIFY olayları hemen bildirilmez: dosya WATCH_SETTLE
+// saniye boyunca yazılmazsa ya da kapatılırsa tek bir olay olarak verilir.
+
+#define WATCH_NONE     0
+#define WATCH_FANOTIFY 1
+#define WATCH_INOTIFY  2
+
+#define WATCH_SETTLE   2        // Değişen dosyanın durulma süresi (saniye)
+#define WATCH_PENDING  4096     // Durulmayı bekleyen en fazla dosya
+
+// Değişen dosya ya da yeni gelen dizin (is_dir != 0: alt ağaç taranmalı)
+typedef void (*watch_event_fn)(const char *path, int is_dir, void *ctx);
+
+// root altındaki dosya sistemlerini izlemeye başla; kullanılan kaynağı
+// (WATCH_FANOTIFY / WATCH_INOTIFY), hiçbiri kurulamazsa WATCH_NONE döndürür
+int watch_init(const char *root);
+void watch_close(void);
+
+// poll için dosya tanıtıcısı
+int watch_fd(void);
+
+// Bekleyen olayları oku ve bildir; okunan olay sayısını, hata durumunda -1
+// döndürür
+int watch_dispatch(watch_event_fn fn, void *ctx);
+
+// Durulan değişiklikleri bildir; bir sonraki çağrının en geç ne zaman
+// yapılması gerektiğini (milisaniye, -1: beklenen yok) döndürür
+int watch_flush(time_t now, watch_event_fn fn, void *ctx);
+
+// Olay kaybı oldu mu (kuyruk taştı, izleme limiti doldu)? Okunduğunda
+// sıfırlanır; 1 ise tam tarama ile uzlaştırma gerekir.
+int watch_overflowed(void);
+
+// Dosya sistemi türü izlenmeyecek (sanal) bir tür mü?
+int watch_pseudo_fs(const char *type);
+
+#endif
@@ -1,3 +1,4 @@
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -5,76 +6,286 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <errno.h>
+#include <limits.h>
 #include <elf.h>
-#include <dirent.h>
+#include <setjmp.h>
+#include <sys/mman.h>
 #include <signal.h>
 #include <syslog.h>
 #include <time.h>
+#include <poll.h>
+#include <getopt.h>
+#include "elfmon/watch.h"
+#include "elfmon/stat_cache.h"
+#include "elfmon/walker.h"
+#include "elfmon/log_writer.h"
+#include "elfmon/elf_parse.h"
+#include "elfmon/hash.h"
+#include "elfmon/dup_index.h"
+#include "elfmon/metrics.h"
+#include "elfmon/throttle.h"
+#include "elfmon/checkpoint.h"
+#include "elfmon/path_filter.h"
 
 #define SLEEP_TIME 5
+#define RECONCILE_TIME 3600     // Olay modunda tam tarama aralığı (saniye)
 #define LOG_FILE "/var/log/exe_monitor.log"
+#define PID_FILE "/var/run/elf_monitor.pid"
+#define LOG_MAX_SIZE (64ULL << 20)  // Log dosyası döndürme boyutu
+#define LOG_MAX_AGE 86400           // ve yaşı (saniye)
+#define SAVE_TIME 600           // Durum önbelleğinin diske yazılma aralığı (saniye)
+
+// Sınıflandırma sonucu (stat önbelleğinde saklanır)
+#define ELF_NONE 0
+#define ELF_X64  1
+#define ELF_32   2              // Yalnızca derin analizde
 
 volatile sig_atomic_t running = 1;
+static int deep_analysis = 0;   // -e: mmap ile derin ELF analizi
+static int content_hash = 0;    // -H: ELF içerik özeti (XXH3) ve kopya tespiti
+static int hash_flags = 0;      // -S: HASH_SHA256
 
 void signal_handler(int signum) {
+    (void) signum;
     running = 0;
 }
 
-void analyze_elf64(const char *filepath) {
-    int fd = open(filepath, O_RDONLY);
+// Açık dosyanın başlığını oku: ELF_X64 ya da ELF_NONE
+static int classify_elf(int fd, Elf64_Ehdr *header) {
+    ssize_t n = pread(fd, header, sizeof(*header), 0);
+    if (n > 0) metrics_add(M_BYTES_READ, (uint64_t) n);
+    if (n == sizeof(*header) &&
+        memcmp(header->e_ident, ELFMAG, SELFMAG) == 0 &&
+        header->e_ident[EI_CLASS] == ELFCLASS64) {
+        return ELF_X64;
+    }
+    return ELF_NONE;
+}
+
+// İncelenen dosya ve önbellekteki önceki durumu
+typedef struct {
+    int dirfd;
+    const char *name;               // dirfd'ye göre; file NULL ise tam yol
+    const walk_file_t *file;
+    const struct stat *st;
+    int previous;                   // Önceki sınıflandırma
+    uint64_t previous_hash;         // Önceki içerik özeti (0: yok)
+} target_t;
+
+// Tam yol yalnızca loglanacak ya da kopya dizinine girecek dosya için
+// üretilir
+static const char *target_path(const target_t *t, char *buf, size_t size) {
+    if (!t->file) return t->name;
+    return walk_path(t->file, buf, size) == 0 ? buf : NULL;
+}
+
+// Sonucu önbelleğe yaz ve sınıflandırma geçişini log iş parçacığına
+// gönder (biçimleme, dosya ve syslog orada). Derin analizde info, aksi
+// halde header doludur; özet açıksa digest doludur. İçeriği aynı kalan
+// ELF yeniden loglanmaz; yeni bulunan ELF'in içeriği başka bir dosyada
+// zaten görüldüyse tam kayıt yerine kopya kaydı yazılır, aynı inode'un
+// başka adı (hardlink) hiç yazılmaz.
+static void report(const target_t *t, int result, const Elf64_Ehdr *header,
+                   const elf_info_t *info, const file_hash_t *digest) {
+    log_record_t record;
+    char path[PATH_MAX], first[PATH_MAX];
+    uint64_t hash = digest ? digest->xxh3 : 0;
+
+    stat_cache_store(t->st, result, hash);
+    if (result == ELF_NONE && t->previous == ELF_NONE) return;
+
+    const char *filepath = target_path(t, path, sizeof(path));
+    if (!filepath) return;
+
+    // İçerik değiştiyse eski özetin kaydı bu dosyada kalmaz; yeni özet
+    // loglanmasa da sahiplenilir, dosya kopya dizininden düşmez
+    if (content_hash && t->previous_hash && t->previous_hash != hash) {
+        dup_index_release(t->previous_hash, t->st, filepath);
+    }
+    int dup = hash ? dup_index_claim(hash, t->st, filepath, first, sizeof(first)) : DUP_FIRST;
+
+    // Yalnızca stat bilgisi değişmiş (touch, aynı içerikle yeniden yazma)
+    if (hash && result == t->previous && hash == t->previous_hash) return;
+
+    if (result == ELF_NONE) {
+        metrics_add(M_ELF_GONE, 1);
+        log_record_init(&record, LOG_ELF_GONE, filepath);
+        log_submit(&record);
+        return;
+    }
+
+    uint32_t type = t->previous == ELF_NONE ? LOG_ELF_FOUND : LOG_ELF_CHANGED;
+    if (type == LOG_ELF_FOUND && dup == DUP_KNOWN) return;
+    if (type == LOG_ELF_FOUND && dup == DUP_COPY) type = LOG_ELF_COPY;
+
+    metrics_add(type == LOG_ELF_FOUND ? M_ELF_FOUND : type == LOG_ELF_CHANGED ? M_ELF_CHANGED : M_ELF_COPIES, 1);
+    log_record_init(&record, type, filepath);
+    if (type == LOG_ELF_COPY) {
+        log_record_set_origin(&record, first);
+        if (info) record.elf_class = (uint8_t) info->elf_class;
+    } else if (info) {
+        log_record_set_elf(&record, info);
+    } else {
+        record.entry = header->e_entry;
+        record.shnum = header->e_shnum;
+        record.phnum = header->e_phnum;
+    }
+    if (digest) log_record_set_hash(&record, digest->xxh3, digest->has_sha256 ? digest->sha256 : NULL);
+    log_submit(&record);
+}
+
+// Derin analizde eşlenen dosya okunurken kırpılırsa SIGBUS gelir; o
+// iş parçacığı analizden geri sıçrar
+static __thread sigjmp_buf *bus_jump = NULL;
+
+static void bus_handler(int signum) {
+    if (bus_jump) siglongjmp(*bus_jump, 1);
+    signal(signum, SIG_DFL);
+    raise(signum);
+}
+
+// Dosyayı salt okunur eşle ve program/section başlıklarını, PT_INTERP,
+// DT_NEEDED ve build-id'yi kopyalamadan çözümle. ELF32 dosyalar da
+// sınıflandırılır ve loglanır; özet aynı eşlem üzerinden alınır.
+static void analyze_deep(const target_t *t) {
+    sigjmp_buf jump;
+    elf_info_t info;
+    file_hash_t digest;
+    size_t size = (size_t) t->st->st_size;
+    void *volatile map = NULL;      // sigsetjmp'tan sonra da geçerli olmalı
+
+    throttle_open();
+    int fd = openat(t->dirfd, t->name, O_RDONLY | O_NOFOLLOW | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) return;
+    if (size >= EI_NIDENT) map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map != NULL && map != MAP_FAILED) metrics_add(M_BYTES_MAPPED, size);
+
+    // Eşlenemeyen dosya önbelleğe alınmaz, sonraki taramada yeniden denenir
+    if (map == MAP_FAILED) return;
+    if (map == NULL) {
+        report(t, ELF_NONE, NULL, NULL, NULL);
+        return;
+    }
+
+    if (sigsetjmp(jump, 1) != 0) {
+        bus_jump = NULL;
+        munmap(map, size);
+        return;
+    }
+    bus_jump = &jump;
+
+    int result = ELF_NONE;
+    if (elf_parse(map, size, &info) == 0) result = info.elf_class == ELFCLASS64 ? ELF_X64 : ELF_32;
+    if (result != ELF_NONE && content_hash) {
+        throttle_bytes(size);
+        madvise(map, size, MADV_SEQUENTIAL);
+        hash_buffer(map, size, hash_flags, &digest);
+        metrics_add(M_BYTES_READ, digest.bytes);
+    }
+    report(t, result, NULL, &info, result != ELF_NONE && content_hash ? &digest : NULL);
+
+    bus_jump = NULL;
+    munmap(map, size);
+}
+
+// Yalnızca ELF başlığını oku. Açılamayan ya da okunamayan dosya önbelleğe
+// alınmaz, sonraki taramada yeniden denenir. Özet başlığı okuyan aynı fd
+// üzerinden pread parçalarıyla alınır; byte bütçesinden dosya boyutu
+// okumadan önce düşülür.
+static void analyze_header(const target_t *t) {
+    throttle_open();
+    int fd = openat(t->dirfd, t->name, O_RDONLY | O_NOFOLLOW | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
     if (fd < 0) return;
 
     Elf64_Ehdr header;
-    if (read(fd, &header, sizeof(header)) != sizeof(header)) {
+    file_hash_t digest;
+    throttle_bytes(sizeof(header));
+    int result = classify_elf(fd, &header);
+    int hashed = result != ELF_NONE && content_hash;
+    if (hashed) throttle_bytes((uint64_t) t->st->st_size);
+    if (hashed && hash_fd(fd, hash_flags, &digest) != 0) {
         close(fd);
         return;
     }
+    close(fd);
+    if (hashed) metrics_add(M_BYTES_READ, digest.bytes);
+    report(t, result, &header, NULL, hashed ? &digest : NULL);
+}
 
-    // ELF dosyası kontrolü
-    if (memcmp(header.e_ident, ELFMAG, SELFMAG) == 0 && 
-        header.e_ident[EI_CLASS] == ELFCLASS64) {
-        
-        time_t now = time(NULL);
-        char timestamp[64];
-        strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", localtime(&now));
-
-        // Log dosyasına yazma
-        FILE *log_file = fopen(LOG_FILE, "a");
-        if (log_file) {
-            fprintf(log_file, "[%s] Tespit edilen x64 ELF: %s\n", timestamp, filepath);
-            fprintf(log_file, "Entry Point: 0x%lx\n", header.e_entry);
-            fprintf(log_file, "Section sayisi: %d\n", header.e_shnum);
-            fprintf(log_file, "Program header sayisi: %d\n\n", header.e_phnum);
-            fclose(log_file);
+// Dosyayı yalnızca stat bilgisi değiştiyse aç; yalnızca sınıflandırma
+// geçişleri (yeni ELF, değişen ELF, artık ELF olmayan dosya) loglanır.
+// Dosya dirfd'ye göre name'dir; file NULL ise name zaten tam yoldur.
+// Gezgin stat ettiyse known doludur.
+static void analyze_at(int dirfd, const char *name, const struct stat *known,
+                       const walk_file_t *file) {
+    struct stat st;
+    target_t t = { dirfd, name, file, NULL, ELF_NONE, 0 };
+
+    if (!known) {
+        metrics_add(M_STATS, 1);
+        if (fstatat(dirfd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) return;
+        known = &st;
+    }
+    if (!S_ISREG(known->st_mode)) return;
+    t.st = known;
+    metrics_add(M_FILES, 1);
+
+    int state = stat_cache_check(known, &t.previous, &t.previous_hash);
+    if (state == STAT_UNCHANGED) {
+        metrics_add(M_UNCHANGED, 1);
+        // Değişmemiş ELF yeniden okunmaz; önbellekteki özeti kopya dizinine
+        // girer
+        if (content_hash && t.previous != ELF_NONE && t.previous_hash) {
+            char path[PATH_MAX];
+            const char *filepath = target_path(&t, path, sizeof(path));
+            if (filepath) dup_index_claim(t.previous_hash, known, filepath, NULL, 0);
         }
+        return;
+    }
 
-        // Sistem log'una yazma
-        syslog(LOG_INFO, "X64 ELF tespit edildi: %s", filepath);
+    uint64_t started = metrics_now();
+    metrics_add(M_OPENS, 1);
+    if (deep_analysis) {
+        analyze_deep(&t);
+    } else {
+        analyze_header(&t);
     }
+    metrics_observe(H_FILE, metrics_now() - started);
+}
 
-    close(fd);
+void analyze_elf64(const char *filepath) {
+    analyze_at(AT_FDCWD, filepath, NULL, NULL);
 }
 
-void scan_directory(const char *path) {
-    DIR *dir = opendir(path);
-    if (!dir) return;
-
-    struct dirent *entry;
-    while ((entry = readdir(dir)) != NULL) {
-        if (entry->d_type == DT_REG) { // Regular dosya
-            char filepath[PATH_MAX];
-            snprintf(filepath, PATH_MAX, "%s/%s", path, entry->d_name);
-            analyze_elf64(filepath);
-        }
-        else if (entry->d_type == DT_DIR && 
-                 strcmp(entry->d_name, ".") != 0 && 
-                 strcmp(entry->d_name, "..") != 0) {
-            char newpath[PATH_MAX];
-            snprintf(newpath, PATH_MAX, "%s/%s", path, entry->d_name);
-            scan_directory(newpath);
-        }
+static void on_file(const walk_file_t *file, void *ctx) {
+    (void) ctx;
+    analyze_at(file->dirfd, file->name, file->st, file);
+}
+
+// Gezgin seçenekleri (-t, -x, -C); dizin açmaları da açma bütçesinden düşer
+static walk_options_t walk_options = { 0, 0, &running, NULL, throttle_open, 0 };
+
+// Tarama bütçesi (-O, -B, -P)
+static throttle_options_t throttle_options = { 0, 0, 0, &running };
+
+static void account_walk(const char *path, const walk_stats_t *stats) {
+    metrics_add(M_DIRECTORIES, stats->directories);
+    metrics_add(M_STATS, stats->unknown);
+    metrics_add(M_FILTERED, stats->filtered + stats->excluded_fs);
+    if (stats->duplicates || stats->other_fs) {
+        syslog(LOG_DEBUG, "%s: %llu dizin, %llu dosya, %llu tekrar, %llu diger fs atlandi", path,
+               (unsigned long long) stats->directories, (unsigned long long) stats->files,
+               (unsigned long long) stats->duplicates, (unsigned long long) stats->other_fs);
     }
-    closedir(dir);
+}
+
+void scan_directory(const char *path) {
+    walk_stats_t stats;
+
+    if (walk_tree(path, &walk_options, on_file, NULL, &stats) != 0) return;
+    account_walk(path, &stats);
 }
 
 void daemonize() {
@@ -94,35 +305,351 @@ void daemonize() {
     close(STDERR_FILENO);
 }
 
-int main() {
+// Olay kaynağından gelen değişiklik: yeni dizinin tamamı, dosyanın
+// yalnızca kendisi incelenir
+static void on_event(const char *path, int is_dir, void *ctx) {
+    (void) ctx;
+    metrics_add(M_EVENTS, 1);
+    // Dizinleri gezgin kendisi süzer
+    if (walk_options.filter && !is_dir &&
+        path_filter_verdict(path_filter_start(path)) != FILTER_SCAN) {
+        metrics_add(M_FILTERED, 1);
+        return;
+    }
+    if (is_dir) {
+        scan_directory(path);
+    } else {
+        analyze_elf64(path);
+    }
+}
+
+static const char *cache_file = STAT_CACHE_FILE;
+static const char *filter_file = PATH_FILTER_FILE;
+static char checkpoint_file[PATH_MAX];  // Önbellek dosyasının yanında
+static const char *metrics_socket = METRICS_SOCKET;
+static time_t last_save = 0;
+
+static void on_unfinished(const char *path, void *ctx) {
+    (void) ctx;
+    checkpoint_add(path);
+}
+
+static void seed_copy(uint64_t dev, uint64_t ino, uint64_t hash, void *ctx) {
+    (void) ctx;
+    dup_index_seed(hash, dev, ino);
+}
+
+// Tam tarama: görülmeyen (silinmiş) dosyalar önbellekten atılır; önbellek
+// en fazla SAVE_TIME saniyede bir diske yazılır. Önceki çalışmada kesilen
+// taramanın kontrol noktası bu önbellek nesline aitse tarama kökten değil
+// yarım kalan dizinlerden sürer; kesilen tarama da kontrol noktası bırakır.
+static void full_scan(const char *root) {
+    uint64_t started = metrics_now();
+    walk_stats_t stats;
+    char **dirs = NULL;
+    int walked;
+
+    // Bağlamalar taramalar arasında değişebilir
+    if (walk_options.filter) path_filter_refresh_mounts();
+
+    int resume = checkpoint_load(checkpoint_file, root, stat_cache_generation(), &dirs);
+    unlink(checkpoint_file);
+    if (resume < 0) {
+        stat_cache_begin_pass();
+        // Silinen dosyalar kopya dizininden de düşsün: dizin bu taramada
+        // önbellekteki özetlerden yeniden kurulur
+        if (content_hash) dup_index_clear();
+    }
+
+    walk_options.unfinished = on_unfinished;
+    if (resume < 0) {
+        walked = walk_tree(root, &walk_options, on_file, NULL, &stats);
+    } else {
+        syslog(LOG_INFO, "Yarım kalan tarama %d dizinden sürdürülüyor", resume);
+        // Kesintiden önce incelenen dosyalar yeniden gezilmez; kopya
+        // dizinine önbellekteki özetleriyle girer
+        if (content_hash) stat_cache_for_each(seed_copy, NULL);
+        walked = walk_resume(root, (const char *const *) dirs, (size_t) resume, &walk_options,
+                             on_file, NULL, &stats);
+        checkpoint_free(dirs, resume);
+    }
+    walk_options.unfinished = NULL;
+    if (walked == 0) account_walk(root, &stats);
+
+    // Yarıda kesilen ya da bir dizini okunamayan taramada görülmeyenler
+    // silinmiş sayılmaz
+    if (running) {
+        if (walked != 0) {
+            syslog(LOG_WARNING, "Taranamadı: %s", root);
+        } else if (stats.read_errors) {
+            syslog(LOG_WARNING, "Tarama eksik: %llu dizin okunamadı, silinen dosyalar atılmadı",
+                   (unsigned long long) stats.read_errors);
+        } else {
+            stat_cache_end_pass();
+        }
+        // Tamamlanan taramada okunamayan dizinler sonraki taramada yeniden
+        // denenir; kontrol noktasına yalnızca kesilen tarama yazılır
+        checkpoint_reset();
+        metrics_observe(H_PASS, metrics_now() - started);
+        metrics_add(M_PASSES, 1);
+        metrics_set(G_LAST_PASS, (uint64_t) time(NULL));
+    }
+    metrics_set(G_CACHE_ENTRIES, stat_cache_count());
+    if (content_hash) metrics_set(G_HASH_INDEX, dup_index_count());
+
+    time_t now = time(NULL);
+    if (now - last_save >= SAVE_TIME) {
+        stat_cache_save(cache_file);
+        last_save = now;
+    }
+}
+
+// Eski davranış: her SLEEP_TIME saniyede bir tam tarama
+static void poll_loop(const char *root) {
+    while (running) {
+        full_scan(root);
+        if (running) sleep(SLEEP_TIME);
+    }
+}
+
+// Olay modu: başta bir tam tarama, sonra yalnızca değişen dosyalar.
+// Olay kaybı (kuyruk taşması, izleme limiti) ya da reconcile saniye
+// dolduğunda tam tarama ile uzlaştırılır.
+static void event_loop(const char *root, int reconcile) {
+    struct pollfd pfd = { .fd = watch_fd(), .events = POLLIN };
+    time_t next_scan;
+
+    full_scan(root);
+    next_scan = time(NULL) + reconcile;
+
+    while (running) {
+        time_t now = time(NULL);
+        int timeout = watch_flush(now, on_event, NULL);
+        int until_scan = next_scan > now ? (int) (next_scan - now) * 1000 : 0;
+        if (timeout < 0 || timeout > until_scan) timeout = until_scan;
+
+        int ready = poll(&pfd, 1, timeout);
+        if (ready < 0 && errno != EINTR) break;
+        if (ready > 0 && watch_dispatch(on_event, NULL) < 0) {
+            syslog(LOG_ERR, "Olay kaynağı okunamadı, periyodik taramaya dönülüyor");
+            watch_close();
+            poll_loop(root);
+            return;
+        }
+
+        now = time(NULL);
+        if (watch_overflowed() || now >= next_scan) {
+            full_scan(root);
+            next_scan = time(NULL) + reconcile;
+        }
+    }
+}
+
+static void usage(const char *name) {
+    fprintf(stderr, "Kullanim: %s [-f] [-p] [-r saniye] [-c dosya] [-t n] [-x] [-D] [-e] [-H] [-S]\n"
+                    "       [-m soket] [-O n] [-B n] [-I] [-P] [-C dosya] [kok]\n"
+                    "  -f  Ön planda çalış (daemon olma)\n"
+                    "  -p  Olay izleme yerine %d saniyede bir tam tara\n"
+                    "  -r  Olay modunda uzlaştırma taraması aralığı (varsayılan %d)\n"
+                    "  -c  Durum önbelleği dosyası (varsayılan %s)\n"
+                    "  -t  Tarama iş parçacığı sayısı (varsayılan: CPU sayısı)\n"
+                    "  -x  Kökün dosya sisteminden çıkma (find -xdev gibi)\n"
+                    "  -D  Log kuyruğu dolunca taramayı bekletme, kaydı at\n"
+                    "  -e  Derin analiz: segmentler, interpreter, bağımlılıklar, build-id,\n"
+                    "      section adları; ELF32 dosyalar da loglanır\n"
+                    "  -H  ELF içerik özeti (XXH3): aynı içerik yeniden loglanmaz, kopya ve\n"
+                    "      hardlink'ler tek kez raporlanır\n"
+                    "  -S  Denetim için SHA-256 de hesapla (-H'yi içerir)\n"
+                    "  -m  Prometheus metrikleri için Unix soketi (varsayılan %s,\n"
+                    "      boş: kapalı)\n"
+                    "  -O  Saniyede en çok açılan dosya/dizin (varsayılan sınırsız)\n"
+                    "  -B  Saniyede en çok okunan byte, K/M/G son ekiyle (varsayılan sınırsız)\n"
+                    "  -I  Taramayı IO (IOPRIO_CLASS_IDLE) ve CPU (SCHED_IDLE) boşta\n"
+                    "      önceliğinde çalıştır\n"
+                    "  -P  /proc/pressure/io'ya göre yavaşla: some avg10 %%%.0f üstünde\n"
+                    "      hız düşer, %%%.0f üstünde tarama bekler\n"
+                    "  -C  include/exclude kuralları (varsayılan %s; yoksa yalnızca\n"
+                    "      sanal dosya sistemleri atlanır, boş: süzgeç kapalı)\n",
+            name, SLEEP_TIME, RECONCILE_TIME, STAT_CACHE_FILE, METRICS_SOCKET,
+            THROTTLE_PSI_LOW, THROTTLE_PSI_HIGH, PATH_FILTER_FILE);
+}
+
+// "64M" gibi 1024 tabanlı son ekli sayı
+static uint64_t parse_size(const char *text) {
+    char *end;
+    uint64_t value = strtoull(text, &end, 10);
+
+    switch (*end) {
+    case 'G': case 'g': value <<= 10; /* fall through */
+    case 'M': case 'm': value <<= 10; /* fall through */
+    case 'K': case 'k': value <<= 10; break;
+    default: break;
+    }
+    return value;
+}
+
+int main(int argc, char *argv[]) {
+    int foreground = 0, polling = 0, reconcile = RECONCILE_TIME;
+    log_options_t log_options = { 0, LOG_BLOCK, LOG_MAX_SIZE, LOG_MAX_AGE, 1 };
+    const char *root = "/";
+    char root_path[PATH_MAX];
+    int idle = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "fpr:c:t:xDeHSm:O:B:IPC:")) != -1) {
+        switch (opt) {
+        case 'f': foreground = 1; break;
+        case 'p': polling = 1; break;
+        case 'r': reconcile = atoi(optarg); break;
+        case 'c': cache_file = optarg; break;
+        case 't': walk_options.threads = atoi(optarg); break;
+        case 'x': walk_options.xdev = 1; break;
+        case 'D': log_options.policy = LOG_DROP; break;
+        case 'e': deep_analysis = 1; break;
+        case 'H': content_hash = 1; break;
+        case 'S': content_hash = 1; hash_flags |= HASH_SHA256; break;
+        case 'm': metrics_socket = optarg; break;
+        case 'O': throttle_options.opens_per_sec = strtoull(optarg, NULL, 10); break;
+        case 'B': throttle_options.bytes_per_sec = parse_size(optarg); break;
+        case 'I': idle = 1; break;
+        case 'P': throttle_options.psi = 1; break;
+        case 'C': filter_file = optarg; break;
+        default:
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (optind < argc) root = argv[optind];
+    if (reconcile <= 0) reconcile = RECONCILE_TIME;
+    snprintf(checkpoint_file, sizeof(checkpoint_file), "%s.checkpoint", cache_file);
+
+    // Kök ve kurallar fork'tan önce denetlenir: hata ebeveynin çıkış
+    // kodunda görünür, PID dosyası ve iş parçacıkları geride kalmaz
+    openlog("elf_monitor", LOG_PID | LOG_PERROR, LOG_DAEMON);
+    // daemonize "/"e geçtiğinden göreli kök mutlak yola çevrilir
+    if (!realpath(root, root_path)) {
+        syslog(LOG_ERR, "Kök çözümlenemedi: %s: %m", root);
+        return EXIT_FAILURE;
+    }
+    root = root_path;
+    // Kurallar hatalıysa tarama beklenmedik yerlere yayılmasın diye çıkılır
+    int filter_loaded = *filter_file ? path_filter_load(filter_file) : 0;
+    if (filter_loaded < 0) return EXIT_FAILURE;
+
     // Daemon process oluştur
-    daemonize();
+    if (!foreground) daemonize();
 
-    // Signal handler kayıt
-    signal(SIGTERM, signal_handler);
-    signal(SIGINT, signal_handler);
+    // Signal handler kayıt (SA_RESTART yok: poll sinyalle uyanmalı)
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = signal_handler;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGTERM, &sa, NULL);
+    sigaction(SIGINT, &sa, NULL);
+    if (deep_analysis) {
+        sa.sa_handler = bus_handler;
+        sigaction(SIGBUS, &sa, NULL);
+    }
 
-    // Syslog başlat
-    openlog("elf_monitor", LOG_PID, LOG_DAEMON);
+    // Syslog yeniden açılır: stderr artık kapalı olabilir
+    openlog("elf_monitor", LOG_PID | (foreground ? LOG_PERROR : 0), LOG_DAEMON);
     syslog(LOG_INFO, "ELF monitor başlatıldı");
 
+    // Log iş parçacığı daemonize'dan sonra başlamalı (fork iş parçacıklarını
+    // kopyalamaz)
+    if (log_writer_start(LOG_FILE, &log_options) != 0) {
+        syslog(LOG_ERR, "Log yazıcı başlatılamadı");
+        return EXIT_FAILURE;
+    }
+
+    // Metrik sunucusu da bir iş parçacığıdır; tarama sürerken de yanıt verir
+    if (*metrics_socket && metrics_start(metrics_socket) != 0) {
+        syslog(LOG_WARNING, "Metrik soketi açılamadı: %s", metrics_socket);
+    }
+
+    // Boşta önceliği log ve metrik iş parçacıkları başladıktan sonra ana
+    // iş parçacığına verilir: gezgin iş parçacıkları onu miras alır, log
+    // yazımı ve metrik yanıtları normal öncelikte kalır
+    throttle_init(&throttle_options);
+    if (idle && throttle_set_idle() != 0) {
+        syslog(LOG_WARNING, "Boşta önceliğine geçilemedi: %m");
+    }
+    if (throttle_options.opens_per_sec || throttle_options.bytes_per_sec || throttle_options.psi) {
+        syslog(LOG_INFO, "Tarama bütçesi: %llu açma/s, %llu byte/s, PSI %s",
+               (unsigned long long) throttle_options.opens_per_sec,
+               (unsigned long long) throttle_options.bytes_per_sec,
+               throttle_options.psi ? "açık" : "kapalı");
+    }
+
     // PID dosyası oluştur
-    FILE *pid_file = fopen("/var/run/elf_monitor.pid", "w");
+    FILE *pid_file = foreground ? NULL : fopen(PID_FILE, "w");
     if (pid_file) {
         fprintf(pid_file, "%d", getpid());
         fclose(pid_file);
     }
 
+    if (*filter_file) {
+        walk_options.filter = 1;
+        syslog(LOG_INFO, "Yol süzgeci: %s, %u kural, %u DFA durumu", filter_loaded ? "varsayılan" : filter_file,
+               path_filter_rules(), path_filter_states());
+    }
+
+    // Önceki çalışmanın önbelleği: yalnızca o zamandan beri değişenler loglanır
+    if (stat_cache_init() != 0) {
+        syslog(LOG_ERR, "Durum önbelleği ayrılamadı");
+        return EXIT_FAILURE;
+    }
+    if (stat_cache_load(cache_file) == 0) {
+        syslog(LOG_INFO, "Durum önbelleği yüklendi: %u dosya", stat_cache_count());
+    }
+    if (content_hash) {
+        if (dup_index_init() != 0) {
+            syslog(LOG_ERR, "Kopya dizini ayrılamadı");
+            return EXIT_FAILURE;
+        }
+        hash_init(1);
+        syslog(LOG_INFO, "İçerik özeti: %s", hash_impl());
+    }
+    last_save = time(NULL);
+
     // Ana monitoring döngüsü
-    while (running) {
-        scan_directory("/");  // Root dizinden başla
-        sleep(SLEEP_TIME);    // 5 saniye bekle
+    int source = polling ? WATCH_NONE : watch_init(root);
+    if (source == WATCH_NONE) {
+        if (!polling) syslog(LOG_WARNING, "fanotify/inotify kurulamadı, periyodik taramaya dönülüyor");
+        poll_loop(root);
+    } else {
+        syslog(LOG_INFO, "Olay izleme: %s", source == WATCH_FANOTIFY ? "fanotify" : "inotify");
+        event_loop(root, reconcile);
+        watch_close();
     }
 
     // Temizlik
+    metrics_stop();
+    if (stat_cache_save(cache_file) != 0) {
+        syslog(LOG_WARNING, "Durum önbelleği yazılamadı: %s", cache_file);
+    } else if (checkpoint_pending()) {
+        // Kontrol noktası yalnızca neslini taşıyan önbellekle geçerlidir
+        if (checkpoint_save(checkpoint_file, root, stat_cache_generation()) == 0) {
+            syslog(LOG_INFO, "Yarım kalan tarama kaydedildi: %zu dizin", checkpoint_pending());
+        } else {
+            syslog(LOG_WARNING, "Kontrol noktası yazılamadı: %s", checkpoint_file);
+        }
+    }
+    checkpoint_reset();
+    stat_cache_free();
+    dup_index_free();
+    path_filter_free();
+
+    log_stats_t log_stats;
+    log_writer_stop();
+    log_writer_get_stats(&log_stats);
+    if (log_stats.dropped) {
+        syslog(LOG_WARNING, "Log kuyruğu doluyken %llu kayıt atıldı",
+               (unsigned long long) log_stats.dropped);
+    }
     syslog(LOG_INFO, "ELF monitor durduruldu");
     closelog();
-    unlink("/var/run/elf_monitor.pid");
+    if (!foreground) unlink(PID_FILE);
 
     return EXIT_SUCCESS;
 }
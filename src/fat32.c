@@ -1,8 +1,66 @@
+#include <string.h>
 #include "fat32.h"
-#include "disk_io.h"
+#include "bcache.h"
+#include "fat_cache.h"
 
 // FAT32 boot sektörünü oku
-void read_fat32_boot_sector(uint32_t lba, fat32_boot_sector_t* boot_sector) {
-    // Diskten FAT32 boot sektörünü oku (ilk sektör)
-    read_sectors(lba, (uint8_t*) boot_sector, 1);
+int read_fat32_boot_sector(uint32_t lba, fat32_boot_sector_t* boot_sector) {
+    uint8_t buffer[SECTOR_SIZE];
+
+    // Diskten FAT32 boot sektörünü oku (ilk sektör). Yapı sektörden küçük
+    // olduğu için doğrudan yapının üzerine okumak taşmaya yol açardı.
+    // Önbellek üzerinden okunduğu için tekrar eden mount işlemleri diske inmez.
+    if (bcache_read(lba, buffer, 1) != 0) {
+        return -1;
+    }
+    memcpy(boot_sector, buffer, sizeof(*boot_sector));
+    return 0;
+}
+
+int fat32_volume_setup(uint32_t lba, fat32_volume_t* vol) {
+    const fat32_boot_sector_t* bs = &vol->boot;
+
+    // Yalnızca 512 byte'lık sektörler ve FAT32 (fat_size == 0) destekleniyor
+    if (bs->bytes_per_sector != SECTOR_SIZE || bs->sectors_per_cluster == 0 ||
+        bs->fat_count == 0 || bs->fat_size != 0 || bs->fat_size_32 == 0) {
+        return -1;
+    }
+
+    uint32_t total = bs->total_sectors ? bs->total_sectors : bs->total_sectors_large;
+    uint32_t active_fat = (bs->ext_flags & 0x80) ? (bs->ext_flags & 0x0F) : 0;
+
+    // Bozuk imajda BPB alanlarının 32 bit toplamı taşabilir: aktif FAT
+    // mevcut olmalı, veri alanı ve bölüm 32 bit LBA içinde kalmalı
+    uint64_t data_offset = bs->reserved_sector_count + (uint64_t) bs->fat_count * bs->fat_size_32;
+    if (active_fat >= bs->fat_count || data_offset > total ||
+        (uint64_t) lba + total > 0xFFFFFFFFULL) {
+        return -1;
+    }
+
+    vol->lba = lba;
+    vol->fat_start = lba + bs->reserved_sector_count;
+    vol->fat_sectors = bs->fat_size_32;
+    vol->active_fat = active_fat;
+    vol->data_start = vol->fat_start + bs->fat_count * vol->fat_sectors;
+    vol->sectors_per_cluster = bs->sectors_per_cluster;
+    vol->cluster_size = bs->sectors_per_cluster * SECTOR_SIZE;
+    vol->cluster_count = (total - (vol->data_start - lba)) / bs->sectors_per_cluster;
+    vol->root_cluster = bs->fat32_root_cluster;
+
+    // FAT tablosunun taşıyabileceğinden fazla cluster olamaz
+    uint64_t fat_entries = (uint64_t) vol->fat_sectors * (SECTOR_SIZE / 4) - 2;
+    if (vol->cluster_count > fat_entries) {
+        vol->cluster_count = (uint32_t) fat_entries;
+    }
+    return 0;
+}
+
+int fat32_mount(uint32_t lba, fat32_volume_t* vol) {
+    if (read_fat32_boot_sector(lba, &vol->boot) != 0 || fat32_volume_setup(lba, vol) != 0) {
+        return -1;
+    }
+
+    // Farklı bir bölüm mount edildiyse FAT önbelleği sıfırlanır
+    fat_cache_attach(vol);
+    return 0;
 }
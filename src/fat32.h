@@ -19,12 +19,164 @@ typedef struct {
     uint16_t head_count;        // Başlık sayısı
     uint32_t hidden_sectors;    // Gizli sektörler (genellikle boot sektöründen önceki)
     uint32_t total_sectors_large; // Toplam sektör sayısı (genişletilmiş)
+    uint32_t fat_size_32;       // FAT32'de FAT tablosunun boyutu (sektör olarak)
+    uint16_t ext_flags;         // Bit 7: mirror kapalı, bit 0-3: aktif FAT
+    uint16_t fs_version;        // Dosya sistemi sürümü
     uint32_t fat32_root_cluster;  // Root dizininin başladığı cluster
     uint16_t fs_info_sector;    // FSINFO sektör numarası
     uint16_t backup_boot_sector; // Yedek boot sektörü
 } __attribute__((packed)) fat32_boot_sector_t;
+
+// Diskteki 32 byte'lık dizin girdisi
+typedef struct {
+    uint8_t  name[11];          // 8.3 ad (boşlukla doldurulmuş)
+    uint8_t  attributes;        // Dosya özellikleri
+    uint8_t  nt_flags;          // Bit 3: ad küçük harf, bit 4: uzantı küçük harf
+    uint8_t  create_time_tenth; // Oluşturma zamanı (10 ms)
+    uint16_t create_time;       // Oluşturma saati
+    uint16_t create_date;       // Oluşturma tarihi
+    uint16_t access_date;       // Son erişim tarihi
+    uint16_t cluster_high;      // İlk cluster'ın üst 16 biti
+    uint16_t write_time;        // Son yazma saati
+    uint16_t write_date;        // Son yazma tarihi
+    uint16_t cluster_low;       // İlk cluster'ın alt 16 biti
+    uint32_t file_size;         // Dosya boyutu
+} __attribute__((packed)) fat32_dirent_t;
+
+// Uzun dosya adı (LFN) girdisi
+typedef struct {
+    uint8_t  order;             // Sıra numarası (0x40: son parça)
+    uint16_t name1[5];          // Karakter 1-5 (UCS-2)
+    uint8_t  attributes;        // Her zaman 0x0F
+    uint8_t  type;
+    uint8_t  checksum;          // 8.3 adın sağlama toplamı
+    uint16_t name2[6];          // Karakter 6-11
+    uint16_t cluster;           // Her zaman 0
+    uint16_t name3[2];          // Karakter 12-13
+} __attribute__((packed)) fat32_lfn_entry_t;
 #pragma pack(pop)
 
-void read_fat32_boot_sector(uint32_t lba, fat32_boot_sector_t* boot_sector);
+// Dizin girdisi özellikleri
+#define FAT32_ATTR_READ_ONLY 0x01
+#define FAT32_ATTR_HIDDEN    0x02
+#define FAT32_ATTR_SYSTEM    0x04
+#define FAT32_ATTR_VOLUME_ID 0x08
+#define FAT32_ATTR_DIRECTORY 0x10
+#define FAT32_ATTR_ARCHIVE   0x20
+#define FAT32_ATTR_LFN       0x0F
+
+#define FAT32_DIRENT_END     0x00   // Dizin sonu
+#define FAT32_DIRENT_DELETED 0xE5   // Silinmiş girdi
+
+#define FAT32_MAX_NAME 256          // UTF-8 ad + sonlandırıcı
+
+// FAT girdisi değerleri (üst 4 bit ayrılmıştır)
+#define FAT32_ENTRY_MASK 0x0FFFFFFF
+#define FAT32_FREE       0x00000000
+#define FAT32_BAD        0x0FFFFFF7
+#define FAT32_EOC        0x0FFFFFF8  // Bu değer ve üzeri zincir sonu
+#define FAT32_EOC_MARK   0x0FFFFFFF  // Zincir sonu olarak yazılan değer
+
+// Mount edilmiş bir FAT32 bölümünün hesaplanmış geometrisi
+typedef struct {
+    uint32_t lba;                 // Bölümün başlangıç sektörü
+    fat32_boot_sector_t boot;     // Boot sektörünün kopyası
+    uint32_t fat_start;           // İlk FAT tablosunun sektörü
+    uint32_t fat_sectors;         // Bir FAT kopyasının sektör sayısı
+    uint32_t active_fat;          // Okumalarda kullanılan FAT kopyası
+    uint32_t data_start;          // Cluster 2'nin sektörü
+    uint32_t sectors_per_cluster; // Bir cluster'daki sektör sayısı
+    uint32_t cluster_size;        // Cluster boyutu (byte)
+    uint32_t cluster_count;       // Veri cluster'ı sayısı
+    uint32_t root_cluster;        // Kök dizinin ilk cluster'ı
+} fat32_volume_t;
+
+int read_fat32_boot_sector(uint32_t lba, fat32_boot_sector_t* boot_sector);
+
+// vol->boot içindeki boot sektörünü doğrula ve bölüm geometrisini hesapla
+// (disk erişimi yapmaz)
+int fat32_volume_setup(uint32_t lba, fat32_volume_t* vol);
+
+// Boot sektörünü okuyup bölüm geometrisini hesapla
+int fat32_mount(uint32_t lba, fat32_volume_t* vol);
+
+// Diskin ilk sektörüne bak: FAT boot sektörüyse *lba = 0, MBR ise ilk FAT32
+// (0x0B / 0x0C) bölümünün başlangıcı. Bölüm bulunamazsa -1 döner.
+int fat32_find_partition(const uint8_t* sector, uint32_t* lba);
+
+// Çözümlenmiş dizin girdisi
+typedef struct {
+    char     name[FAT32_MAX_NAME];  // Uzun ad (yoksa 8.3 ad), UTF-8
+    char     short_name[13];        // 8.3 ad ("KERNEL~1.BIN")
+    uint8_t  attributes;            // Dosya özellikleri
+    uint32_t first_cluster;         // İlk cluster
+    uint32_t file_size;             // Dosya boyutu
+    uint32_t dirent_lba;            // 8.3 girdisinin bulunduğu sektör
+    uint16_t dirent_offset;         // Sektör içindeki byte konumu
+} DIR_ENTRY;
+
+// fat32_read_directory sonucu; dizi name == NULL olan girdiyle biter
+typedef struct {
+    char*    name;
+    uint32_t size;
+    uint8_t  attributes;
+} FileInfo;
+
+// Dizin girdisi çözücüsü: LFN parçalarını 8.3 girdisine kadar biriktirir
+typedef struct {
+    uint16_t lfn[261];      // Toplanan UCS-2 karakterler
+    uint8_t  lfn_checksum;  // Beklenen 8.3 sağlama toplamı
+    uint8_t  lfn_expect;    // Beklenen sıradaki parça (0: 8.3 girdisi bekleniyor)
+    uint8_t  lfn_active;    // Bir LFN dizisi toplanıyor mu?
+} fat32_dir_parser_t;
+
+// Dizindeki her girdi için çağrılır; 0 dışı dönüş taramayı durdurur
+typedef int (*fat32_dir_visit_t)(const DIR_ENTRY* entry, void* ctx);
+
+
+static inline uint32_t fat32_cluster_lba(const fat32_volume_t* vol, uint32_t cluster) {
+    return vol->data_start + (cluster - 2) * vol->sectors_per_cluster;
+}
+
+// Geçerli bir veri cluster'ı mı?
+static inline int fat32_valid_cluster(const fat32_volume_t* vol, uint32_t cluster) {
+    return cluster >= 2 && cluster < vol->cluster_count + 2;
+}
+
+/* ================ DİZİN İŞLEMLERİ ================ */
+
+// Ham girdiyi çözümle: 1 girdi tamamlandı, 0 devam, -1 dizin sonu
+void fat32_parser_reset(fat32_dir_parser_t* parser);
+int fat32_parse_dirent(fat32_dir_parser_t* parser, const fat32_dirent_t* raw, DIR_ENTRY* out);
+
+// Dizindeki tüm girdileri gez: 0 tamamlandı, 1 callback durdurdu, -1 hata
+int fat32_walk_directory(const fat32_volume_t* vol, uint32_t cluster,
+                         fat32_dir_visit_t visit, void* ctx);
+
+// Diski mount et (MBR varsa ilk FAT32 bölümü); aynı bölüm zaten mount
+// edilmişse önbellekler korunur
+int fat32_init(void);
+fat32_volume_t* fat32_get_volume(void);
+
+// Yolu ("kernel.c", "/apps/calc.exe") kök dizinden başlayarak çöz
+int find_file(const char* path, DIR_ENTRY* entry);
+
+// Dizin yolunu ilk cluster'ına çevir ("" ya da "/": kök dizin)
+int fat32_resolve_directory(const char* path, uint32_t* cluster);
+
+// Dizini listele; sonuç fat32_free_file_info ile serbest bırakılmalı
+FileInfo* fat32_read_directory(const char* path);
+
+// fat32_list_extension eşleşme kipi
+typedef enum {
+    FAT32_MATCH_EXTENSION,  // Son uzantı, FAT adları gibi büyük/küçük harf duyarsız; O(k)
+    FAT32_MATCH_CONTAINS    // Adın herhangi bir yerinde, harf duyarlı (strstr); O(n), diske inmez
+} fat32_match_t;
+
+// Dizindeki belirli uzantıya (ör. ".exe") sahip dosyaları listele. Her iki
+// kip de dizin indeksinden karşılanır; yalnızca eşleşen adlar kopyalanır
+FileInfo* fat32_list_extension(const char* path, const char* ext, fat32_match_t match);
+
+void fat32_free_file_info(FileInfo* files);
 
 #endif
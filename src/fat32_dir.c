@@ -0,0 +1,358 @@
+#include <stdlib.h>
+#include <string.h>
+#include "fat32.h"
+#include "bcache.h"
+#include "fat_cache.h"
+#include "dir_index.h"
+#include "fat_alloc.h"
+
+#define DIRENTS_PER_SECTOR (SECTOR_SIZE / sizeof(fat32_dirent_t))
+
+// Sistemin mount ettiği bölüm
+static fat32_volume_t volume;
+static int mounted = 0;
+
+/* ================ GİRDİ ÇÖZÜMLEME ================ */
+
+// LFN girdilerinin ait olduğu 8.3 adın sağlama toplamı
+static uint8_t sfn_checksum(const uint8_t name[11]) {
+    uint8_t sum = 0;
+    for (int i = 0; i < 11; i++) {
+        sum = (uint8_t) (((sum & 1) << 7) + (sum >> 1) + name[i]);
+    }
+    return sum;
+}
+
+// 8.3 adı "NAME.EXT" biçimine çevir; lower != 0 ise NT küçük harf bayrakları uygulanır
+static void sfn_to_string(const fat32_dirent_t* raw, char* out, int lower) {
+    int n = 0;
+    for (int i = 0; i < 8 && raw->name[i] != ' '; i++) {
+        char c = (char) ((i == 0 && raw->name[0] == 0x05) ? 0xE5 : raw->name[i]);
+        if (lower && (raw->nt_flags & 0x08) && c >= 'A' && c <= 'Z') c += 'a' - 'A';
+        out[n++] = c;
+    }
+    if (raw->name[8] != ' ') {
+        out[n++] = '.';
+        for (int i = 8; i < 11 && raw->name[i] != ' '; i++) {
+            char c = (char) raw->name[i];
+            if (lower && (raw->nt_flags & 0x10) && c >= 'A' && c <= 'Z') c += 'a' - 'A';
+            out[n++] = c;
+        }
+    }
+    out[n] = '\0';
+}
+
+// UCS-2 uzun adı UTF-8'e çevir
+static void lfn_to_utf8(const uint16_t* lfn, char* out, size_t size) {
+    size_t n = 0;
+    for (int i = 0; lfn[i] != 0x0000 && lfn[i] != 0xFFFF; i++) {
+        uint16_t c = lfn[i];
+        if (c < 0x80) {
+            if (n + 1 >= size) break;
+            out[n++] = (char) c;
+        } else if (c < 0x800) {
+            if (n + 2 >= size) break;
+            out[n++] = (char) (0xC0 | (c >> 6));
+            out[n++] = (char) (0x80 | (c & 0x3F));
+        } else {
+            if (n + 3 >= size) break;
+            out[n++] = (char) (0xE0 | (c >> 12));
+            out[n++] = (char) (0x80 | ((c >> 6) & 0x3F));
+            out[n++] = (char) (0x80 | (c & 0x3F));
+        }
+    }
+    out[n] = '\0';
+}
+
+void fat32_parser_reset(fat32_dir_parser_t* parser) {
+    parser->lfn_active = 0;
+    parser->lfn_expect = 0;
+}
+
+int fat32_parse_dirent(fat32_dir_parser_t* parser, const fat32_dirent_t* raw, DIR_ENTRY* out) {
+    if (raw->name[0] == FAT32_DIRENT_END) {
+        return -1;
+    }
+    if (raw->name[0] == FAT32_DIRENT_DELETED) {
+        fat32_parser_reset(parser);
+        return 0;
+    }
+
+    // Uzun ad parçası: son parça önce gelir, sıra 1'e kadar azalır
+    if ((raw->attributes & 0x3F) == FAT32_ATTR_LFN) {
+        const fat32_lfn_entry_t* lfn = (const fat32_lfn_entry_t*) raw;
+        uint8_t seq = lfn->order & 0x1F;
+
+        // Bozuk imajda sıra 0 ya da 20'den büyük olabilir; lfn dışına yazılmasın
+        if (seq == 0 || seq > 20) {
+            fat32_parser_reset(parser);
+            return 0;
+        }
+        if (lfn->order & 0x40) {
+            parser->lfn_active = 1;
+            parser->lfn_checksum = lfn->checksum;
+            parser->lfn[seq * 13] = 0;
+        } else if (!parser->lfn_active || parser->lfn_expect == 0 || seq != parser->lfn_expect ||
+                   lfn->checksum != parser->lfn_checksum) {
+            fat32_parser_reset(parser);
+            return 0;
+        }
+
+        uint16_t* dst = &parser->lfn[(seq - 1) * 13];
+        memcpy(dst, lfn->name1, sizeof(lfn->name1));
+        memcpy(dst + 5, lfn->name2, sizeof(lfn->name2));
+        memcpy(dst + 11, lfn->name3, sizeof(lfn->name3));
+        parser->lfn_expect = seq - 1;
+        return 0;
+    }
+
+    // Birim etiketi ve "." / ".." girdileri listelenmez
+    if ((raw->attributes & FAT32_ATTR_VOLUME_ID) || raw->name[0] == '.') {
+        fat32_parser_reset(parser);
+        return 0;
+    }
+
+    sfn_to_string(raw, out->short_name, 0);
+    if (parser->lfn_active && parser->lfn_expect == 0 &&
+        sfn_checksum(raw->name) == parser->lfn_checksum) {
+        lfn_to_utf8(parser->lfn, out->name, sizeof(out->name));
+    } else {
+        sfn_to_string(raw, out->name, 1);
+    }
+
+    out->attributes = raw->attributes;
+    out->first_cluster = ((uint32_t) raw->cluster_high << 16) | raw->cluster_low;
+    out->file_size = raw->file_size;
+    fat32_parser_reset(parser);
+    return 1;
+}
+
+/* ================ DİZİN TARAMA ================ */
+
+int fat32_walk_directory(const fat32_volume_t* vol, uint32_t cluster,
+                         fat32_dir_visit_t visit, void* ctx) {
+    fat32_extent_map_t map;
+    fat32_dir_parser_t parser;
+    DIR_ENTRY entry;
+    uint32_t index = 0;
+
+    fat32_parser_reset(&parser);
+
+    while (cluster != 0) {
+        if (fat32_map_chain(vol, cluster, index, &map) != 0) return -1;
+
+        for (uint32_t e = 0; e < map.count; e++) {
+            uint32_t lba = fat32_cluster_lba(vol, map.extents[e].cluster);
+            uint32_t sectors = map.extents[e].count * vol->sectors_per_cluster;
+
+            for (uint32_t s = 0; s < sectors; s++) {
+                // Dizin sektörlerini tek tek değil, parça parça önbelleğe al
+                if (s % BCACHE_BATCH == 0) {
+                    uint32_t left = sectors - s;
+                    bcache_prefetch(lba + s, left < BCACHE_BATCH ? left : BCACHE_BATCH);
+                }
+
+                const fat32_dirent_t* raw = (const fat32_dirent_t*) bcache_pin(lba + s);
+                if (!raw) return -1;
+
+                for (uint32_t i = 0; i < DIRENTS_PER_SECTOR; i++) {
+                    int ret = fat32_parse_dirent(&parser, &raw[i], &entry);
+                    if (ret < 0) {
+                        bcache_unpin(lba + s, 0);
+                        return 0;
+                    }
+                    if (ret == 1) {
+                        entry.dirent_lba = lba + s;
+                        entry.dirent_offset = (uint16_t) (i * sizeof(fat32_dirent_t));
+                        if (visit(&entry, ctx)) {
+                            bcache_unpin(lba + s, 0);
+                            return 1;
+                        }
+                    }
+                }
+                bcache_unpin(lba + s, 0);
+            }
+        }
+
+        index += map.cluster_total;
+        cluster = map.next_cluster;
+    }
+    return 0;
+}
+
+/* ================ MOUNT ================ */
+
+// Sektör bir FAT boot sektörü mü, yoksa MBR mi?
+static int is_boot_sector(const uint8_t* sector) {
+    uint16_t bytes_per_sector;
+    memcpy(&bytes_per_sector, sector + 11, sizeof(bytes_per_sector));
+    return (sector[0] == 0xEB || sector[0] == 0xE9) && bytes_per_sector == SECTOR_SIZE;
+}
+
+int fat32_find_partition(const uint8_t* sector, uint32_t* lba) {
+    *lba = 0;
+    if (is_boot_sector(sector)) return 0;
+
+    // Bölümlenmiş diskte ilk FAT32 (0x0B / 0x0C) bölümünü bul
+    for (int i = 0; i < 4; i++) {
+        const uint8_t* part = sector + 0x1BE + i * 16;
+        if (part[4] == 0x0B || part[4] == 0x0C) {
+            memcpy(lba, part + 8, sizeof(*lba));
+            return 0;
+        }
+    }
+    return -1;
+}
+
+int fat32_init(void) {
+    uint8_t sector[SECTOR_SIZE];
+    uint32_t lba;
+    fat32_volume_t vol;
+
+    // Yapı memcmp ile karşılaştırılacağı için dolgu byte'ları da sıfırlanmalı
+    memset(&vol, 0, sizeof(vol));
+    if (bcache_read(0, sector, 1) != 0) {
+        return -1;
+    }
+
+    if (fat32_find_partition(sector, &lba) != 0 || fat32_mount(lba, &vol) != 0) {
+        return -1;
+    }
+
+    // Aynı bölüm yeniden mount ediliyorsa dizin indeksleri geçerliliğini korur
+    if (!mounted || memcmp(&vol, &volume, sizeof(vol)) != 0) {
+        memcpy(&volume, &vol, sizeof(vol));
+        dir_index_reset();
+        fat_alloc_reset();
+    }
+    mounted = 1;
+    return 0;
+}
+
+fat32_volume_t* fat32_get_volume(void) {
+    return mounted ? &volume : 0;
+}
+
+/* ================ YOL ÇÖZME ================ */
+
+// Yolun bir sonraki bileşenini kopyala; kalan yolu döndür
+static const char* next_component(const char* path, char* part) {
+    size_t n = 0;
+    while (*path == '/') path++;
+    while (*path && *path != '/' && n < FAT32_MAX_NAME - 1) {
+        part[n++] = *path++;
+    }
+    part[n] = '\0';
+    while (*path == '/') path++;
+    return path;
+}
+
+int find_file(const char* path, DIR_ENTRY* entry) {
+    char part[FAT32_MAX_NAME];
+    uint32_t dir;
+
+    if (!mounted && fat32_init() != 0) return -1;
+
+    dir = volume.root_cluster;
+    path = next_component(path, part);
+    if (part[0] == '\0') return -1;
+
+    while (1) {
+        if (dir_index_lookup(&volume, dir, part, entry) != 0) return -1;
+        if (*path == '\0') return 0;
+        if (!(entry->attributes & FAT32_ATTR_DIRECTORY)) return -1;
+
+        // ".." kök dizini 0 ile gösterir
+        dir = entry->first_cluster ? entry->first_cluster : volume.root_cluster;
+        path = next_component(path, part);
+    }
+}
+
+int fat32_resolve_directory(const char* path, uint32_t* cluster) {
+    DIR_ENTRY entry;
+
+    if (!mounted && fat32_init() != 0) return -1;
+
+    while (*path == '/') path++;
+    if (*path == '\0') {
+        *cluster = volume.root_cluster;
+        return 0;
+    }
+    if (find_file(path, &entry) != 0 || !(entry.attributes & FAT32_ATTR_DIRECTORY)) {
+        return -1;
+    }
+    *cluster = entry.first_cluster ? entry.first_cluster : volume.root_cluster;
+    return 0;
+}
+
+/* ================ LİSTELEME ================ */
+
+typedef struct {
+    FileInfo* files;
+    uint32_t count;
+    uint32_t capacity;
+    const char* contains;   // NULL değilse yalnızca bu parçayı içeren adlar
+} list_ctx_t;
+
+static int count_visit(const DIR_ENTRY* entry, void* ctx) {
+    list_ctx_t* list = ctx;
+    if (list->contains && !strstr(entry->name, list->contains)) return 0;
+    list->count++;
+    return 0;
+}
+
+static int fill_visit(const DIR_ENTRY* entry, void* ctx) {
+    list_ctx_t* list = ctx;
+    if (list->contains && !strstr(entry->name, list->contains)) return 0;
+    if (list->count >= list->capacity) return 1;
+    FileInfo* info = &list->files[list->count];
+
+    size_t len = strlen(entry->name) + 1;
+    info->name = malloc(len);
+    if (!info->name) return 1;
+    memcpy(info->name, entry->name, len);
+    info->size = entry->file_size;
+    info->attributes = entry->attributes;
+    list->count++;
+    return 0;
+}
+
+// İndeksten iki geçişte (say + doldur) FileInfo dizisi üret
+static FileInfo* list_directory(const char* path, const char* ext, const char* contains) {
+    uint32_t cluster;
+    list_ctx_t list = { 0, 0, 0, contains };
+
+    if (fat32_resolve_directory(path, &cluster) != 0) return 0;
+    if (dir_index_foreach(&volume, cluster, ext, count_visit, &list) < 0) return 0;
+
+    uint32_t total = list.count;
+    list.files = calloc(total + 1, sizeof(FileInfo));
+    if (!list.files) return 0;
+
+    list.count = 0;
+    list.capacity = total;
+    if (dir_index_foreach(&volume, cluster, ext, fill_visit, &list) != 0 || list.count != total) {
+        fat32_free_file_info(list.files);
+        return 0;
+    }
+    return list.files;
+}
+
+FileInfo* fat32_read_directory(const char* path) {
+    return list_directory(path, 0, 0);
+}
+
+FileInfo* fat32_list_extension(const char* path, const char* ext, fat32_match_t match) {
+    // Parça aramasında uzantı indeksi kullanılamaz ("a.exe.bak"), tüm
+    // girdiler bellekteki indeksten süzülür
+    if (match == FAT32_MATCH_CONTAINS) return list_directory(path, 0, ext);
+    return list_directory(path, ext, 0);
+}
+
+void fat32_free_file_info(FileInfo* files) {
+    if (!files) return;
+    for (FileInfo* f = files; f->name; f++) {
+        free(f->name);
+    }
+    free(files);
+}
@@ -0,0 +1,153 @@
+#include <string.h>
+#include "fat32_file.h"
+#include "bcache.h"
+
+int fat32_open_entry(const DIR_ENTRY* entry, fat32_file_t* file) {
+    fat32_volume_t* vol = fat32_get_volume();
+
+    if (!vol || (entry->attributes & FAT32_ATTR_DIRECTORY)) return -1;
+
+    file->vol = vol;
+    file->first_cluster = entry->first_cluster;
+    file->size = entry->file_size;
+    file->pos = 0;
+    file->map.count = 0;
+    file->map.cluster_total = 0;
+    file->map.start_index = 0;
+    file->map.next_cluster = 0;
+    readahead_init(&file->ra);
+
+    if (file->size > 0 && fat32_map_chain(vol, file->first_cluster, 0, &file->map) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+int fat32_open(const char* path, fat32_file_t* file) {
+    DIR_ENTRY entry;
+    if (find_file(path, &entry) != 0) return -1;
+    return fat32_open_entry(&entry, file);
+}
+
+int fat32_seek(fat32_file_t* file, uint32_t pos) {
+    if (pos > file->size) return -1;
+    file->pos = pos;
+    return 0;
+}
+
+uint32_t fat32_file_cluster_lba(fat32_file_t* file, uint32_t index, uint32_t* run) {
+    fat32_extent_map_t* map = &file->map;
+
+    // İstenen sıra pencerenin ötesindeyse: ardışıksa zincirin devamından,
+    // değilse baştan yeniden eşle
+    if (index < map->start_index || index >= map->start_index + map->cluster_total) {
+        uint32_t cluster, start;
+        if (index >= map->start_index + map->cluster_total && map->next_cluster != 0) {
+            start = map->start_index + map->cluster_total;
+            cluster = fat32_cluster_at(file->vol, map->next_cluster, index - start);
+        } else {
+            cluster = fat32_cluster_at(file->vol, file->first_cluster, index);
+        }
+        if (cluster == 0 || fat32_map_chain(file->vol, cluster, index, map) != 0) return 0;
+    }
+
+    uint32_t offset = index - map->start_index;
+    for (uint32_t e = 0; e < map->count; e++) {
+        if (offset < map->extents[e].count) {
+            if (run) *run = map->extents[e].count - offset;
+            return fat32_cluster_lba(file->vol, map->extents[e].cluster + offset);
+        }
+        offset -= map->extents[e].count;
+    }
+    return 0;
+}
+
+// Önceden okuma penceresini extent'lere bölerek disk kuyruğuna gönder;
+// okuyucu beklemeden devam eder
+static void issue_readahead(fat32_file_t* file, uint32_t start, uint32_t count) {
+    uint32_t spc = file->vol->sectors_per_cluster;
+
+    // Pencere okuyucunun extent penceresini ileri kaydırmasın
+    fat32_extent_map_t saved = file->map;
+
+    while (count > 0) {
+        uint32_t run;
+        uint32_t lba = fat32_file_cluster_lba(file, start, &run);
+        if (lba == 0) break;
+        if (run > count) run = count;
+
+        bcache_readahead_async(lba, run * spc);
+        start += run;
+        count -= run;
+    }
+    file->map = saved;
+}
+
+int32_t fat32_read(fat32_file_t* file, void* buffer, uint32_t len) {
+    const fat32_volume_t* vol = file->vol;
+    uint8_t* out = buffer;
+    uint32_t done = 0;
+
+    if (file->pos >= file->size) return 0;
+    if (len > file->size - file->pos) len = file->size - file->pos;
+    if (len == 0) return 0;
+
+    uint32_t total_clusters = (file->size + vol->cluster_size - 1) / vol->cluster_size;
+    uint32_t first = file->pos / vol->cluster_size;
+    uint32_t last = (file->pos + len - 1) / vol->cluster_size;
+
+    while (done < len) {
+        uint32_t index = file->pos / vol->cluster_size;
+        uint32_t in_cluster = file->pos % vol->cluster_size;
+        uint32_t run;
+
+        uint32_t lba = fat32_file_cluster_lba(file, index, &run);
+        if (lba == 0) return done > 0 ? (int32_t) done : -1;
+
+        // Bu extent'te ardışık kalan byte'lar kadar tek seferde oku
+        uint32_t avail = run * vol->cluster_size - in_cluster;
+        uint32_t chunk = len - done < avail ? len - done : avail;
+        uint32_t sector = lba + in_cluster / SECTOR_SIZE;
+        uint32_t offset = in_cluster % SECTOR_SIZE;
+        uint32_t copied = 0;
+
+        // Sektörün ortasından başlayan kısım
+        if (offset != 0) {
+            uint8_t* data = bcache_pin(sector);
+            if (!data) return -1;
+            copied = SECTOR_SIZE - offset < chunk ? SECTOR_SIZE - offset : chunk;
+            memcpy(out + done, data + offset, copied);
+            bcache_unpin(sector, 0);
+            sector++;
+        }
+
+        // Tam sektörler doğrudan kullanıcı buffer'ına
+        uint32_t whole = (chunk - copied) / SECTOR_SIZE;
+        if (whole > 0) {
+            if (bcache_read(sector, out + done + copied, whole) != 0) return -1;
+            copied += whole * SECTOR_SIZE;
+            sector += whole;
+        }
+
+        // Sondaki yarım sektör
+        if (copied < chunk) {
+            uint8_t* data = bcache_pin(sector);
+            if (!data) return -1;
+            memcpy(out + done + copied, data, chunk - copied);
+            bcache_unpin(sector, 0);
+            copied = chunk;
+        }
+
+        done += chunk;
+        file->pos += chunk;
+    }
+
+    // Okuyucunun önüne yeni pencere gerekiyorsa iste
+    uint32_t start;
+    uint32_t count = readahead_access(&file->ra, first, last, total_clusters,
+                                      vol->sectors_per_cluster, &start);
+    if (count > 0) {
+        issue_readahead(file, start, count);
+    }
+    return (int32_t) done;
+}
@@ -0,0 +1,35 @@
+#ifndef FAT32_FILE_H
+#define FAT32_FILE_H
+
+#include <stdint.h>
+#include "fat32.h"
+#include "fat_cache.h"
+#include "readahead.h"
+
+// Okuma için açılmış dosya. Zincirin bir extent penceresi ve dosyaya ait
+// readahead durumu tutulur; ardışık okumalar önbellekte hazır bulunur.
+typedef struct {
+    const fat32_volume_t* vol;
+    uint32_t first_cluster;     // Dosyanın ilk cluster'ı
+    uint32_t size;              // Dosya boyutu
+    uint32_t pos;               // Okuma konumu
+    fat32_extent_map_t map;     // Geçerli extent penceresi
+    readahead_state_t ra;       // Önceden okuma durumu
+} fat32_file_t;
+
+// Dosyayı yol ile ya da dizin girdisinden aç: 0 başarılı, -1 hata
+int fat32_open(const char* path, fat32_file_t* file);
+int fat32_open_entry(const DIR_ENTRY* entry, fat32_file_t* file);
+
+// En fazla len byte oku; okunan byte sayısını (dosya sonunda 0), hata
+// durumunda -1 döndürür
+int32_t fat32_read(fat32_file_t* file, void* buffer, uint32_t len);
+
+// Okuma konumunu değiştir
+int fat32_seek(fat32_file_t* file, uint32_t pos);
+
+// Dosya içindeki cluster sırasının sektörünü bul; aynı extent'te kaç cluster
+// daha ardışık devam ettiğini *run'a yazar. Bulunamazsa 0 döner.
+uint32_t fat32_file_cluster_lba(fat32_file_t* file, uint32_t index, uint32_t* run);
+
+#endif
@@ -0,0 +1,215 @@
+// mmap tabanlı salt okunur FAT32 imaj erişimi (yalnızca host araçları).
+// Bootloader (freestanding) derlemesinde bu dosya boş derlenir.
+#if defined(__linux__) && __STDC_HOSTED__
+
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "disk_io.h"
+#include "fat32_mmap.h"
+
+#define DIRENTS_PER_SECTOR (SECTOR_SIZE / sizeof(fat32_dirent_t))
+
+/* ================ AÇMA / KAPATMA ================ */
+
+int fat32_image_open(fat32_image_t* img, const char* path) {
+    struct stat st;
+    uint32_t lba;
+
+    memset(img, 0, sizeof(*img));
+    img->fd = open(path, O_RDONLY);
+    if (img->fd < 0) return -1;
+
+    if (fstat(img->fd, &st) != 0 || st.st_size < SECTOR_SIZE) {
+        close(img->fd);
+        return -1;
+    }
+
+    void* base = mmap(0, (size_t) st.st_size, PROT_READ, MAP_SHARED, img->fd, 0);
+    if (base == MAP_FAILED) {
+        close(img->fd);
+        return -1;
+    }
+    img->base = base;
+    img->size = (size_t) st.st_size;
+
+    // Boot sektörü eşlenmiş bellekte okunur; geometri için yalnızca kopyalanır
+    if (fat32_find_partition(img->base, &lba) != 0 || !fat32_image_sector(img, lba)) {
+        fat32_image_close(img);
+        return -1;
+    }
+    img->boot = (const fat32_boot_sector_t*) fat32_image_sector(img, lba);
+    img->vol.boot = *img->boot;
+    if (fat32_volume_setup(lba, &img->vol) != 0) {
+        fat32_image_close(img);
+        return -1;
+    }
+
+    // Aktif FAT imajın içinde olmalı
+    uint64_t fat_end = (uint64_t) img->vol.fat_start + ((uint64_t) img->vol.active_fat + 1) * img->vol.fat_sectors;
+    if (fat_end * SECTOR_SIZE > img->size) {
+        fat32_image_close(img);
+        return -1;
+    }
+    uint32_t fat_lba = (uint32_t) (fat_end - img->vol.fat_sectors);
+    img->fat = (const uint32_t*) fat32_image_sector(img, fat_lba);
+
+    // Meta veri atlayarak okunur; FAT ise zincir izlerken sürekli gerekir
+    fat32_image_advise(img, 0, 0, FAT32_ADVISE_RANDOM);
+    fat32_image_advise(img, fat_lba, img->vol.fat_sectors, FAT32_ADVISE_WILLNEED);
+    return 0;
+}
+
+void fat32_image_close(fat32_image_t* img) {
+    if (img->base) munmap((void*) img->base, img->size);
+    if (img->fd >= 0) close(img->fd);
+    img->base = 0;
+    img->fd = -1;
+}
+
+int fat32_image_advise(const fat32_image_t* img, uint32_t lba, uint32_t sectors, int advice) {
+    static const int advices[] = { MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED };
+    size_t page = (size_t) sysconf(_SC_PAGESIZE);
+    size_t start = (size_t) lba * SECTOR_SIZE;
+    size_t end = sectors ? start + (size_t) sectors * SECTOR_SIZE : img->size;
+
+    if (advice < 0 || advice > FAT32_ADVISE_WILLNEED || start >= img->size) return -1;
+    if (end > img->size) end = img->size;
+
+    // madvise sayfa hizalı adres ister
+    start &= ~(page - 1);
+    return madvise((void*) (img->base + start), end - start, advices[advice]);
+}
+
+/* ================ ADRESLEME ================ */
+
+const uint8_t* fat32_image_sector(const fat32_image_t* img, uint32_t lba) {
+    if (((uint64_t) lba + 1) * SECTOR_SIZE > img->size) return 0;
+    return img->base + (size_t) lba * SECTOR_SIZE;
+}
+
+const uint8_t* fat32_image_cluster(const fat32_image_t* img, uint32_t cluster) {
+    if (!fat32_valid_cluster(&img->vol, cluster)) return 0;
+
+    uint32_t lba = fat32_cluster_lba(&img->vol, cluster);
+    if (((uint64_t) lba + img->vol.sectors_per_cluster) * SECTOR_SIZE > img->size) return 0;
+    return img->base + (size_t) lba * SECTOR_SIZE;
+}
+
+uint32_t fat32_image_next_cluster(const fat32_image_t* img, uint32_t cluster) {
+    if (!fat32_valid_cluster(&img->vol, cluster)) return FAT32_EOC_MARK;
+    return img->fat[cluster] & FAT32_ENTRY_MASK;
+}
+
+/* ================ DİZİNLER ================ */
+
+int fat32_image_walk_directory(const fat32_image_t* img, uint32_t cluster,
+                               fat32_dir_visit_t visit, void* ctx) {
+    fat32_dir_parser_t parser;
+    DIR_ENTRY entry;
+    uint32_t steps = 0;
+
+    fat32_parser_reset(&parser);
+
+    while (cluster < FAT32_EOC) {
+        const fat32_dirent_t* raw = (const fat32_dirent_t*) fat32_image_cluster(img, cluster);
+
+        // Döngüye giren zincir cluster sayısından uzun olamaz
+        if (!raw || ++steps > img->vol.cluster_count) return -1;
+
+        uint32_t count = img->vol.cluster_size / sizeof(fat32_dirent_t);
+        for (uint32_t i = 0; i < count; i++) {
+            int ret = fat32_parse_dirent(&parser, &raw[i], &entry);
+            if (ret < 0) return 0;
+            if (ret == 1) {
+                entry.dirent_lba = fat32_cluster_lba(&img->vol, cluster) + i / DIRENTS_PER_SECTOR;
+                entry.dirent_offset = (uint16_t) ((i % DIRENTS_PER_SECTOR) * sizeof(fat32_dirent_t));
+                if (visit(&entry, ctx)) return 1;
+            }
+        }
+        cluster = fat32_image_next_cluster(img, cluster);
+    }
+    return 0;
+}
+
+typedef struct {
+    const char* name;
+    DIR_ENTRY* out;
+} find_ctx_t;
+
+static int find_visit(const DIR_ENTRY* entry, void* ctx) {
+    find_ctx_t* find = ctx;
+    if (strcasecmp(entry->name, find->name) == 0 || strcasecmp(entry->short_name, find->name) == 0) {
+        *find->out = *entry;
+        return 1;
+    }
+    return 0;
+}
+
+int fat32_image_find(const fat32_image_t* img, const char* path, DIR_ENTRY* entry) {
+    char part[FAT32_MAX_NAME];
+    uint32_t dir = img->vol.root_cluster;
+    find_ctx_t find = { part, entry };
+
+    while (*path == '/') path++;
+    if (*path == '\0') return -1;
+
+    while (*path) {
+        size_t n = strcspn(path, "/");
+        if (n >= sizeof(part)) return -1;
+        memcpy(part, path, n);
+        part[n] = '\0';
+        path += n;
+        while (*path == '/') path++;
+
+        if (fat32_image_walk_directory(img, dir, find_visit, &find) != 1) return -1;
+        if (*path == '\0') return 0;
+        if (!(entry->attributes & FAT32_ATTR_DIRECTORY)) return -1;
+
+        // ".." kök dizini 0 ile gösterir
+        dir = entry->first_cluster ? entry->first_cluster : img->vol.root_cluster;
+    }
+    return -1;
+}
+
+/* ================ DOSYA İÇERİĞİ ================ */
+
+int fat32_image_read_runs(const fat32_image_t* img, const DIR_ENTRY* entry,
+                          fat32_image_run_t run, void* ctx) {
+    uint32_t remaining = entry->file_size;
+    uint32_t cluster = entry->first_cluster;
+    uint32_t steps = 0;
+
+    while (remaining > 0) {
+        const uint8_t* data = fat32_image_cluster(img, cluster);
+        if (!data) return -1;
+
+        // Diskte ardışık cluster'ları tek koşuda topla
+        uint32_t count = 1;
+        uint32_t next = fat32_image_next_cluster(img, cluster);
+        while (next == cluster + count && (uint64_t) count * img->vol.cluster_size < remaining) {
+            count++;
+            next = fat32_image_next_cluster(img, next);
+        }
+        steps += count;
+        if (steps > img->vol.cluster_count) return -1;
+
+        uint64_t run_bytes = (uint64_t) count * img->vol.cluster_size;
+        uint32_t bytes = remaining < run_bytes ? remaining : (uint32_t) run_bytes;
+        if (!fat32_image_cluster(img, cluster + count - 1)) return -1;
+
+        fat32_image_advise(img, fat32_cluster_lba(&img->vol, cluster),
+                           count * img->vol.sectors_per_cluster, FAT32_ADVISE_SEQUENTIAL);
+        if (run(data, bytes, ctx)) return 1;
+
+        remaining -= bytes;
+        cluster = next;
+    }
+    return 0;
+}
+
+#endif
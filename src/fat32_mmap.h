@@ -0,0 +1,58 @@
+#ifndef FAT32_MMAP_H
+#define FAT32_MMAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "fat32.h"
+
+// Host araçları için salt okunur, mmap tabanlı FAT32 imaj erişimi.
+// İmaj tek parça eşlenir; boot sektörü, FAT ve cluster'lar kopyalanmadan
+// doğrudan işaretçi olarak okunur. Sektör önbelleği, FAT önbelleği ve disk
+// katmanı hiç kullanılmaz; bu yüzden önbellekli blok aygıtı yoluna karşı
+// sıfır kopyalı bir referans ölçümü verir. Yalnızca Linux host derlemesinde
+// kullanılabilir.
+
+// fat32_image_advise ipuçları (madvise)
+#define FAT32_ADVISE_NORMAL     0
+#define FAT32_ADVISE_SEQUENTIAL 1   // Dosya içeriği baştan sona okunacak
+#define FAT32_ADVISE_RANDOM     2   // Meta veri (dizin, FAT) atlayarak okunacak
+#define FAT32_ADVISE_WILLNEED   3   // Bölge yakında okunacak, önceden getir
+
+typedef struct {
+    const uint8_t* base;              // İmajın eşlendiği adres
+    size_t   size;                    // İmaj boyutu (byte)
+    int      fd;
+    fat32_volume_t vol;               // Bölüm geometrisi
+    const fat32_boot_sector_t* boot;  // Eşlenmiş boot sektörü
+    const uint32_t* fat;              // Eşlenmiş aktif FAT
+} fat32_image_t;
+
+// Dosyanın diskte bitişik bir parçası; data eşlenmiş belleği gösterir
+typedef int (*fat32_image_run_t)(const uint8_t* data, uint32_t bytes, void* ctx);
+
+// İmajı eşle ve (MBR varsa ilk FAT32 bölümünü) doğrula
+int fat32_image_open(fat32_image_t* img, const char* path);
+void fat32_image_close(fat32_image_t* img);
+
+// [lba, lba + sectors) bölgesi için erişim ipucu ver (sectors == 0: tüm imaj)
+int fat32_image_advise(const fat32_image_t* img, uint32_t lba, uint32_t sectors, int advice);
+
+// Sektör/cluster adresleri; imajın dışındaysa NULL
+const uint8_t* fat32_image_sector(const fat32_image_t* img, uint32_t lba);
+const uint8_t* fat32_image_cluster(const fat32_image_t* img, uint32_t cluster);
+
+// Zincirdeki sonraki cluster (aktif FAT'tan, üst 4 bit maskelenmiş)
+uint32_t fat32_image_next_cluster(const fat32_image_t* img, uint32_t cluster);
+
+// fat32_walk_directory / find_file karşılıkları
+int fat32_image_walk_directory(const fat32_image_t* img, uint32_t cluster,
+                               fat32_dir_visit_t visit, void* ctx);
+int fat32_image_find(const fat32_image_t* img, const char* path, DIR_ENTRY* entry);
+
+// Dosyanın bitişik cluster koşularını sırayla ver (son koşu dosya boyutuna
+// kırpılır). Koşular okunmadan önce sıralı erişim ipucu verilir.
+// 0: tamamlandı, 1: callback durdurdu, -1: bozuk zincir
+int fat32_image_read_runs(const fat32_image_t* img, const DIR_ENTRY* entry,
+                          fat32_image_run_t run, void* ctx);
+
+#endif
@@ -0,0 +1,413 @@
+#include <string.h>
+#include "fat32_write.h"
+#include "fat_cache.h"
+#include "fat_alloc.h"
+#include "dir_index.h"
+#include "bcache.h"
+#include "disk_io.h"
+
+#define DIRENTS_PER_SECTOR (SECTOR_SIZE / sizeof(fat32_dirent_t))
+#define FAT32_DATE_EPOCH   0x0021   // 1980-01-01
+
+static uint8_t buffers[FAT32_WRITE_HANDLES][FAT32_WRITE_MAX_CLUSTER] __attribute__((aligned(16)));
+static uint8_t buffer_used[FAT32_WRITE_HANDLES];
+static fat32_clock_t clock_source = 0;
+static fat32_write_stats_t stats;
+
+void fat32_write_set_clock(fat32_clock_t clock) {
+    clock_source = clock;
+}
+
+/* ================ TAMPON HAVUZU ================ */
+
+static int handle_open(fat32_writer_t* file) {
+    fat32_volume_t* vol = fat32_get_volume();
+
+    memset(file, 0, sizeof(*file));
+    file->slot = -1;
+    if (!vol || vol->cluster_size > FAT32_WRITE_MAX_CLUSTER) return -1;
+
+    for (int i = 0; i < FAT32_WRITE_HANDLES; i++) {
+        if (!buffer_used[i]) {
+            buffer_used[i] = 1;
+            file->slot = (int8_t) i;
+            file->buffer = buffers[i];
+            file->vol = vol;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static void handle_release(fat32_writer_t* file) {
+    if (file->slot >= 0) buffer_used[file->slot] = 0;
+    file->slot = -1;
+    file->buffer = 0;
+}
+
+/* ================ VERİ ================ */
+
+// Yeni ayrılan zinciri dosyaya bağla (boş dosyada ilk cluster olur)
+static void chain_attach(fat32_writer_t* file, uint32_t cluster) {
+    if (file->first_cluster == 0) file->first_cluster = cluster;
+    file->meta_dirty = 1;
+}
+
+// Sektörleri önbelleği atlayarak yaz; eski kopyalar önbellekten atılır
+static int write_run(const fat32_volume_t* vol, uint32_t cluster, const uint8_t* data, uint32_t count) {
+    uint32_t lba = fat32_cluster_lba(vol, cluster);
+    uint32_t sectors = count * vol->sectors_per_cluster;
+
+    if (write_sectors(lba, data, sectors) != 0) return -1;
+    bcache_discard(lba, sectors);
+    stats.data_commands++;
+    return 0;
+}
+
+// Tamponu (tam ya da yarım) cluster'ına yaz; cluster'ı yoksa şimdi ayrılır
+static int flush_buffer(fat32_writer_t* file) {
+    const fat32_volume_t* vol = file->vol;
+
+    if (file->buffered == 0) return 0;
+
+    if (file->buffer_cluster == 0) {
+        uint32_t cluster = fat_alloc_chain(vol, 1, file->last_cluster);
+        if (cluster == 0) return -1;
+        chain_attach(file, cluster);
+        file->buffer_cluster = cluster;
+        file->last_cluster = cluster;
+    }
+
+    // Cluster'ın dosya sonundan sonraki kısmı sıfırlanır
+    memset(file->buffer + file->buffered, 0, vol->cluster_size - file->buffered);
+    if (write_run(vol, file->buffer_cluster, file->buffer, 1) != 0) return -1;
+    file->buffer_dirty = 0;
+
+    // Dolan cluster bir daha yazılmaz; sıradaki veri yeni cluster'a gider
+    if (file->buffered == vol->cluster_size) {
+        file->buffered = 0;
+        file->buffer_cluster = 0;
+        stats.clusters++;
+    } else {
+        stats.tail_writes++;
+    }
+    return 0;
+}
+
+// Tampon boşken gelen tam cluster'ları tek ayırmayla zincire ekle ve
+// bitişik koşular halinde doğrudan kullanıcı verisinden yaz
+static int write_direct(fat32_writer_t* file, const uint8_t* data, uint32_t clusters) {
+    const fat32_volume_t* vol = file->vol;
+    uint32_t cluster = fat_alloc_chain(vol, clusters, file->last_cluster);
+    uint32_t done = 0;
+
+    if (cluster == 0) return -1;
+    chain_attach(file, cluster);
+
+    while (done < clusters) {
+        uint32_t start = cluster;
+        uint32_t run = 1;
+        uint32_t next;
+
+        for (;;) {
+            if (fat_cache_get(vol, cluster, &next) != 0) return -1;
+            if (done + run == clusters || next != cluster + 1) break;
+            cluster = next;
+            run++;
+        }
+
+        if (write_run(vol, start, data, run) != 0) return -1;
+        file->last_cluster = cluster;
+        data += run * vol->cluster_size;
+        done += run;
+        cluster = next;
+    }
+    stats.clusters += clusters;
+    stats.direct_clusters += clusters;
+    return 0;
+}
+
+int32_t fat32_write(fat32_writer_t* file, const void* data, uint32_t len) {
+    const uint8_t* src = data;
+    uint32_t cluster_size;
+    uint32_t written = 0;
+
+    if (file->slot < 0) return -1;
+    cluster_size = file->vol->cluster_size;
+
+    // FAT32'de dosya boyutu 32 bite sığmalı
+    if (len > 0xFFFFFFFFu - file->size) return -1;
+
+    while (written < len) {
+        uint32_t left = len - written;
+
+        if (file->buffered == 0 && left >= cluster_size) {
+            uint32_t clusters = left / cluster_size;
+            if (write_direct(file, src + written, clusters) != 0) break;
+            written += clusters * cluster_size;
+            file->size += clusters * cluster_size;
+            continue;
+        }
+
+        uint32_t n = cluster_size - file->buffered;
+        if (n > left) n = left;
+        memcpy(file->buffer + file->buffered, src + written, n);
+        file->buffered += n;
+        file->buffer_dirty = 1;
+        file->meta_dirty = 1;
+        written += n;
+        file->size += n;
+
+        if (file->buffered == cluster_size && flush_buffer(file) != 0) break;
+    }
+
+    stats.bytes += written;
+    if (written == 0 && len > 0) return -1;
+    return (int32_t) written;
+}
+
+/* ================ DİZİN GİRDİSİ ================ */
+
+static int sfn_char_valid(char c) {
+    return (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+           (c != '\0' && strchr("!#$%&'()-@^_`{}~", c) != 0);
+}
+
+// Adı 8.3 girdisine çevir. Tamamı küçük harf olan ad/uzantı NT bayraklarıyla
+// korunur; karışık harfli ya da sığmayan adlar LFN gerektirdiği için -1 döner.
+static int make_sfn(const char* name, uint8_t sfn[11], uint8_t* nt_flags) {
+    const char* dot = strrchr(name, '.');
+    size_t base = dot ? (size_t) (dot - name) : strlen(name);
+    size_t ext = dot ? strlen(dot + 1) : 0;
+    int lower[2] = { 0, 0 };
+    int upper[2] = { 0, 0 };
+
+    if (base == 0 || base > 8 || ext > 3 || (dot && ext == 0)) return -1;
+
+    memset(sfn, ' ', 11);
+    for (size_t i = 0; i < base + ext; i++) {
+        int part = i >= base;
+        char c = part ? dot[1 + i - base] : name[i];
+
+        if (c >= 'a' && c <= 'z') {
+            lower[part] = 1;
+            c = (char) (c - ('a' - 'A'));
+        } else if (c >= 'A' && c <= 'Z') {
+            upper[part] = 1;
+        }
+        if (!sfn_char_valid(c)) return -1;
+        sfn[part ? 8 + i - base : i] = (uint8_t) c;
+    }
+
+    if ((lower[0] && upper[0]) || (lower[1] && upper[1])) return -1;
+    *nt_flags = (uint8_t) ((lower[0] ? 0x08 : 0) | (lower[1] ? 0x10 : 0));
+    return 0;
+}
+
+// Yolu dizin ve ad olarak ayır; dizinin ilk cluster'ını çöz
+static int split_path(const char* path, uint32_t* dir_cluster, const char** name) {
+    char parent[FAT32_MAX_NAME];
+    const char* slash = strrchr(path, '/');
+    size_t n = slash ? (size_t) (slash - path) : 0;
+
+    if (n >= sizeof(parent)) return -1;
+    memcpy(parent, path, n);
+    parent[n] = '\0';
+
+    *name = slash ? slash + 1 : path;
+    if (**name == '\0') return -1;
+    return fat32_resolve_directory(parent, dir_cluster);
+}
+
+// Dizinde boş (hiç kullanılmamış ya da silinmiş) bir girdi bul; dizin
+// doluysa zincire sıfırlanmış yeni bir cluster eklenir
+static int find_free_slot(fat32_writer_t* file, uint32_t* lba, uint16_t* offset) {
+    const fat32_volume_t* vol = file->vol;
+    uint32_t cluster = file->dir_cluster;
+    uint32_t last = cluster;
+    uint32_t steps = 0;
+
+    while (fat32_valid_cluster(vol, cluster)) {
+        uint32_t base = fat32_cluster_lba(vol, cluster);
+
+        for (uint32_t s = 0; s < vol->sectors_per_cluster; s++) {
+            const uint8_t* sector = bcache_pin(base + s);
+            if (!sector) return -1;
+
+            for (uint32_t i = 0; i < DIRENTS_PER_SECTOR; i++) {
+                uint8_t first = sector[i * sizeof(fat32_dirent_t)];
+                if (first == FAT32_DIRENT_END || first == FAT32_DIRENT_DELETED) {
+                    bcache_unpin(base + s, 0);
+                    *lba = base + s;
+                    *offset = (uint16_t) (i * sizeof(fat32_dirent_t));
+                    return 0;
+                }
+            }
+            bcache_unpin(base + s, 0);
+        }
+
+        // Döngüye girmiş bozuk zincirlere karşı koruma
+        if (++steps > vol->cluster_count) return -1;
+
+        last = cluster;
+        if (fat_cache_get(vol, cluster, &cluster) != 0) return -1;
+    }
+
+    // Yeni cluster FAT'e bağlanmadan önce sıfırlanmış olarak diske yazılır
+    cluster = fat_alloc_chain(vol, 1, last);
+    if (cluster == 0) return -1;
+    memset(file->buffer, 0, vol->cluster_size);
+    if (write_run(vol, cluster, file->buffer, 1) != 0) return -1;
+
+    *lba = fat32_cluster_lba(vol, cluster);
+    *offset = 0;
+    return 0;
+}
+
+// Boyutu, ilk cluster'ı ve yazma zamanını girdiye işle (önbellekte kirli)
+static int update_dirent(fat32_writer_t* file) {
+    uint8_t* sector = bcache_pin(file->dirent_lba);
+    if (!sector) return -1;
+
+    fat32_dirent_t* raw = (fat32_dirent_t*) (sector + file->dirent_offset);
+    raw->cluster_high = (uint16_t) (file->first_cluster >> 16);
+    raw->cluster_low = (uint16_t) (file->first_cluster & 0xFFFF);
+    raw->file_size = file->size;
+    raw->attributes |= FAT32_ATTR_ARCHIVE;
+
+    if (clock_source) {
+        uint16_t date, time;
+        clock_source(&date, &time);
+        raw->write_date = date;
+        raw->write_time = time;
+        raw->access_date = date;
+    }
+
+    bcache_unpin(file->dirent_lba, 1);
+    dir_index_invalidate(file->dir_cluster);
+    return 0;
+}
+
+/* ================ AÇMA / KAPATMA ================ */
+
+int fat32_create(const char* path, fat32_writer_t* file) {
+    DIR_ENTRY entry;
+    const char* name;
+    uint8_t sfn[11];
+    uint8_t nt_flags;
+    uint16_t date = FAT32_DATE_EPOCH;
+    uint16_t time = 0;
+
+    if (handle_open(file) != 0) return -1;
+
+    if (find_file(path, &entry) == 0 || split_path(path, &file->dir_cluster, &name) != 0 ||
+        make_sfn(name, sfn, &nt_flags) != 0 ||
+        find_free_slot(file, &file->dirent_lba, &file->dirent_offset) != 0) {
+        handle_release(file);
+        return -1;
+    }
+
+    uint8_t* sector = bcache_pin(file->dirent_lba);
+    if (!sector) {
+        handle_release(file);
+        return -1;
+    }
+
+    // Boş dosyanın girdisi cluster göstermez; kesintide bile tutarlıdır
+    fat32_dirent_t* raw = (fat32_dirent_t*) (sector + file->dirent_offset);
+    if (clock_source) clock_source(&date, &time);
+    memset(raw, 0, sizeof(*raw));
+    memcpy(raw->name, sfn, sizeof(raw->name));
+    raw->attributes = FAT32_ATTR_ARCHIVE;
+    raw->nt_flags = nt_flags;
+    raw->create_time = time;
+    raw->create_date = date;
+    raw->access_date = date;
+    raw->write_time = time;
+    raw->write_date = date;
+    bcache_unpin(file->dirent_lba, 1);
+
+    dir_index_invalidate(file->dir_cluster);
+    file->meta_dirty = 1;
+    return 0;
+}
+
+int fat32_open_append(const char* path, fat32_writer_t* file) {
+    DIR_ENTRY entry;
+    const char* name;
+
+    if (handle_open(file) != 0) return -1;
+
+    if (find_file(path, &entry) != 0 ||
+        (entry.attributes & (FAT32_ATTR_DIRECTORY | FAT32_ATTR_READ_ONLY)) ||
+        split_path(path, &file->dir_cluster, &name) != 0) {
+        handle_release(file);
+        return -1;
+    }
+
+    const fat32_volume_t* vol = file->vol;
+    file->dirent_lba = entry.dirent_lba;
+    file->dirent_offset = entry.dirent_offset;
+    file->first_cluster = entry.first_cluster;
+    file->size = entry.file_size;
+
+    // Boyutu 0 olup cluster gösteren girdilerin zinciri bırakılır
+    if (file->size == 0) {
+        if (file->first_cluster != 0) {
+            if (fat_free_chain(vol, file->first_cluster) != 0) {
+                handle_release(file);
+                return -1;
+            }
+            file->first_cluster = 0;
+            file->meta_dirty = 1;
+        }
+        return 0;
+    }
+
+    uint32_t clusters = (file->size + vol->cluster_size - 1) / vol->cluster_size;
+    file->last_cluster = fat32_cluster_at(vol, file->first_cluster, clusters - 1);
+    if (file->last_cluster == 0) {
+        handle_release(file);
+        return -1;
+    }
+
+    // Yarım kalan son cluster tampona alınır ve doldukça yeniden yazılır
+    file->buffered = file->size % vol->cluster_size;
+    if (file->buffered > 0) {
+        file->buffer_cluster = file->last_cluster;
+        if (bcache_read(fat32_cluster_lba(vol, file->last_cluster), file->buffer,
+                        vol->sectors_per_cluster) != 0) {
+            handle_release(file);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int fat32_sync(fat32_writer_t* file) {
+    if (file->slot < 0) return -1;
+
+    // 1. Veri: yarım cluster diske
+    if (file->buffer_dirty && flush_buffer(file) != 0) return -1;
+    if (!file->meta_dirty) return 0;
+
+    // 2. FAT: biriken girdiler tüm FAT kopyalarına tek geçişte
+    if (fat_cache_flush(file->vol) != 0) return -1;
+
+    // 3. Dizin girdisi, ardından FSINFO; ikisi de önbellekten birlikte iner
+    if (update_dirent(file) != 0 || fat_alloc_sync(file->vol) != 0) return -1;
+
+    file->meta_dirty = 0;
+    stats.syncs++;
+    return 0;
+}
+
+int fat32_close(fat32_writer_t* file) {
+    int result = fat32_sync(file);
+    handle_release(file);
+    return result;
+}
+
+void fat32_write_get_stats(fat32_write_stats_t* out) {
+    *out = stats;
+}
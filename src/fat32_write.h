@@ -0,0 +1,70 @@
+#ifndef FAT32_WRITE_H
+#define FAT32_WRITE_H
+
+#include <stdint.h>
+#include "fat32.h"
+
+// Yazma için açılmış dosya (yalnızca sona ekleme). Veri açık dosyaya ait bir
+// cluster tamponunda biriktirilir ve diske yalnızca tam cluster'lar halinde
+// gider; tampondan büyük yazmalar tampon atlanarak bitişik koşular halinde
+// doğrudan yazılır. FAT değişiklikleri FAT önbelleğinde birikir ve tüm FAT
+// kopyalarına tek geçişte yazılır. Dizin girdisindeki boyut/zaman ve FSINFO
+// yalnızca fat32_sync/fat32_close'da güncellenir. Sıra her zaman
+// veri -> FAT -> dizin girdisidir: kesinti anında girdi hiçbir zaman diske
+// inmemiş bir cluster'ı ya da veriyi göstermez.
+//
+// Tamponlar statik bir havuzdan alınır; bootloader'da da malloc gerekmez.
+
+#define FAT32_WRITE_HANDLES     2       // Aynı anda yazmaya açık dosya sayısı
+#define FAT32_WRITE_MAX_CLUSTER 32768   // Desteklenen en büyük cluster (byte)
+
+// FAT tarih/saat kaynağı; NULL ise yeni dosyalar 1980-01-01 00:00 alır ve
+// var olan dosyaların zamanı değişmez
+typedef void (*fat32_clock_t)(uint16_t* date, uint16_t* time);
+
+typedef struct {
+    const fat32_volume_t* vol;
+    uint32_t dir_cluster;       // Girdinin bulunduğu dizin (indeks geçersizleme)
+    uint32_t dirent_lba;        // 8.3 girdisinin sektörü
+    uint16_t dirent_offset;     // Sektör içindeki byte konumu
+    uint32_t first_cluster;     // Dosyanın ilk cluster'ı (boş dosyada 0)
+    uint32_t last_cluster;      // Zincirin diskteki son cluster'ı
+    uint32_t size;              // Dosya boyutu (tampondakiler dahil)
+    uint8_t* buffer;            // Son (yarım) cluster'ın tamponu
+    uint32_t buffered;          // Tampondaki byte sayısı
+    uint32_t buffer_cluster;    // Tamponun diskteki cluster'ı (henüz yoksa 0)
+    uint8_t  buffer_dirty;      // Tampon diske yazılmadı
+    uint8_t  meta_dirty;        // Boyut/zincir girdiye yazılmadı
+    int8_t   slot;              // Tampon havuzundaki yer (-1: kapalı)
+} fat32_writer_t;
+
+typedef struct {
+    uint64_t bytes;             // fat32_write ile alınan byte
+    uint64_t clusters;          // Diske yazılan tam cluster
+    uint64_t direct_clusters;   // Tampon atlanarak doğrudan yazılan cluster
+    uint64_t tail_writes;       // Sync sırasında yazılan yarım cluster
+    uint64_t data_commands;     // Veri için gönderilen disk komutu
+    uint64_t syncs;             // Girdiyi güncelleyen sync sayısı
+} fat32_write_stats_t;
+
+void fat32_write_set_clock(fat32_clock_t clock);
+
+// Boş dosya oluştur (yalnızca 8.3 ad; dosya varsa -1)
+int fat32_create(const char* path, fat32_writer_t* file);
+
+// Var olan dosyayı sonuna eklemek için aç
+int fat32_open_append(const char* path, fat32_writer_t* file);
+
+// Dosyanın sonuna len byte ekle; yazılan byte sayısını, hata durumunda -1
+// döndürür. Veri sync'e kadar diske tam olarak inmiş olmayabilir.
+int32_t fat32_write(fat32_writer_t* file, const void* data, uint32_t len);
+
+// Tamponu, FAT'i, dizin girdisini ve FSINFO'yu bu sırayla diske yaz
+int fat32_sync(fat32_writer_t* file);
+
+// Sync et ve tamponu havuza geri ver
+int fat32_close(fat32_writer_t* file);
+
+void fat32_write_get_stats(fat32_write_stats_t* stats);
+
+#endif
@@ -0,0 +1,237 @@
+#include <string.h>
+#include "fat_alloc.h"
+#include "fat_cache.h"
+#include "fsinfo.h"
+#include "bcache.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define BITMAP_WORDS (FAT_ALLOC_MAX_CLUSTERS / 64)
+#define SCAN_SECTORS 64   // Mount taramasında tek seferde okunan FAT sektörü
+
+static uint64_t bitmap[BITMAP_WORDS] __attribute__((aligned(16)));
+static uint32_t bitmap_limit = 0;   // İlk geçersiz cluster (cluster_count + 2)
+static uint32_t scan_buffer[SCAN_SECTORS * SECTOR_SIZE / 4];
+static int ready = 0;
+
+static fat_alloc_stats_t stats;
+
+/* ================ BITMAP İŞLEMLERİ ================ */
+
+static inline int bit_test(uint32_t c) {
+    return (bitmap[c >> 6] >> (c & 63)) & 1;
+}
+
+static inline void bit_set(uint32_t c) {
+    bitmap[c >> 6] |= 1ull << (c & 63);
+}
+
+static inline void bit_clear(uint32_t c) {
+    bitmap[c >> 6] &= ~(1ull << (c & 63));
+}
+
+// start'tan itibaren ilk boş cluster (yoksa bitmap_limit)
+static uint32_t find_free(uint32_t start) {
+    if (start >= bitmap_limit) return bitmap_limit;
+
+    uint32_t w = start >> 6;
+    uint64_t word = ~bitmap[w] & (~0ull << (start & 63));
+    if (word) return (w << 6) + (uint32_t) __builtin_ctzll(word);
+    w++;
+
+    uint32_t words = (bitmap_limit + 63) >> 6;
+#ifdef __SSE2__
+    // Tamamen dolu 128 bitlik blokları tek karşılaştırmayla atla
+    if ((w & 1) && w < words) {
+        if (~bitmap[w]) return (w << 6) + (uint32_t) __builtin_ctzll(~bitmap[w]);
+        w++;
+    }
+    const __m128i ones = _mm_set1_epi32(-1);
+    while (w + 2 <= words) {
+        __m128i block = _mm_load_si128((const __m128i*) &bitmap[w]);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(block, ones)) != 0xFFFF) break;
+        w += 2;
+    }
+#endif
+    for (; w < words; w++) {
+        if (~bitmap[w]) {
+            uint32_t c = (w << 6) + (uint32_t) __builtin_ctzll(~bitmap[w]);
+            return c < bitmap_limit ? c : bitmap_limit;
+        }
+    }
+    return bitmap_limit;
+}
+
+// start'tan itibaren ilk dolu cluster (yoksa bitmap_limit)
+static uint32_t find_used(uint32_t start) {
+    if (start >= bitmap_limit) return bitmap_limit;
+
+    uint32_t w = start >> 6;
+    uint64_t word = bitmap[w] & (~0ull << (start & 63));
+    uint32_t words = (bitmap_limit + 63) >> 6;
+
+    while (!word) {
+        if (++w >= words) return bitmap_limit;
+        word = bitmap[w];
+    }
+    uint32_t c = (w << 6) + (uint32_t) __builtin_ctzll(word);
+    return c < bitmap_limit ? c : bitmap_limit;
+}
+
+// [from, to) aralığında en az count uzunlukta ilk boş koşu; bulunamazsa
+// en uzun koşu *best_start / *best_len ile bildirilir
+static uint32_t find_run(uint32_t from, uint32_t to, uint32_t count,
+                         uint32_t* best_start, uint32_t* best_len) {
+    uint32_t c = find_free(from);
+    while (c < to) {
+        uint32_t end = find_used(c);
+        if (end > to) end = to;
+        if (end - c >= count) return c;
+        if (end - c > *best_len) {
+            *best_start = c;
+            *best_len = end - c;
+        }
+        c = find_free(end);
+    }
+    return 0;
+}
+
+/* ================ GENEL FONKSİYONLAR ================ */
+
+int fat_alloc_init(const fat32_volume_t* vol) {
+    fat32_fsinfo_t fsinfo;
+    uint32_t limit = vol->cluster_count + 2;
+
+    if (limit > FAT_ALLOC_MAX_CLUSTERS) return -1;
+
+    // Bitmap sınırının ötesi kullanımda sayılır; arama oraya taşmaz
+    memset(bitmap, 0xFF, sizeof(bitmap));
+    bitmap_limit = limit;
+    stats.free_count = 0;
+
+    // FAT'i büyük parçalar halinde sırayla oku
+    uint32_t entries_per_sector = SECTOR_SIZE / 4;
+    uint32_t needed = (limit + entries_per_sector - 1) / entries_per_sector;
+    uint32_t fat_lba = vol->fat_start + vol->active_fat * vol->fat_sectors;
+
+    for (uint32_t sector = 0; sector < needed; sector += SCAN_SECTORS) {
+        uint32_t n = needed - sector < SCAN_SECTORS ? needed - sector : SCAN_SECTORS;
+        if (read_sectors(fat_lba + sector, (uint8_t*) scan_buffer, n) != 0) return -1;
+
+        uint32_t base = sector * entries_per_sector;
+        for (uint32_t i = 0; i < n * entries_per_sector && base + i < limit; i++) {
+            uint32_t c = base + i;
+            if (c >= 2 && (scan_buffer[i] & FAT32_ENTRY_MASK) == FAT32_FREE) {
+                bit_clear(c);
+                stats.free_count++;
+            }
+        }
+    }
+
+    // FSINFO ipucu geçerliyse aramalar oradan başlar
+    stats.next_free = 2;
+    stats.fsinfo_free = FSINFO_UNKNOWN;
+    if (read_fsinfo(vol->lba, &vol->boot, &fsinfo) == 0) {
+        stats.fsinfo_free = fsinfo.free_count;
+        if (fsinfo.next_free >= 2 && fsinfo.next_free < limit) {
+            stats.next_free = fsinfo.next_free;
+        }
+    }
+
+    ready = 1;
+    return 0;
+}
+
+// [start, start + count) koşusunu kullanımda işaretle ve zincire bağla
+static int claim_run(const fat32_volume_t* vol, uint32_t start, uint32_t count, uint32_t* tail) {
+    for (uint32_t c = start; c < start + count; c++) {
+        bit_set(c);
+        if (*tail != 0 && fat_cache_set(vol, *tail, c) != 0) return -1;
+        *tail = c;
+    }
+    if (fat_cache_set(vol, *tail, FAT32_EOC_MARK) != 0) return -1;
+
+    stats.free_count -= count;
+    stats.allocations += count;
+    stats.next_free = start + count < bitmap_limit ? start + count : 2;
+    return 0;
+}
+
+void fat_alloc_reset(void) {
+    ready = 0;
+}
+
+uint32_t fat_alloc_chain(const fat32_volume_t* vol, uint32_t count, uint32_t prev_cluster) {
+    uint32_t first = 0;
+    uint32_t tail = prev_cluster;
+
+    if (!ready && fat_alloc_init(vol) != 0) return 0;
+    if (count == 0 || count > stats.free_count) return 0;
+
+    // Eklemede önce dosyanın son cluster'ının hemen arkası denenir
+    if (prev_cluster != 0 && prev_cluster + 1 < bitmap_limit && !bit_test(prev_cluster + 1)) {
+        uint32_t end = find_used(prev_cluster + 1);
+        uint32_t take = end - (prev_cluster + 1);
+        if (take > count) take = count;
+        if (claim_run(vol, prev_cluster + 1, take, &tail) != 0) return 0;
+        first = prev_cluster + 1;
+        count -= take;
+    }
+
+    while (count > 0) {
+        uint32_t best_start = 0, best_len = 0;
+
+        // Önce ipucundan sona, sonra baştan ipucuna kadar tam sığan koşu ara
+        uint32_t start = find_run(stats.next_free, bitmap_limit, count, &best_start, &best_len);
+        if (!start) start = find_run(2, stats.next_free, count, &best_start, &best_len);
+
+        uint32_t take = count;
+        if (!start) {
+            // Tam sığan koşu yok: en uzun koşuyu al ve devam et
+            if (best_len == 0) return 0;
+            start = best_start;
+            take = best_len;
+        }
+        if (first != 0) stats.fragments++;
+        if (claim_run(vol, start, take, &tail) != 0) return 0;
+        if (first == 0) first = start;
+        count -= take;
+    }
+    return first;
+}
+
+int fat_free_chain(const fat32_volume_t* vol, uint32_t first_cluster) {
+    uint32_t cluster = first_cluster;
+    uint32_t hops = 0;
+
+    while (fat32_valid_cluster(vol, cluster)) {
+        uint32_t next;
+        if (fat_cache_get(vol, cluster, &next) != 0) return -1;
+        if (fat_cache_set(vol, cluster, FAT32_FREE) != 0) return -1;
+
+        if (ready && cluster < bitmap_limit && bit_test(cluster)) {
+            bit_clear(cluster);
+            stats.free_count++;
+            if (cluster < stats.next_free) stats.next_free = cluster;
+        }
+        if (next >= FAT32_EOC || next == FAT32_FREE || ++hops > vol->cluster_count) break;
+        cluster = next;
+    }
+    return 0;
+}
+
+int fat_alloc_sync(const fat32_volume_t* vol) {
+    if (fat_cache_flush(vol) != 0) return -1;
+    if (ready && write_fsinfo(vol->lba, &vol->boot,
+                              stats.free_count, stats.next_free) != 0) {
+        return -1;
+    }
+    // FSINFO, FAT'ten sonra diske gider
+    return bcache_sync();
+}
+
+void fat_alloc_get_stats(fat_alloc_stats_t* out) {
+    *out = stats;
+}
@@ -0,0 +1,42 @@
+#ifndef FAT_ALLOC_H
+#define FAT_ALLOC_H
+
+#include <stdint.h>
+#include "fat32.h"
+
+// Boş cluster ayırıcı: ilk mount'ta FAT bir kez taranarak bellekte bir
+// doluluk bitmap'i (1: kullanımda) kurulur. Aramalar bitmap üzerinde 64 bitlik
+// kelimelerle (SSE2 varsa 128 bit) yapılır ve FSINFO'daki next_free
+// ipucundan başlar. Ayırmalar bitişik koşuları tercih eder.
+
+#define FAT_ALLOC_MAX_CLUSTERS (1u << 22)  // Bitmap'in kapsadığı cluster (512 KiB)
+
+typedef struct {
+    uint32_t free_count;        // Boş cluster sayısı
+    uint32_t next_free;         // Bir sonraki aramanın başlangıcı
+    uint32_t fsinfo_free;       // Mount'ta FSINFO'nun bildirdiği boş sayı
+    uint64_t allocations;       // Ayrılan cluster sayısı
+    uint64_t fragments;         // Bitişik olmayan ek koşu sayısı
+} fat_alloc_stats_t;
+
+// FAT'i tarayıp bitmap'i kur, FSINFO ipuçlarını yükle. Salt okunur
+// açılışlar bu bedeli ödemesin diye ilk ayırmada otomatik çağrılır.
+int fat_alloc_init(const fat32_volume_t* vol);
+
+// Bitmap'i geçersiz kıl (farklı bir bölüm mount edildiğinde)
+void fat_alloc_reset(void);
+
+// count cluster ayırıp zincir halinde bağla. prev_cluster != 0 ise yeni
+// zincir onun arkasına eklenir ve mümkünse prev_cluster + 1'den devam edilir.
+// İlk ayrılan cluster'ı, yer yoksa 0 döndürür.
+uint32_t fat_alloc_chain(const fat32_volume_t* vol, uint32_t count, uint32_t prev_cluster);
+
+// first_cluster'dan başlayan zinciri serbest bırak
+int fat_free_chain(const fat32_volume_t* vol, uint32_t first_cluster);
+
+// FAT değişikliklerini ve FSINFO'yu diske yaz
+int fat_alloc_sync(const fat32_volume_t* vol);
+
+void fat_alloc_get_stats(fat_alloc_stats_t* stats);
+
+#endif
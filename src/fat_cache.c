@@ -0,0 +1,209 @@
+#include "fat_cache.h"
+
+#define FAT_CACHE_NONE 0xFFFFFFFF
+
+typedef struct {
+    uint32_t chunk;     // Slotta bulunan parça (FAT_CACHE_NONE: boş)
+    uint8_t  dirty;     // Kirli sektörlerin bit maskesi
+} fat_cache_slot_t;
+
+static fat_cache_slot_t slots[FAT_CACHE_SLOTS];
+static uint32_t chunk_data[FAT_CACHE_SLOTS][FAT_CACHE_CHUNK_ENTRIES] __attribute__((aligned(64)));
+
+// Önbelleğin bağlı olduğu bölüm
+static uint32_t attached_fat_start = 0;    // Okunan (aktif) FAT kopyası
+static uint32_t attached_fat_sectors = 0;
+
+static fat_cache_stats_t stats;
+
+// Kirli sektörleri yazarken kullanılan istek listesi
+#define FAT_FLUSH_BATCH 128
+static disk_request_t flush_reqs[FAT_FLUSH_BATCH];
+static uint32_t flush_count = 0;
+
+// Kirli parçalar yazılmadan atılır; yalnızca FAT dışarıdan değiştiğinde kullanılmalı
+void fat_cache_invalidate(void) {
+    for (uint32_t i = 0; i < FAT_CACHE_SLOTS; i++) {
+        slots[i].chunk = FAT_CACHE_NONE;
+        slots[i].dirty = 0;
+    }
+}
+
+void fat_cache_attach(const fat32_volume_t* vol) {
+    uint32_t fat_start = vol->fat_start + vol->active_fat * vol->fat_sectors;
+
+    if (fat_start != attached_fat_start || vol->fat_sectors != attached_fat_sectors) {
+        fat_cache_invalidate();
+        attached_fat_start = fat_start;
+        attached_fat_sectors = vol->fat_sectors;
+    }
+}
+
+// Parçanın kaç sektörü FAT içinde kalıyor (son parça kısa olabilir)
+static uint32_t chunk_sectors(const fat32_volume_t* vol, uint32_t chunk) {
+    uint32_t first = chunk * FAT_CACHE_CHUNK_SECTORS;
+    if (first >= vol->fat_sectors) return 0;
+    uint32_t left = vol->fat_sectors - first;
+    return left < FAT_CACHE_CHUNK_SECTORS ? left : FAT_CACHE_CHUNK_SECTORS;
+}
+
+static int flush_submit(void) {
+    int ret = 0;
+    if (flush_count > 0) {
+        ret = disk_write_batch(flush_reqs, flush_count);
+        flush_count = 0;
+    }
+    return ret;
+}
+
+// Slotun kirli sektör koşularını tüm FAT kopyaları için istek listesine ekle
+static int flush_queue_slot(const fat32_volume_t* vol, uint32_t slot) {
+    uint32_t chunk = slots[slot].chunk;
+    uint8_t dirty = slots[slot].dirty;
+    int mirrored = !(vol->boot.ext_flags & 0x80);
+    uint32_t copies = mirrored ? vol->boot.fat_count : 1;
+
+    for (uint32_t s = 0; s < FAT_CACHE_CHUNK_SECTORS; ) {
+        if (!(dirty & (1u << s))) {
+            s++;
+            continue;
+        }
+        uint32_t run = s;
+        while (run < FAT_CACHE_CHUNK_SECTORS && (dirty & (1u << run))) run++;
+
+        for (uint32_t c = 0; c < copies; c++) {
+            uint32_t copy = mirrored ? c : vol->active_fat;
+            if (flush_count == FAT_FLUSH_BATCH && flush_submit() != 0) return -1;
+
+            disk_request_t* req = &flush_reqs[flush_count++];
+            req->lba = vol->fat_start + copy * vol->fat_sectors +
+                       chunk * FAT_CACHE_CHUNK_SECTORS + s;
+            req->buffer = (uint8_t*) chunk_data[slot] + s * SECTOR_SIZE;
+            req->sectors = run - s;
+            stats.sectors_flushed += run - s;
+        }
+        s = run;
+    }
+    return 0;
+}
+
+// Parçayı slotuna yükle (FAT sonundaki eksik parça kısa okunur)
+static uint32_t* fat_cache_load(const fat32_volume_t* vol, uint32_t chunk) {
+    uint32_t slot = chunk % FAT_CACHE_SLOTS;
+
+    if (slots[slot].chunk == chunk) {
+        return chunk_data[slot];
+    }
+
+    // Slottaki kirli parça yer değiştirmeden önce yazılmalı
+    if (slots[slot].dirty) {
+        if (flush_queue_slot(vol, slot) != 0 || flush_submit() != 0) return 0;
+        slots[slot].dirty = 0;
+    }
+
+    uint32_t first = chunk * FAT_CACHE_CHUNK_SECTORS;
+    uint32_t count = chunk_sectors(vol, chunk);
+    if (count == 0) return 0;
+
+    slots[slot].chunk = FAT_CACHE_NONE;
+    if (read_sectors(attached_fat_start + first, (uint8_t*) chunk_data[slot], count) != 0) {
+        return 0;
+    }
+    slots[slot].chunk = chunk;
+    stats.chunk_loads++;
+    return chunk_data[slot];
+}
+
+int fat_cache_get(const fat32_volume_t* vol, uint32_t cluster, uint32_t* value) {
+    stats.lookups++;
+    fat_cache_attach(vol);
+
+    uint32_t* data = fat_cache_load(vol, cluster / FAT_CACHE_CHUNK_ENTRIES);
+    if (!data) return -1;
+
+    *value = data[cluster % FAT_CACHE_CHUNK_ENTRIES] & FAT32_ENTRY_MASK;
+    return 0;
+}
+
+int fat_cache_set(const fat32_volume_t* vol, uint32_t cluster, uint32_t value) {
+    fat_cache_attach(vol);
+
+    uint32_t chunk = cluster / FAT_CACHE_CHUNK_ENTRIES;
+    uint32_t* data = fat_cache_load(vol, chunk);
+    if (!data) return -1;
+
+    uint32_t index = cluster % FAT_CACHE_CHUNK_ENTRIES;
+    data[index] = (data[index] & ~FAT32_ENTRY_MASK) | (value & FAT32_ENTRY_MASK);
+    slots[chunk % FAT_CACHE_SLOTS].dirty |= (uint8_t) (1u << (index / (SECTOR_SIZE / 4)));
+    stats.updates++;
+    return 0;
+}
+
+int fat_cache_flush(const fat32_volume_t* vol) {
+    for (uint32_t i = 0; i < FAT_CACHE_SLOTS; i++) {
+        if (slots[i].dirty) {
+            if (flush_queue_slot(vol, i) != 0) return -1;
+        }
+    }
+    if (flush_submit() != 0) return -1;
+
+    for (uint32_t i = 0; i < FAT_CACHE_SLOTS; i++) {
+        slots[i].dirty = 0;
+    }
+    return 0;
+}
+
+int fat32_map_chain(const fat32_volume_t* vol, uint32_t start_cluster,
+                    uint32_t start_index, fat32_extent_map_t* map) {
+    uint32_t cluster = start_cluster;
+    uint32_t hops = 0;
+
+    map->start_index = start_index;
+    map->cluster_total = 0;
+    map->count = 0;
+    map->next_cluster = 0;
+
+    while (fat32_valid_cluster(vol, cluster)) {
+        fat32_extent_t* last = map->count > 0 ? &map->extents[map->count - 1] : 0;
+
+        // Önceki koşunun hemen ardından geliyorsa koşuyu uzat
+        if (last && last->cluster + last->count == cluster) {
+            last->count++;
+        } else if (map->count < FAT32_MAX_EXTENTS) {
+            last = &map->extents[map->count++];
+            last->cluster = cluster;
+            last->count = 1;
+        } else {
+            map->next_cluster = cluster;
+            return 0;
+        }
+        map->cluster_total++;
+
+        // Döngüye girmiş bozuk zincirlere karşı koruma
+        if (++hops > vol->cluster_count) return -1;
+
+        uint32_t next;
+        if (fat_cache_get(vol, cluster, &next) != 0) return -1;
+        if (next >= FAT32_EOC) return 0;
+        if (next == FAT32_FREE || next == FAT32_BAD) return -1;
+        cluster = next;
+    }
+
+    // Boş dosya (ilk cluster 0) geçerlidir; zincir ortasında geçersiz
+    // bir cluster numarası ise bozulmadır
+    return map->count > 0 ? -1 : 0;
+}
+
+uint32_t fat32_cluster_at(const fat32_volume_t* vol, uint32_t first_cluster, uint32_t index) {
+    uint32_t cluster = first_cluster;
+
+    for (uint32_t i = 0; i < index; i++) {
+        if (!fat32_valid_cluster(vol, cluster)) return 0;
+        if (fat_cache_get(vol, cluster, &cluster) != 0) return 0;
+    }
+    return fat32_valid_cluster(vol, cluster) ? cluster : 0;
+}
+
+void fat_cache_get_stats(fat_cache_stats_t* out) {
+    *out = stats;
+}
@@ -0,0 +1,68 @@
+#ifndef FAT_CACHE_H
+#define FAT_CACHE_H
+
+#include <stdint.h>
+#include "disk_io.h"
+#include "fat32.h"
+
+// FAT tablosu önbelleği: FAT, sayfa boyutlu (4 KiB = 1024 girdi) parçalar
+// halinde ihtiyaç oldukça belleğe alınır. Parçalar doğrudan eşlemeli
+// slotlarda tutulur; zincir takibi çoğunlukla bellekte kalır.
+
+#define FAT_CACHE_CHUNK_SECTORS 8     // Bir parçanın sektör sayısı (4 KiB)
+#define FAT_CACHE_CHUNK_ENTRIES (FAT_CACHE_CHUNK_SECTORS * SECTOR_SIZE / 4)
+#define FAT_CACHE_SLOTS         64    // Önbellekteki parça sayısı (256 KiB)
+
+// Bir extent: diskte art arda duran cluster'lardan oluşan bir koşu
+typedef struct {
+    uint32_t cluster;   // Koşunun ilk cluster'ı
+    uint32_t count;     // Koşudaki cluster sayısı
+} fat32_extent_t;
+
+#define FAT32_MAX_EXTENTS 32
+
+// Bir cluster zincirinin extent listesi. Zincir FAT32_MAX_EXTENTS'ten fazla
+// parçaya bölünmüşse next_cluster devam edilecek cluster'ı gösterir.
+typedef struct {
+    uint32_t start_index;     // İlk extent'in dosya içindeki cluster sırası
+    uint32_t cluster_total;   // Listedeki toplam cluster sayısı
+    uint32_t count;           // Extent sayısı
+    uint32_t next_cluster;    // Zincirin devamı (0: zincir tamamlandı)
+    fat32_extent_t extents[FAT32_MAX_EXTENTS];
+} fat32_extent_map_t;
+
+typedef struct {
+    uint64_t lookups;       // FAT girdisi sorgusu
+    uint64_t chunk_loads;   // Diskten okunan parça sayısı
+    uint64_t updates;       // FAT girdisi değişikliği
+    uint64_t sectors_flushed; // Tüm FAT kopyalarına yazılan sektör sayısı
+} fat_cache_stats_t;
+
+// Önbelleği bir bölüme bağla; farklı bir bölümse tüm parçalar atılır
+void fat_cache_attach(const fat32_volume_t* vol);
+
+// Tüm parçaları at (FAT dışarıdan değiştiyse)
+void fat_cache_invalidate(void);
+
+// Bir cluster'ın FAT girdisini oku (üst 4 bit maskelenir)
+int fat_cache_get(const fat32_volume_t* vol, uint32_t cluster, uint32_t* value);
+
+// Bir cluster'ın FAT girdisini değiştir (üst 4 bit korunur). Değişiklik
+// önbellekte kirli kalır ve fat_cache_flush ile tüm FAT kopyalarına yazılır.
+int fat_cache_set(const fat32_volume_t* vol, uint32_t cluster, uint32_t value);
+
+// Kirli FAT sektörlerini tüm FAT kopyalarına (mirror kapalıysa yalnızca
+// aktif kopyaya) tek bir toplu yazma ile gönder
+int fat_cache_flush(const fat32_volume_t* vol);
+
+// Zinciri start_cluster'dan başlayarak extent listesine çevir.
+// start_index, start_cluster'ın dosya içindeki sırasıdır (yalnızca kayıt için).
+int fat32_map_chain(const fat32_volume_t* vol, uint32_t start_cluster,
+                    uint32_t start_index, fat32_extent_map_t* map);
+
+// Dosya içindeki index'inci cluster'ı bul (bulunamazsa 0 döner)
+uint32_t fat32_cluster_at(const fat32_volume_t* vol, uint32_t first_cluster, uint32_t index);
+
+void fat_cache_get_stats(fat_cache_stats_t* stats);
+
+#endif
@@ -1,13 +1,46 @@
+#include <string.h>
 #include "fsinfo.h"
+#include "bcache.h"
 
-// FSINFO sektörünü oku ve root cluster'a erişim sağla
-void read_fsinfo(uint32_t lba, fat32_boot_sector_t* boot_sector) {
+// FSINFO sektörünü oku ve boş cluster sayısı/ipucu alanlarını çözümle
+int read_fsinfo(uint32_t lba, const fat32_boot_sector_t* boot_sector, fat32_fsinfo_t* fsinfo) {
     uint32_t fsinfo_sector = boot_sector->fs_info_sector;
-    uint8_t buffer[512];
 
-    // FSINFO sektörünü oku
-    read_sectors(fsinfo_sector + lba, buffer, 1);
+    // FSINFO sektörünü önbellekte tut; yığında kopyalayıp atmaya gerek yok
+    uint8_t* buffer = bcache_pin(fsinfo_sector + lba);
+    if (!buffer) {
+        return -1;
+    }
+    memcpy(fsinfo, buffer, sizeof(*fsinfo));
+    bcache_unpin(fsinfo_sector + lba, 0);
 
-    // Root cluster'ı ve FAT bilgilerini burada işleyebilirsiniz
-    // fsinfo içinde başka işlemler de yapılabilir.
+    if (fsinfo->lead_signature != FSINFO_LEAD_SIGNATURE ||
+        fsinfo->struct_signature != FSINFO_STRUCT_SIGNATURE ||
+        fsinfo->trail_signature != FSINFO_TRAIL_SIGNATURE) {
+        return -1;
+    }
+    return 0;
+}
+
+int write_fsinfo(uint32_t lba, const fat32_boot_sector_t* boot_sector,
+                 uint32_t free_count, uint32_t next_free) {
+    uint32_t fsinfo_sector = boot_sector->fs_info_sector + lba;
+
+    fat32_fsinfo_t* fsinfo = (fat32_fsinfo_t*) bcache_pin(fsinfo_sector);
+    if (!fsinfo) {
+        return -1;
+    }
+
+    // Bozuk bir FSINFO'nun üzerine yazma
+    if (fsinfo->lead_signature != FSINFO_LEAD_SIGNATURE ||
+        fsinfo->struct_signature != FSINFO_STRUCT_SIGNATURE) {
+        bcache_unpin(fsinfo_sector, 0);
+        return -1;
+    }
+
+    int changed = fsinfo->free_count != free_count || fsinfo->next_free != next_free;
+    fsinfo->free_count = free_count;
+    fsinfo->next_free = next_free;
+    bcache_unpin(fsinfo_sector, changed);
+    return 0;
 }
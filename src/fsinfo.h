@@ -3,6 +3,29 @@
 
 #include "fat32.h"
 
-void read_fsinfo(uint32_t lba, fat32_boot_sector_t* boot_sector);
+// FSINFO imzaları
+#define FSINFO_LEAD_SIGNATURE   0x41615252
+#define FSINFO_STRUCT_SIGNATURE 0x61417272
+#define FSINFO_TRAIL_SIGNATURE  0xAA550000
+#define FSINFO_UNKNOWN          0xFFFFFFFF  // Sayı/ipucu bilinmiyor
+
+#pragma pack(push, 1)
+typedef struct {
+    uint32_t lead_signature;    // 0x41615252
+    uint8_t  reserved1[480];
+    uint32_t struct_signature;  // 0x61417272
+    uint32_t free_count;        // Boş cluster sayısı (FSINFO_UNKNOWN olabilir)
+    uint32_t next_free;         // Aramaya başlanacak cluster ipucu
+    uint8_t  reserved2[12];
+    uint32_t trail_signature;   // 0xAA550000
+} __attribute__((packed)) fat32_fsinfo_t;
+#pragma pack(pop)
+
+// FSINFO sektörünü oku ve doğrula; imzalar tutmazsa -1 döner
+int read_fsinfo(uint32_t lba, const fat32_boot_sector_t* boot_sector, fat32_fsinfo_t* fsinfo);
+
+// Boş cluster sayısını ve ipucunu güncelle (önbellekte kirli işaretlenir)
+int write_fsinfo(uint32_t lba, const fat32_boot_sector_t* boot_sector,
+                 uint32_t free_count, uint32_t next_free);
 
 #endif
@@ -0,0 +1,208 @@
+#include <string.h>
+#include "loader.h"
+#include "fat_cache.h"
+#include "disk_io.h"
+#include "bcache.h"
+#include "disk_queue.h"
+#include "lz4_stream.h"
+
+// Sıkıştırılmış imaj bu boyutta parçalar halinde okunup çözücüye verilir;
+// LOADER_CHUNKS parça aynı anda kuyrukta olabilir
+#define LOADER_CHUNK_SECTORS 16
+#define LOADER_CHUNKS        4
+
+// Ham imajda aynı anda kuyrukta tutulan en fazla okuma
+#define LOADER_RAW_REQUESTS  32
+
+// Diskte bitişik bir koşu: lba'dan başlayan bytes kadar dosya verisi
+typedef int (*loader_run_t)(uint32_t lba, uint32_t bytes, void* ctx);
+
+// Okumayı disk kuyruğuna gönder ve hemen yola çıkar; kuyruk doluysa
+// önce boşalmasını bekle
+static int queue_read(disk_async_request_t* req, uint32_t lba, uint8_t* buffer, uint32_t sectors) {
+    req->lba = lba;
+    req->buffer = buffer;
+    req->sectors = sectors;
+    req->direction = 0;
+    req->callback = 0;
+    req->context = 0;
+
+    if (disk_queue_submit(req) != 0) {
+        disk_queue_drain();
+        if (disk_queue_submit(req) != 0) return -1;
+    }
+    disk_queue_poll();
+    return 0;
+}
+
+// Dosyanın cluster zincirini extent'ler halinde sırayla gez
+static int walk_runs(const fat32_volume_t* vol, const DIR_ENTRY* entry,
+                     loader_run_t run, void* ctx, loader_stats_t* stats) {
+    fat32_extent_map_t map;
+    uint32_t remaining = entry->file_size;
+    uint32_t cluster = entry->first_cluster;
+    uint32_t index = 0;
+
+    // Önbellek atlanacağı için kirli sektörler önce diske gitmeli
+    if (bcache_sync() != 0) return -1;
+
+    while (remaining > 0) {
+        if (!fat32_valid_cluster(vol, cluster)) return -1;
+        if (fat32_map_chain(vol, cluster, index, &map) != 0) return -1;
+
+        for (uint32_t e = 0; e < map.count && remaining > 0; e++) {
+            uint32_t run_bytes = map.extents[e].count * vol->cluster_size;
+            uint32_t bytes = remaining < run_bytes ? remaining : run_bytes;
+
+            int status = run(fat32_cluster_lba(vol, map.extents[e].cluster), bytes, ctx);
+            if (status < 0) return -1;
+            remaining -= bytes;
+            stats->read_bytes += bytes;
+            stats->extents++;
+            if (status > 0) return 0;
+        }
+
+        index += map.cluster_total;
+        cluster = map.next_cluster;
+    }
+    return 0;
+}
+
+/* ================ HAM İMAJ ================ */
+
+typedef struct {
+    uint8_t* dest;
+    uint32_t nreq;
+    loader_stats_t* stats;
+} raw_ctx_t;
+
+static disk_async_request_t raw_reqs[LOADER_RAW_REQUESTS];
+
+static int raw_run(uint32_t lba, uint32_t bytes, void* ctx) {
+    raw_ctx_t* raw = ctx;
+    uint32_t whole = bytes / SECTOR_SIZE;
+
+    // Bitişik koşunun tam sektörleri tek istekle doğrudan hedefe; koşular
+    // kuyrukta birikir, okuyucu sonraki extent'e geçerken disk çalışır
+    if (whole > 0) {
+        if (raw->nreq == LOADER_RAW_REQUESTS) {
+            if (disk_queue_drain() != 0) return -1;
+            raw->nreq = 0;
+        }
+        if (queue_read(&raw_reqs[raw->nreq++], lba, raw->dest, whole) != 0) return -1;
+        raw->dest += whole * SECTOR_SIZE;
+    }
+
+    // Dosyanın son yarım sektörü: hedefin ötesine taşmamak için buffer'a
+    uint32_t tail = bytes % SECTOR_SIZE;
+    if (tail > 0) {
+        uint8_t buffer[SECTOR_SIZE] __attribute__((aligned(16)));
+        if (read_sectors(lba + whole, buffer, 1) != 0) return -1;
+        memcpy(raw->dest, buffer, tail);
+        raw->dest += tail;
+        raw->stats->tail_bytes = tail;
+    }
+    return 0;
+}
+
+int loader_load_entry(const DIR_ENTRY* entry, uint8_t* dest, uint32_t max_size,
+                      loader_stats_t* stats) {
+    fat32_volume_t* vol = fat32_get_volume();
+    loader_stats_t local;
+
+    if (!stats) stats = &local;
+    memset(stats, 0, sizeof(*stats));
+
+    if (!vol || entry->file_size > max_size) return -1;
+
+    raw_ctx_t raw = { dest, 0, stats };
+    int result = walk_runs(vol, entry, raw_run, &raw, stats);
+
+    // Hata olsa bile uçuştaki okumalar bitmeden dönülmez
+    if (disk_queue_drain() != 0 || result != 0) return -1;
+    stats->bytes = entry->file_size;
+    return 0;
+}
+
+/* ================ LZ4 İMAJ ================ */
+
+typedef struct {
+    disk_async_request_t req;
+    uint32_t bytes;          // Parçadaki dosya verisi
+    uint8_t  busy;           // Okuma gönderildi, henüz çözülmedi
+} lz4_chunk_t;
+
+typedef struct {
+    lz4_stream_t stream;
+    int status;
+    uint32_t next;           // Sıradaki parça yuvası (halka)
+} lz4_ctx_t;
+
+static lz4_chunk_t chunks[LOADER_CHUNKS];
+static uint8_t chunk_data[LOADER_CHUNKS][LOADER_CHUNK_SECTORS * SECTOR_SIZE] __attribute__((aligned(16)));
+
+// En eski parçanın okunmasını bekle ve çözücüye ver
+static int chunk_consume(lz4_ctx_t* lz, lz4_chunk_t* chunk) {
+    chunk->busy = 0;
+    if (disk_queue_wait(&chunk->req) != 0) return -1;
+
+    // Frame bittiyse dosyada kalan veri yok sayılır
+    if (lz->status != LZ4_STREAM_MORE) return 0;
+    lz->status = lz4_stream_feed(&lz->stream, chunk->req.buffer, chunk->bytes);
+    return lz->status == LZ4_STREAM_ERROR ? -1 : 0;
+}
+
+// Koşuyu parça parça kuyruğa gönder; yuva boşaltılırken en eski parça
+// çözülür, böylece sonraki parçalar okunurken açma devam eder
+static int lz4_run(uint32_t lba, uint32_t bytes, void* ctx) {
+    lz4_ctx_t* lz = ctx;
+
+    while (bytes > 0) {
+        lz4_chunk_t* chunk = &chunks[lz->next];
+        if (chunk->busy && chunk_consume(lz, chunk) != 0) return -1;
+        if (lz->status == LZ4_STREAM_DONE) return 1;
+
+        uint32_t sectors = (bytes + SECTOR_SIZE - 1) / SECTOR_SIZE;
+        if (sectors > LOADER_CHUNK_SECTORS) sectors = LOADER_CHUNK_SECTORS;
+        uint32_t n = sectors * SECTOR_SIZE;
+        if (n > bytes) n = bytes;
+
+        chunk->bytes = n;
+        if (queue_read(&chunk->req, lba, chunk_data[lz->next], sectors) != 0) return -1;
+        chunk->busy = 1;
+        lz->next = (lz->next + 1) % LOADER_CHUNKS;
+
+        lba += sectors;
+        bytes -= n;
+    }
+    return 0;
+}
+
+int loader_load_entry_lz4(const DIR_ENTRY* entry, uint8_t* dest, uint32_t max_size,
+                          loader_stats_t* stats) {
+    fat32_volume_t* vol = fat32_get_volume();
+    loader_stats_t local;
+    lz4_ctx_t lz;
+    int result;
+
+    if (!stats) stats = &local;
+    memset(stats, 0, sizeof(*stats));
+
+    if (!vol) return -1;
+
+    lz4_stream_init(&lz.stream, dest, max_size);
+    lz.status = LZ4_STREAM_MORE;
+    lz.next = 0;
+    result = walk_runs(vol, entry, lz4_run, &lz, stats);
+
+    // Kuyrukta kalan parçaları gönderiliş sırasıyla çöz
+    for (uint32_t k = 0; k < LOADER_CHUNKS; k++) {
+        lz4_chunk_t* chunk = &chunks[(lz.next + k) % LOADER_CHUNKS];
+        if (chunk->busy && chunk_consume(&lz, chunk) != 0) result = -1;
+    }
+
+    // Dosya frame bitmeden sona erdiyse imaj kesik
+    if (result != 0 || lz.status != LZ4_STREAM_DONE) return -1;
+    stats->bytes = lz.stream.out_pos;
+    return 0;
+}
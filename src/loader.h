@@ -0,0 +1,29 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include <stdint.h>
+#include "fat32.h"
+
+// İmaj yükleyici: dosyanın cluster zincirini extent'lere çevirir ve her
+// bitişik koşuyu ara buffer kullanmadan doğrudan hedef belleğe okur.
+// Yalnızca dosya sonundaki yarım sektör küçük bir buffer'dan kopyalanır.
+// Okumalar sektör önbelleğini atlar (kirli sektörler önce diske yazılır).
+// LZ4 frame olarak sıkıştırılmış imajlar parça parça okunur ve her parça
+// gelir gelmez hedefe açılır; sıkıştırılmış imajın tamamı bellekte tutulmaz.
+
+typedef struct {
+    uint32_t bytes;          // Hedefe yazılan byte sayısı
+    uint32_t read_bytes;     // Dosyadan okunan byte sayısı
+    uint32_t extents;        // Okunan bitişik koşu sayısı
+    uint32_t tail_bytes;     // Buffer üzerinden kopyalanan kuyruk
+} loader_stats_t;
+
+// Girdiyi dest'e yükle; dosya max_size'dan büyükse -1 döner
+int loader_load_entry(const DIR_ENTRY* entry, uint8_t* dest, uint32_t max_size,
+                      loader_stats_t* stats);
+
+// LZ4 frame imajını dest'e aç; açılmış boyut max_size'ı aşarsa -1 döner
+int loader_load_entry_lz4(const DIR_ENTRY* entry, uint8_t* dest, uint32_t max_size,
+                          loader_stats_t* stats);
+
+#endif
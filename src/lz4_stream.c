@@ -0,0 +1,297 @@
+#include <string.h>
+#include "lz4_stream.h"
+
+// Çözücü durumları
+enum {
+    LZ4S_MAGIC,          // 4 byte frame imzası
+    LZ4S_DESCRIPTOR,     // FLG + BD
+    LZ4S_HEADER_REST,    // İçerik boyutu (isteğe bağlı) + başlık sağlaması
+    LZ4S_SKIP_SIZE,      // Atlanabilir frame boyutu
+    LZ4S_SKIP_DATA,      // Atlanabilir frame içeriği
+    LZ4S_BLOCK_SIZE,     // 4 byte blok boyutu
+    LZ4S_BLOCK_RAW,      // Sıkıştırılmamış blok
+    LZ4S_TOKEN,          // Dizi başı: literal/eşleşme uzunlukları
+    LZ4S_LIT_LEN,        // Literal uzunluk uzantısı
+    LZ4S_LITERALS,       // Literal byte'lar
+    LZ4S_OFFSET,         // 2 byte eşleşme uzaklığı
+    LZ4S_MATCH_LEN,      // Eşleşme uzunluk uzantısı
+    LZ4S_BLOCK_CHECKSUM, // Blok sağlaması (atlanır)
+    LZ4S_CONTENT_CHECKSUM, // İçerik sağlaması (atlanır)
+    LZ4S_DONE,
+    LZ4S_ERROR
+};
+
+#define FLG_BLOCK_CHECKSUM   0x10
+#define FLG_CONTENT_SIZE     0x08
+#define FLG_CONTENT_CHECKSUM 0x04
+#define FLG_DICT_ID          0x01
+
+static inline uint32_t load_le32(const uint8_t* p) {
+    return (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+static inline void expect(lz4_stream_t* s, uint8_t state, uint32_t bytes) {
+    s->state = state;
+    s->need = bytes;
+    s->have = 0;
+}
+
+// Çok byte'lı alanı parçalar boyunca topla; tamamlandıysa 1 döner
+static int gather(lz4_stream_t* s, const uint8_t** in, uint32_t* len) {
+    uint32_t n = s->need - s->have;
+    if (n > *len) n = *len;
+    memcpy(s->field + s->have, *in, n);
+    s->have += n;
+    *in += n;
+    *len -= n;
+    return s->have == s->need;
+}
+
+static inline void next_block(lz4_stream_t* s) {
+    if (s->flags & FLG_BLOCK_CHECKSUM) {
+        expect(s, LZ4S_BLOCK_CHECKSUM, 4);
+    } else {
+        expect(s, LZ4S_BLOCK_SIZE, 4);
+    }
+}
+
+// Literaller bitti: blok bitti mi, yoksa eşleşme mi geliyor?
+static inline void literals_done(lz4_stream_t* s) {
+    if (s->block_left == 0) {
+        next_block(s);
+    } else {
+        expect(s, LZ4S_OFFSET, 2);
+    }
+}
+
+// Eşleşmeyi çıktıdaki önceki veriden kopyala
+static int copy_match(lz4_stream_t* s) {
+    uint32_t len = s->match_len;
+    if (s->offset == 0 || s->offset > s->out_pos || len > s->out_cap - s->out_pos) {
+        return -1;
+    }
+
+    uint8_t* dst = s->out + s->out_pos;
+    const uint8_t* src = dst - s->offset;
+    if (s->offset >= len) {
+        memcpy(dst, src, len);
+    } else {
+        // Örtüşen kopya: kısa uzaklık tekrarlanan deseni üretir
+        for (uint32_t i = 0; i < len; i++) dst[i] = src[i];
+    }
+    s->out_pos += len;
+
+    // Blok her zaman literallerle biter
+    if (s->block_left == 0) return -1;
+    expect(s, LZ4S_TOKEN, 0);
+    return 0;
+}
+
+void lz4_stream_init(lz4_stream_t* s, uint8_t* out, uint32_t capacity) {
+    memset(s, 0, sizeof(*s));
+    s->out = out;
+    s->out_cap = capacity;
+    expect(s, LZ4S_MAGIC, 4);
+}
+
+int lz4_stream_feed(lz4_stream_t* s, const uint8_t* in, uint32_t len) {
+    while (len > 0 && s->state != LZ4S_DONE && s->state != LZ4S_ERROR) {
+        switch (s->state) {
+        case LZ4S_MAGIC: {
+            if (!gather(s, &in, &len)) break;
+            uint32_t magic = load_le32(s->field);
+            if (magic == LZ4_FRAME_MAGIC) {
+                expect(s, LZ4S_DESCRIPTOR, 2);
+            } else if ((magic & 0xFFFFFFF0) == LZ4_SKIPPABLE_MAGIC) {
+                expect(s, LZ4S_SKIP_SIZE, 4);
+            } else {
+                s->state = LZ4S_ERROR;
+            }
+            break;
+        }
+
+        case LZ4S_DESCRIPTOR: {
+            if (!gather(s, &in, &len)) break;
+            uint8_t flg = s->field[0];
+            uint8_t bd = s->field[1];
+            uint8_t max_id = (bd >> 4) & 0x07;
+            // Sürüm 01 olmalı; ayrılmış bitler sıfır olmalı
+            if ((flg >> 6) != 1 || (flg & 0x02) || (flg & FLG_DICT_ID) ||
+                (bd & 0x8F) || max_id < 4) {
+                s->state = LZ4S_ERROR;
+                break;
+            }
+            s->flags = flg;
+            s->block_max = 1u << (8 + 2 * max_id);
+            expect(s, LZ4S_HEADER_REST, (flg & FLG_CONTENT_SIZE) ? 9 : 1);
+            break;
+        }
+
+        case LZ4S_HEADER_REST:
+            if (!gather(s, &in, &len)) break;
+            if (s->flags & FLG_CONTENT_SIZE) {
+                s->content_size = load_le32(s->field) | ((uint64_t) load_le32(s->field + 4) << 32);
+                if (s->content_size > s->out_cap - s->out_pos) {
+                    s->state = LZ4S_ERROR;
+                    break;
+                }
+            }
+            expect(s, LZ4S_BLOCK_SIZE, 4);
+            break;
+
+        case LZ4S_SKIP_SIZE:
+            if (!gather(s, &in, &len)) break;
+            s->block_left = load_le32(s->field);
+            expect(s, s->block_left ? LZ4S_SKIP_DATA : LZ4S_MAGIC, s->block_left ? 0 : 4);
+            break;
+
+        case LZ4S_SKIP_DATA: {
+            uint32_t n = len < s->block_left ? len : s->block_left;
+            in += n;
+            len -= n;
+            s->block_left -= n;
+            if (s->block_left == 0) expect(s, LZ4S_MAGIC, 4);
+            break;
+        }
+
+        case LZ4S_BLOCK_SIZE: {
+            if (!gather(s, &in, &len)) break;
+            uint32_t size = load_le32(s->field);
+            if (size == 0) {
+                // EndMark
+                if (s->flags & FLG_CONTENT_CHECKSUM) {
+                    expect(s, LZ4S_CONTENT_CHECKSUM, 4);
+                } else {
+                    s->state = LZ4S_DONE;
+                }
+                break;
+            }
+            s->block_left = size & 0x7FFFFFFF;
+            if (s->block_left == 0 || s->block_left > s->block_max) {
+                s->state = LZ4S_ERROR;
+            } else {
+                expect(s, (size & 0x80000000) ? LZ4S_BLOCK_RAW : LZ4S_TOKEN, 0);
+            }
+            break;
+        }
+
+        case LZ4S_BLOCK_RAW: {
+            uint32_t n = len < s->block_left ? len : s->block_left;
+            if (n > s->out_cap - s->out_pos) {
+                s->state = LZ4S_ERROR;
+                break;
+            }
+            memcpy(s->out + s->out_pos, in, n);
+            s->out_pos += n;
+            in += n;
+            len -= n;
+            s->block_left -= n;
+            if (s->block_left == 0) next_block(s);
+            break;
+        }
+
+        case LZ4S_TOKEN: {
+            uint8_t token = *in++;
+            len--;
+            s->block_left--;
+            s->lit_left = token >> 4;
+            s->match_len = (token & 0x0F) + 4;
+            if (s->lit_left == 15) {
+                expect(s, LZ4S_LIT_LEN, 0);
+            } else if (s->lit_left > 0) {
+                expect(s, LZ4S_LITERALS, 0);
+            } else {
+                literals_done(s);
+            }
+            break;
+        }
+
+        case LZ4S_LIT_LEN: {
+            if (s->block_left == 0) {
+                s->state = LZ4S_ERROR;
+                break;
+            }
+            uint8_t b = *in++;
+            len--;
+            s->block_left--;
+            s->lit_left += b;
+            if (b != 255) {
+                if (s->lit_left > 0) {
+                    expect(s, LZ4S_LITERALS, 0);
+                } else {
+                    literals_done(s);
+                }
+            }
+            break;
+        }
+
+        case LZ4S_LITERALS: {
+            uint32_t n = s->lit_left;
+            if (n > len) n = len;
+            if (n > s->block_left || n > s->out_cap - s->out_pos) {
+                s->state = LZ4S_ERROR;
+                break;
+            }
+            memcpy(s->out + s->out_pos, in, n);
+            s->out_pos += n;
+            in += n;
+            len -= n;
+            s->block_left -= n;
+            s->lit_left -= n;
+            if (s->lit_left == 0) literals_done(s);
+            break;
+        }
+
+        case LZ4S_OFFSET: {
+            uint32_t before = len;
+            int complete = gather(s, &in, &len);
+            if (before - len > s->block_left) {
+                s->state = LZ4S_ERROR;
+                break;
+            }
+            s->block_left -= before - len;
+            if (!complete) break;
+            s->offset = (uint32_t) s->field[0] | ((uint32_t) s->field[1] << 8);
+            if (s->match_len == 15 + 4) {
+                expect(s, LZ4S_MATCH_LEN, 0);
+            } else if (copy_match(s) != 0) {
+                s->state = LZ4S_ERROR;
+            }
+            break;
+        }
+
+        case LZ4S_MATCH_LEN: {
+            if (s->block_left == 0) {
+                s->state = LZ4S_ERROR;
+                break;
+            }
+            uint8_t b = *in++;
+            len--;
+            s->block_left--;
+            s->match_len += b;
+            if (b != 255 && copy_match(s) != 0) {
+                s->state = LZ4S_ERROR;
+            }
+            break;
+        }
+
+        case LZ4S_BLOCK_CHECKSUM:
+            if (gather(s, &in, &len)) expect(s, LZ4S_BLOCK_SIZE, 4);
+            break;
+
+        case LZ4S_CONTENT_CHECKSUM:
+            if (gather(s, &in, &len)) s->state = LZ4S_DONE;
+            break;
+        }
+    }
+
+    if (s->state == LZ4S_DONE) {
+        // Başlıkta boyut bildirildiyse çıktı onunla uyuşmalı
+        if ((s->flags & FLG_CONTENT_SIZE) && s->content_size != s->out_pos) {
+            s->state = LZ4S_ERROR;
+            return LZ4_STREAM_ERROR;
+        }
+        return LZ4_STREAM_DONE;
+    }
+    return s->state == LZ4S_ERROR ? LZ4_STREAM_ERROR : LZ4_STREAM_MORE;
+}
@@ -0,0 +1,44 @@
+#ifndef LZ4_STREAM_H
+#define LZ4_STREAM_H
+
+#include <stdint.h>
+
+// Akan (streaming) LZ4 frame çözücü. Girdi istenen boyutta parçalar
+// halinde (ör. diskten gelen her cluster) verilir; çözücü durumunu
+// parçalar arasında korur, sıkıştırılmış imajın tamamını bellekte tutmaz.
+// Çıktı doğrusal bir bellek bölgesine yazılır; eşleşmeler bu bölgeden
+// kopyalandığı için bağımlı (linked) bloklar da desteklenir.
+// Frame başlık, blok ve içerik sağlama toplamları (xxHash32) atlanır,
+// doğrulanmaz. Sözlük (dictionary ID) kullanan frame'ler reddedilir.
+
+#define LZ4_FRAME_MAGIC      0x184D2204
+#define LZ4_SKIPPABLE_MAGIC  0x184D2A50  // 0x184D2A50 - 0x184D2A5F
+
+// lz4_stream_feed dönüş değerleri
+#define LZ4_STREAM_MORE    0   // Daha fazla girdi bekleniyor
+#define LZ4_STREAM_DONE    1   // Frame bitti (kalan girdi yok sayılır)
+#define LZ4_STREAM_ERROR  -1   // Bozuk veri veya çıktı alanı yetersiz
+
+typedef struct {
+    uint8_t* out;            // Çıktı bölgesi
+    uint32_t out_pos;        // Yazılan byte sayısı
+    uint32_t out_cap;        // Çıktı bölgesinin boyutu
+    uint8_t  state;
+    uint8_t  flags;          // Frame FLG byte'ı
+    uint8_t  field[16];      // Çok byte'lı alanların toplandığı buffer
+    uint32_t need;           // Alan için gereken byte
+    uint32_t have;           // Alana toplanan byte
+    uint32_t block_max;      // Frame'in en büyük blok boyutu
+    uint32_t block_left;     // Geçerli blokta kalan girdi byte'ı
+    uint32_t lit_left;       // Kopyalanacak literal byte
+    uint32_t match_len;      // Eşleşme uzunluğu
+    uint32_t offset;         // Eşleşme uzaklığı
+    uint64_t content_size;   // Başlıkta bildirilen boyut (0: bilinmiyor)
+} lz4_stream_t;
+
+void lz4_stream_init(lz4_stream_t* s, uint8_t* out, uint32_t capacity);
+
+// Girdi parçasını çöz; LZ4_STREAM_MORE / DONE / ERROR döner
+int lz4_stream_feed(lz4_stream_t* s, const uint8_t* in, uint32_t len);
+
+#endif
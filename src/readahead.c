@@ -0,0 +1,77 @@
+#include "readahead.h"
+#include "bcache.h"
+
+static readahead_tunables_t tunables = {
+    .enabled = 1,
+    .min_window = 4,
+    .max_window = 64,
+    .max_sectors = BCACHE_ENTRIES / 4
+};
+
+static readahead_stats_t stats;
+
+void readahead_get_tunables(readahead_tunables_t* out) {
+    *out = tunables;
+}
+
+void readahead_set_tunables(const readahead_tunables_t* in) {
+    tunables = *in;
+    if (tunables.min_window == 0) tunables.min_window = 1;
+    if (tunables.max_window < tunables.min_window) tunables.max_window = tunables.min_window;
+}
+
+void readahead_init(readahead_state_t* ra) {
+    ra->next_index = 0;
+    ra->window = 0;
+    ra->ra_end = 0;
+}
+
+uint32_t readahead_access(readahead_state_t* ra, uint32_t first, uint32_t last,
+                          uint32_t total, uint32_t sectors_per_cluster, uint32_t* start) {
+    // Aynı cluster'ın devamını okumak da ardışık sayılır
+    int sequential = first == ra->next_index ||
+                     (ra->next_index > 0 && first == ra->next_index - 1);
+    ra->next_index = last + 1;
+
+    if (!tunables.enabled) return 0;
+
+    if (!sequential) {
+        if (ra->window) stats.resets++;
+        ra->window = 0;
+        ra->ra_end = 0;
+        return 0;
+    }
+
+    // Pencere önbelleğin izin verdiği sektör sayısını aşmamalı
+    uint32_t limit = tunables.max_window;
+    if (sectors_per_cluster && limit * sectors_per_cluster > tunables.max_sectors) {
+        limit = tunables.max_sectors / sectors_per_cluster;
+        if (limit == 0) limit = 1;
+    }
+
+    if (ra->window == 0) {
+        ra->window = tunables.min_window < limit ? tunables.min_window : limit;
+        ra->ra_end = last + 1;
+    }
+
+    // Önde kalan önceden okunmuş bölge pencerenin yarısından fazlaysa bekle
+    if (ra->ra_end > last + 1 + ra->window / 2) return 0;
+
+    uint32_t from = ra->ra_end > last + 1 ? ra->ra_end : last + 1;
+    if (from >= total) return 0;
+
+    uint32_t count = ra->window;
+    if (from + count > total) count = total - from;
+
+    *start = from;
+    ra->ra_end = from + count;
+    ra->window = ra->window * 2 < limit ? ra->window * 2 : limit;
+
+    stats.windows++;
+    stats.clusters += count;
+    return count;
+}
+
+void readahead_get_stats(readahead_stats_t* out) {
+    *out = stats;
+}
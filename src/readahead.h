@@ -0,0 +1,44 @@
+#ifndef READAHEAD_H
+#define READAHEAD_H
+
+#include <stdint.h>
+
+// Uyarlamalı ardışık önceden okuma. Her açık dosya bir readahead_state_t
+// taşır; okuma ardışık devam ettikçe pencere min_window'dan max_window'a
+// kadar ikiye katlanır, rastgele erişimde sıfırlanır. Okuyucu önceden
+// okunmuş bölgenin yarısına geldiğinde bir sonraki pencere istenir.
+
+typedef struct {
+    uint32_t enabled;        // 0: readahead kapalı
+    uint32_t min_window;     // İlk pencere (cluster)
+    uint32_t max_window;     // En büyük pencere (cluster)
+    uint32_t max_sectors;    // Bir pencerenin sektör sınırı (önbelleği boğmasın)
+} readahead_tunables_t;
+
+typedef struct {
+    uint32_t next_index;     // Ardışık erişimde beklenen cluster sırası
+    uint32_t window;         // Geçerli pencere (0: ardışık erişim yok)
+    uint32_t ra_end;         // Önceden okunmuş son cluster sırası + 1
+} readahead_state_t;
+
+typedef struct {
+    uint64_t windows;        // İstenen pencere sayısı
+    uint64_t clusters;       // Önceden okunması istenen cluster sayısı
+    uint64_t resets;         // Rastgele erişim nedeniyle sıfırlanan pencereler
+} readahead_stats_t;
+
+void readahead_get_tunables(readahead_tunables_t* tunables);
+void readahead_set_tunables(const readahead_tunables_t* tunables);
+
+void readahead_init(readahead_state_t* ra);
+
+// Okuyucu [first, last] cluster sıralarına erişti. Önceden okunması
+// gereken pencere varsa *start'a ilk sırayı yazar ve cluster sayısını
+// döndürür (0: okunacak bir şey yok). total: dosyadaki cluster sayısı,
+// sectors_per_cluster: pencere sınırını sektöre çevirmek için.
+uint32_t readahead_access(readahead_state_t* ra, uint32_t first, uint32_t last,
+                          uint32_t total, uint32_t sectors_per_cluster, uint32_t* start);
+
+void readahead_get_stats(readahead_stats_t* stats);
+
+#endif
@@ -0,0 +1,321 @@
+// fat32_bench: mkimage ile üretilen bir FAT32 imajı üzerinde disk/FAT
+// katmanını ölçen ve sonuçları JSON olarak yazan host aracı.
+//
+//   fat32_bench [-n tekrar] [-r rastgele_okuma] [-l arama] [-w worker] [-o çıktı.json] <imaj>
+//
+// Ölçümler:
+//   seq_read      /BIG.DAT baştan sona 64 KiB'lık fat32_read çağrılarıyla
+//   random_read   /BIG.DAT içinde 4 KiB hizalı rastgele konumlardan okuma
+//   lookup        /DATA altındaki dosyalar için find_file (ilk arama indeksi
+//                 kurar; sonraki aramalar indeksten karşılanır)
+//   listing       fat32_read_directory("/DATA") ve uzantı indeksinden
+//                 fat32_list_extension("/DATA", ".dat")
+//   kernel_load   /KERNEL.BIN için load_kernel'in kullandığı loader yolu
+//
+// Sıralı okuma ve kernel yükleme her tekrarda boş sektör önbelleğiyle
+// başlar. İmaj host sayfa önbelleğinden okunduğu için süreler disk
+// hızını değil, katmanın CPU maliyetini ölçer.
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "disk_io.h"
+#include "bcache.h"
+#include "fat32.h"
+#include "fat32_file.h"
+#include "dir_index.h"
+#include "disk_queue.h"
+#include "loader.h"
+
+#define BENCH_CHUNK    (64u << 10)
+#define BENCH_RANDOM_IO 4096
+
+static uint8_t* buffer;
+static FILE* out;
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*) a, y = *(const double*) b;
+    return (x > y) - (x < y);
+}
+
+// Sıralı örnek dizisinden yüzdelik (p: 0-100)
+static double percentile(const double* sorted, uint32_t count, double p) {
+    uint32_t i = (uint32_t) (p / 100.0 * (count - 1) + 0.5);
+    return sorted[i];
+}
+
+static uint32_t rng_state = 0x4C414D41;
+
+static uint32_t rng(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void cold_cache(void) {
+    bcache_init();
+    disk_reset_stats();
+}
+
+/* ================ ÖLÇÜMLER ================ */
+
+static int bench_seq_read(int runs) {
+    double best = 0, total = 0;
+    uint64_t bytes = 0;
+    disk_stats_t disk;
+
+    for (int i = 0; i < runs; i++) {
+        fat32_file_t file;
+        int32_t n;
+
+        cold_cache();
+        double start = now_us();
+        if (fat32_open("big.dat", &file) != 0) return -1;
+        bytes = 0;
+        while ((n = fat32_read(&file, buffer, BENCH_CHUNK)) > 0) bytes += (uint64_t) n;
+        if (n < 0) return -1;
+        double us = now_us() - start;
+
+        disk_get_stats(&disk);
+        if (i == 0 || us < best) best = us;
+        total += us;
+    }
+
+    fprintf(out, "    \"seq_read\": {\"bytes\": %llu, \"best_ms\": %.3f, \"avg_ms\": %.3f, "
+                 "\"mb_s\": %.1f, \"read_commands\": %llu},\n",
+            (unsigned long long) bytes, best / 1e3, total / runs / 1e3,
+            best > 0 ? bytes / best : 0.0, (unsigned long long) disk.read_commands);
+    return 0;
+}
+
+static int bench_random_read(uint32_t ops) {
+    fat32_file_t file;
+    double* samples = malloc(ops * sizeof(double));
+    bcache_stats_t cache;
+
+    if (!samples || fat32_open("big.dat", &file) != 0 || file.size < BENCH_RANDOM_IO) {
+        free(samples);
+        return -1;
+    }
+
+    cold_cache();
+    uint32_t blocks = file.size / BENCH_RANDOM_IO;
+    double start = now_us();
+    for (uint32_t i = 0; i < ops; i++) {
+        double t = now_us();
+        if (fat32_seek(&file, (rng() % blocks) * BENCH_RANDOM_IO) != 0 ||
+            fat32_read(&file, buffer, BENCH_RANDOM_IO) != BENCH_RANDOM_IO) {
+            free(samples);
+            return -1;
+        }
+        samples[i] = now_us() - t;
+    }
+    double elapsed = now_us() - start;
+    bcache_get_stats(&cache);
+
+    qsort(samples, ops, sizeof(double), compare_double);
+    fprintf(out, "    \"random_read\": {\"ops\": %u, \"io_bytes\": %u, \"ops_s\": %.0f, "
+                 "\"p50_us\": %.3f, \"p99_us\": %.3f, \"max_us\": %.3f, \"cache_hits\": %llu, "
+                 "\"cache_misses\": %llu},\n",
+            ops, BENCH_RANDOM_IO, ops / (elapsed / 1e6), percentile(samples, ops, 50),
+            percentile(samples, ops, 99), samples[ops - 1],
+            (unsigned long long) cache.hits, (unsigned long long) cache.misses);
+    free(samples);
+    return 0;
+}
+
+static int bench_lookup(uint32_t ops, uint32_t files) {
+    char path[32];
+    DIR_ENTRY entry;
+    double* samples = malloc(ops * sizeof(double));
+    dir_index_stats_t before, index;
+
+    if (!samples || files == 0) {
+        free(samples);
+        return -1;
+    }
+
+    // İlk arama dizini tarayıp indeksi kurar
+    dir_index_reset();
+    dir_index_get_stats(&before);
+    cold_cache();
+    double start = now_us();
+    if (find_file("data/F0000000.DAT", &entry) != 0) {
+        free(samples);
+        return -1;
+    }
+    double first = now_us() - start;
+
+    start = now_us();
+    for (uint32_t i = 0; i < ops; i++) {
+        snprintf(path, sizeof(path), "data/f%07u.dat", rng() % files);
+        double t = now_us();
+        if (find_file(path, &entry) != 0) {
+            free(samples);
+            return -1;
+        }
+        samples[i] = now_us() - t;
+    }
+    double elapsed = now_us() - start;
+    dir_index_get_stats(&index);
+
+    qsort(samples, ops, sizeof(double), compare_double);
+    fprintf(out, "    \"lookup\": {\"entries\": %u, \"ops\": %u, \"first_us\": %.3f, "
+                 "\"ops_s\": %.0f, \"p50_us\": %.3f, \"p99_us\": %.3f, \"index_builds\": %llu, "
+                 "\"fallbacks\": %llu},\n",
+            files, ops, first, ops / (elapsed / 1e6), percentile(samples, ops, 50),
+            percentile(samples, ops, 99), (unsigned long long) (index.builds - before.builds),
+            (unsigned long long) (index.fallbacks - before.fallbacks));
+    free(samples);
+    return 0;
+}
+
+static int bench_listing(int runs, uint32_t* files) {
+    double best = 0, total = 0, ext_best = 0;
+    uint32_t matched = 0;
+
+    for (int i = 0; i < runs; i++) {
+        double start = now_us();
+        FileInfo* list = fat32_read_directory("data");
+        double us = now_us() - start;
+        if (!list) return -1;
+
+        *files = 0;
+        while (list[*files].name) (*files)++;
+        fat32_free_file_info(list);
+
+        if (i == 0 || us < best) best = us;
+        total += us;
+
+        // Aynı dizin uzantı indeksinden (O(k))
+        start = now_us();
+        list = fat32_list_extension("data", ".dat", FAT32_MATCH_EXTENSION);
+        us = now_us() - start;
+        if (!list) return -1;
+
+        matched = 0;
+        while (list[matched].name) matched++;
+        fat32_free_file_info(list);
+
+        if (i == 0 || us < ext_best) ext_best = us;
+    }
+
+    fprintf(out, "    \"listing\": {\"entries\": %u, \"best_ms\": %.3f, \"avg_ms\": %.3f, "
+                 "\"ext_entries\": %u, \"ext_best_ms\": %.3f},\n",
+            *files, best / 1e3, total / runs / 1e3, matched, ext_best / 1e3);
+    return 0;
+}
+
+static int bench_kernel_load(int runs, uint32_t max_size) {
+    DIR_ENTRY entry;
+    loader_stats_t stats;
+    double best = 0, total = 0;
+
+    if (find_file("kernel.bin", &entry) != 0) return -1;
+
+    for (int i = 0; i < runs; i++) {
+        cold_cache();
+        double start = now_us();
+        if (loader_load_entry(&entry, buffer, max_size, &stats) != 0) return -1;
+        double us = now_us() - start;
+
+        if (i == 0 || us < best) best = us;
+        total += us;
+    }
+
+    fprintf(out, "    \"kernel_load\": {\"bytes\": %u, \"extents\": %u, \"best_ms\": %.3f, "
+                 "\"avg_ms\": %.3f, \"mb_s\": %.1f}\n",
+            stats.bytes, stats.extents, best / 1e3, total / runs / 1e3,
+            best > 0 ? stats.bytes / best : 0.0);
+    return 0;
+}
+
+/* ================ ANA PROGRAM ================ */
+
+static void usage(const char* name) {
+    fprintf(stderr, "Kullanim: %s [-n tekrar] [-r rastgele_okuma] [-l arama] [-w worker] "
+                    "[-o cikti.json] <imaj>\n", name);
+}
+
+int main(int argc, char* argv[]) {
+    int runs = 5;
+    uint32_t random_ops = 2000;
+    uint32_t lookups = 10000;
+    int workers = 0;
+    const char* output = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:r:l:w:o:")) != -1) {
+        switch (opt) {
+        case 'n': runs = atoi(optarg); break;
+        case 'r': random_ops = (uint32_t) atoi(optarg); break;
+        case 'l': lookups = (uint32_t) atoi(optarg); break;
+        case 'w': workers = atoi(optarg); break;
+        case 'o': output = optarg; break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (optind >= argc || runs <= 0 || random_ops == 0 || lookups == 0 || workers < 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    const char* image_path = argv[optind];
+    disk_device_t dev;
+    if (disk_host_open(&dev, image_path, 0) != 0) {
+        perror(image_path);
+        return 1;
+    }
+    disk_set_device(&dev);
+    if (disk_queue_init((uint32_t) workers) != 0 || fat32_init() != 0) {
+        fprintf(stderr, "%s: FAT32 bolumu baglanamadi\n", image_path);
+        return 1;
+    }
+
+    DIR_ENTRY big, kernel;
+    if (find_file("big.dat", &big) != 0 || find_file("kernel.bin", &kernel) != 0) {
+        fprintf(stderr, "%s: mkimage ile uretilmis bir imaj degil\n", image_path);
+        return 1;
+    }
+    uint32_t max_size = kernel.file_size > BENCH_CHUNK ? kernel.file_size : BENCH_CHUNK;
+    buffer = malloc(max_size);
+
+    out = output ? fopen(output, "w") : stdout;
+    if (!buffer || !out) {
+        perror(output ? output : "malloc");
+        return 1;
+    }
+
+    fat32_volume_t* vol = fat32_get_volume();
+    fprintf(out, "{\n  \"image\": \"%s\",\n", image_path);
+    fprintf(out, "  \"cluster_size\": %u,\n  \"cluster_count\": %u,\n", vol->cluster_size, vol->cluster_count);
+    fprintf(out, "  \"runs\": %d,\n  \"workers\": %d,\n  \"results\": {\n", runs, workers);
+
+    uint32_t files = 0;
+    int failed = bench_seq_read(runs) != 0 ||
+                 bench_random_read(random_ops) != 0 ||
+                 bench_listing(runs, &files) != 0 ||
+                 bench_lookup(lookups, files) != 0 ||
+                 bench_kernel_load(runs, max_size) != 0;
+
+    fprintf(out, "  }\n}\n");
+    if (output) fclose(out);
+    if (failed) fprintf(stderr, "%s: olcum basarisiz\n", image_path);
+
+    disk_queue_shutdown();
+    disk_close(&dev);
+    free(buffer);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,356 @@
+// fat32check: bir FAT32 disk imajının tutarlılığını boot öncesi denetleyen
+// host aracı.
+//
+//   fat32check [-w worker] [-q] <imaj>
+//
+// İmaj bir kez eşlenir; aktif FAT doğrudan eşlenmiş bellekten okunur.
+// Dizin ağacı bir iş parçacığı havuzunda gezilir: her worker kuyruktan bir
+// dizin alır, girdilerinin cluster zincirlerini doğrular ve alt dizinleri
+// kuyruğa ekler. Zincirdeki her cluster paylaşılan bir bitmap'te atomik
+// olarak işaretlenir; zaten işaretli bir cluster çapraz bağlantıdır (ya da
+// zincir kendine dönüyordur). Gezinti bitince FAT aralıklara bölünüp
+// paralel taranır: kullanımda görünüp hiçbir zincirde olmayan cluster'lar
+// kayıptır. Boş cluster sayısı FSINFO ile, FAT kopyaları birbiriyle
+// karşılaştırılır.
+//
+// Çıkış kodu: 0 tutarlı, 1 hata bulundu, 2 imaj açılamadı.
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "disk_io.h"
+#include "fsinfo.h"
+#include "fat32_mmap.h"
+
+#define CHECK_MAX_WORKERS 64
+#define CHECK_MAX_REPORTS 100   // Ayrıntısı yazılan en fazla hata
+#define CHECK_MAX_PATH    1024
+
+// Hata türleri
+enum {
+    ERR_BAD_START,      // Girdi geçersiz bir cluster gösteriyor
+    ERR_BAD_ENTRY,      // Zincirde boş/bozuk/aralık dışı FAT girdisi
+    ERR_CROSS_LINK,     // Cluster birden fazla zincirde (ya da döngü)
+    ERR_SHORT_CHAIN,    // Zincir dosya boyutuna yetmiyor
+    ERR_LONG_CHAIN,     // Zincir dosya boyutundan uzun
+    ERR_LOST,           // Kullanımda ama hiçbir zincirde değil
+    ERR_FSINFO,         // FSINFO boş sayısı tutmuyor
+    ERR_MIRROR,         // FAT kopyaları farklı
+    ERR_TYPES
+};
+
+static const char* error_names[ERR_TYPES] = {
+    "gecersiz_baslangic", "gecersiz_girdi", "capraz_baglanti", "kisa_zincir",
+    "uzun_zincir", "kayip_cluster", "fsinfo", "fat_kopyasi"
+};
+
+// Kuyruktaki dizin
+typedef struct dir_job {
+    struct dir_job* next;
+    uint32_t cluster;
+    char path[CHECK_MAX_PATH];
+} dir_job_t;
+
+static fat32_image_t image;
+static uint64_t* used_map;          // 1: bir zincire ait (atomik)
+static int quiet = 0;
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t work_ready = PTHREAD_COND_INITIALIZER;
+static dir_job_t* jobs = 0;         // Bekleyen dizinler (yığın)
+static uint32_t active = 0;         // Dizin işleyen worker sayısı
+
+static uint64_t errors[ERR_TYPES];
+static uint64_t reported = 0;
+static uint64_t dirs = 0, files = 0, chained = 0;
+
+static void report(int type, const char* path, const char* fmt, unsigned long value) {
+    __atomic_fetch_add(&errors[type], 1, __ATOMIC_RELAXED);
+    if (quiet || __atomic_fetch_add(&reported, 1, __ATOMIC_RELAXED) >= CHECK_MAX_REPORTS) return;
+
+    pthread_mutex_lock(&lock);
+    fprintf(stderr, "%s: ", path);
+    fprintf(stderr, fmt, value);
+    fputc('\n', stderr);
+    pthread_mutex_unlock(&lock);
+}
+
+/* ================ ZİNCİRLER ================ */
+
+// Cluster'ı zincire ait işaretle; daha önce işaretliyse 0 döner
+static int claim(uint32_t cluster) {
+    uint64_t bit = 1ull << (cluster & 63);
+    return !(__atomic_fetch_or(&used_map[cluster >> 6], bit, __ATOMIC_RELAXED) & bit);
+}
+
+// Zinciri gez ve işaretle. Dosyalarda zincir uzunluğu boyutla karşılaştırılır
+// (directory != 0 ise boyut yok sayılır). İlk cluster bu çağrıda
+// işaretlendiyse 1 döner.
+static int check_chain(const char* path, uint32_t first, uint32_t size, int directory) {
+    const fat32_volume_t* vol = &image.vol;
+    uint32_t expected = (uint32_t) (((uint64_t) size + vol->cluster_size - 1) / vol->cluster_size);
+    uint32_t cluster = first;
+    uint32_t length = 0;
+
+    if (first == 0) {
+        if (directory || size > 0) report(ERR_BAD_START, path, "ilk cluster %lu", 0);
+        return 0;
+    }
+    if (!fat32_valid_cluster(vol, first)) {
+        report(ERR_BAD_START, path, "ilk cluster %lu", first);
+        return 0;
+    }
+
+    for (;;) {
+        // Başka bir zincir (ya da bu zincirin kendisi) cluster'ı almış
+        if (!claim(cluster)) {
+            report(ERR_CROSS_LINK, path, "cluster %lu baska bir zincirde", cluster);
+            break;
+        }
+        length++;
+
+        uint32_t next = fat32_image_next_cluster(&image, cluster);
+        if (next >= FAT32_EOC) break;
+        if (!fat32_valid_cluster(vol, next)) {
+            report(ERR_BAD_ENTRY, path, "FAT girdisi 0x%08lx", next);
+            break;
+        }
+        cluster = next;
+    }
+
+    __atomic_fetch_add(&chained, length, __ATOMIC_RELAXED);
+    if (!directory && length < expected) {
+        report(ERR_SHORT_CHAIN, path, "zincir %lu cluster eksik", expected - length);
+    }
+    if (!directory && length > expected) {
+        report(ERR_LONG_CHAIN, path, "zincir %lu cluster fazla", length - expected);
+    }
+    return length > 0;
+}
+
+/* ================ DİZİN AĞACI ================ */
+
+static void push_job(uint32_t cluster, const char* path) {
+    dir_job_t* job = malloc(sizeof(*job));
+    if (!job) {
+        perror("malloc");
+        exit(2);
+    }
+    job->cluster = cluster;
+    snprintf(job->path, sizeof(job->path), "%s", path);
+
+    pthread_mutex_lock(&lock);
+    job->next = jobs;
+    jobs = job;
+    pthread_cond_signal(&work_ready);
+    pthread_mutex_unlock(&lock);
+}
+
+static int visit_entry(const DIR_ENTRY* entry, void* ctx) {
+    const dir_job_t* dir = ctx;
+    char path[CHECK_MAX_PATH];
+    int directory = (entry->attributes & FAT32_ATTR_DIRECTORY) != 0;
+
+    if (snprintf(path, sizeof(path), "%s/%s", strcmp(dir->path, "/") ? dir->path : "",
+                 entry->name) >= (int) sizeof(path)) {
+        report(ERR_BAD_ENTRY, dir->path, "yol %lu byte'tan uzun", sizeof(path));
+        return 0;
+    }
+    int owned = check_chain(path, entry->first_cluster, entry->file_size, directory);
+
+    if (directory) {
+        __atomic_fetch_add(&dirs, 1, __ATOMIC_RELAXED);
+        // İlk cluster'ı başka bir zincirde olan dizin gezilmez; ağaçtaki
+        // döngüler (ör. bir üst dizini gösteren girdi) böyle kırılır
+        if (owned) push_job(entry->first_cluster, path);
+    } else {
+        __atomic_fetch_add(&files, 1, __ATOMIC_RELAXED);
+    }
+    return 0;
+}
+
+static void* walk_worker(void* arg) {
+    (void) arg;
+
+    for (;;) {
+        pthread_mutex_lock(&lock);
+        while (!jobs && active > 0) pthread_cond_wait(&work_ready, &lock);
+        if (!jobs) {
+            // Kuyruk boş ve kimse iş üretmiyor: gezinti bitti
+            pthread_cond_broadcast(&work_ready);
+            pthread_mutex_unlock(&lock);
+            return 0;
+        }
+        dir_job_t* job = jobs;
+        jobs = job->next;
+        active++;
+        pthread_mutex_unlock(&lock);
+
+        if (fat32_image_walk_directory(&image, job->cluster, visit_entry, job) < 0) {
+            report(ERR_BAD_ENTRY, job->path, "dizin zinciri okunamadi (cluster %lu)", job->cluster);
+        }
+        free(job);
+
+        pthread_mutex_lock(&lock);
+        if (--active == 0 && !jobs) pthread_cond_broadcast(&work_ready);
+        pthread_mutex_unlock(&lock);
+    }
+}
+
+/* ================ FAT TARAMASI ================ */
+
+typedef struct {
+    pthread_t thread;
+    uint32_t start, end;    // [start, end) cluster aralığı
+    uint64_t free_count;
+    uint64_t lost;          // report ile sayılan ilk kayıp cluster hariç
+    int reported;
+} scan_range_t;
+
+static void* scan_worker(void* arg) {
+    scan_range_t* range = arg;
+
+    for (uint32_t c = range->start; c < range->end; c++) {
+        uint32_t value = image.fat[c] & FAT32_ENTRY_MASK;
+        int used = (used_map[c >> 6] >> (c & 63)) & 1;
+
+        if (value == FAT32_FREE) {
+            range->free_count++;
+        } else if (value != FAT32_BAD && !used) {
+            if (range->reported) {
+                range->lost++;
+            } else {
+                range->reported = 1;
+                report(ERR_LOST, "FAT", "ilk kayip cluster %lu", c);
+            }
+        }
+    }
+    return 0;
+}
+
+// FAT kopyalarını aktif kopyayla karşılaştır
+static void check_mirrors(void) {
+    const fat32_volume_t* vol = &image.vol;
+    size_t bytes = (size_t) vol->fat_sectors * SECTOR_SIZE;
+
+    // Yansıtma kapalıysa yalnızca aktif kopya kullanılır
+    if (vol->boot.ext_flags & 0x80) return;
+
+    for (uint32_t i = 0; i < vol->boot.fat_count; i++) {
+        const uint8_t* copy = fat32_image_sector(&image, vol->fat_start + i * vol->fat_sectors);
+        if (i == vol->active_fat) continue;
+        if (!copy || !fat32_image_sector(&image, vol->fat_start + (i + 1) * vol->fat_sectors - 1) ||
+            memcmp(copy, image.fat, bytes) != 0) {
+            report(ERR_MIRROR, "FAT", "kopya %lu aktif FAT ile ayni degil", i);
+        }
+    }
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    long workers = sysconf(_SC_NPROCESSORS_ONLN);
+    pthread_t threads[CHECK_MAX_WORKERS];
+    scan_range_t ranges[CHECK_MAX_WORKERS];
+    int opt;
+
+    while ((opt = getopt(argc, argv, "w:q")) != -1) {
+        switch (opt) {
+        case 'w': workers = atol(optarg); break;
+        case 'q': quiet = 1; break;
+        default:
+            fprintf(stderr, "Kullanim: %s [-w worker] [-q] <imaj>\n", argv[0]);
+            return 2;
+        }
+    }
+    if (optind >= argc || workers <= 0) {
+        fprintf(stderr, "Kullanim: %s [-w worker] [-q] <imaj>\n", argv[0]);
+        return 2;
+    }
+    if (workers > CHECK_MAX_WORKERS) workers = CHECK_MAX_WORKERS;
+
+    if (fat32_image_open(&image, argv[optind]) != 0) {
+        fprintf(stderr, "%s: FAT32 imaji eslenemedi\n", argv[optind]);
+        return 2;
+    }
+
+    const fat32_volume_t* vol = &image.vol;
+    uint32_t limit = vol->cluster_count + 2;
+    used_map = calloc((limit + 63) / 64, sizeof(uint64_t));
+    if (!used_map) {
+        perror("malloc");
+        return 2;
+    }
+
+    // FAT baştan sona birkaç kez okunacak
+    fat32_image_advise(&image, vol->fat_start, vol->boot.fat_count * vol->fat_sectors,
+                       FAT32_ADVISE_WILLNEED);
+
+    double start = now_ms();
+
+    // 1. Dizin ağacı: kök zinciri işaretlenip kuyruğa konur
+    check_chain("/", vol->root_cluster, 0, 1);
+    push_job(vol->root_cluster, "/");
+    for (long i = 0; i < workers; i++) pthread_create(&threads[i], 0, walk_worker, 0);
+    for (long i = 0; i < workers; i++) pthread_join(threads[i], 0);
+
+    // 2. Kayıp cluster'lar ve boş sayısı: FAT aralıklara bölünür (aralık
+    // sınırları 64'ün katı, böylece bitmap kelimeleri paylaşılmaz)
+    uint64_t step = (((uint64_t) limit + workers - 1) / workers + 63) & ~63ull;
+    for (long i = 0; i < workers; i++) {
+        uint64_t s = i ? (uint64_t) i * step : 2;
+        uint64_t e = (uint64_t) (i + 1) * step;
+        ranges[i].start = s < limit ? (uint32_t) s : limit;
+        ranges[i].end = e < limit ? (uint32_t) e : limit;
+        ranges[i].free_count = 0;
+        ranges[i].lost = 0;
+        ranges[i].reported = 0;
+        pthread_create(&ranges[i].thread, 0, scan_worker, &ranges[i]);
+    }
+
+    uint64_t free_count = 0;
+    uint64_t lost = 0;
+    for (long i = 0; i < workers; i++) {
+        pthread_join(ranges[i].thread, 0);
+        free_count += ranges[i].free_count;
+        lost += ranges[i].lost;
+    }
+    errors[ERR_LOST] += lost;
+
+    check_mirrors();
+
+    // 3. FSINFO yalnızca bir ipucudur ama bilinen değer gerçek sayıyla aynı olmalı
+    const fat32_fsinfo_t* fsinfo =
+        (const fat32_fsinfo_t*) fat32_image_sector(&image, vol->lba + vol->boot.fs_info_sector);
+    if (fsinfo && fsinfo->lead_signature == FSINFO_LEAD_SIGNATURE &&
+        fsinfo->struct_signature == FSINFO_STRUCT_SIGNATURE &&
+        fsinfo->free_count != FSINFO_UNKNOWN && fsinfo->free_count != free_count) {
+        report(ERR_FSINFO, "FSINFO", "bos cluster sayisi %lu", fsinfo->free_count);
+    }
+
+    double ms = now_ms() - start;
+    uint64_t total = 0;
+    for (int i = 0; i < ERR_TYPES; i++) total += errors[i];
+
+    printf("%s: %u cluster, %llu dizin, %llu dosya, %llu zincirde, %llu bos, %llu kayip\n",
+           argv[optind], vol->cluster_count, (unsigned long long) dirs,
+           (unsigned long long) files, (unsigned long long) chained,
+           (unsigned long long) free_count, (unsigned long long) errors[ERR_LOST]);
+    for (int i = 0; i < ERR_TYPES; i++) {
+        if (errors[i]) printf("  %-20s %llu\n", error_names[i], (unsigned long long) errors[i]);
+    }
+    printf("%.3f ms, %.0f cluster/s, %ld worker\n",
+           ms, ms > 0 ? vol->cluster_count / (ms / 1000.0) : 0.0, workers);
+
+    fat32_image_close(&image);
+    free(used_map);
+    return total ? 1 : 0;
+}
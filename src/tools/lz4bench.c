@@ -0,0 +1,166 @@
+// lz4bench: bir FAT32 disk imajında ham ve LZ4 sıkıştırılmış kernel
+// yükleme sürelerini karşılaştıran host aracı.
+//
+//   lz4bench [-n tekrar] [-b MB/s] [-w worker] <imaj> [ham_dosya] [lz4_dosya]
+//
+// İmaj host sayfa önbelleğinden okunduğu için ölçülen süre çoğunlukla
+// CPU maliyetidir. -b ile verilen disk hızında okunan byte'ların aktarım
+// süresi eklenerek gerçek donanımdaki yükleme süresi de tahmin edilir.
+// -w ile disk kuyruğu iş parçacığı havuzuyla çalışır (0: eşzamanlı).
+// "mmap" satırı ham dosyayı eşlenmiş imajdan kopyalar; önbellekli blok
+// aygıtı yolunun karşılaştırılacağı sıfır kopyalı referanstır.
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "disk_io.h"
+#include "fat32.h"
+#include "loader.h"
+#include "disk_queue.h"
+#include "fat32_mmap.h"
+
+#define BENCH_MAX_SIZE (64u << 20)
+
+typedef int (*load_fn)(const DIR_ENTRY*, uint8_t*, uint32_t, loader_stats_t*);
+
+typedef struct {
+    double best_ms;
+    double avg_ms;
+    loader_stats_t stats;
+    disk_stats_t disk;
+} bench_result_t;
+
+static fat32_image_t image;
+
+static int copy_run(const uint8_t* data, uint32_t bytes, void* ctx) {
+    uint8_t** dest = ctx;
+    memcpy(*dest, data, bytes);
+    *dest += bytes;
+    return 0;
+}
+
+// Referans: dosya koşuları eşlenmiş imajdan doğrudan hedefe kopyalanır
+static int mmap_load(const DIR_ENTRY* entry, uint8_t* dest, uint32_t max_size, loader_stats_t* stats) {
+    memset(stats, 0, sizeof(*stats));
+    if (entry->file_size > max_size) return -1;
+    if (fat32_image_read_runs(&image, entry, copy_run, &dest) != 0) return -1;
+    stats->bytes = stats->read_bytes = entry->file_size;
+    return 0;
+}
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static int bench(const char* name, load_fn load, uint8_t* dest, int runs, bench_result_t* out) {
+    DIR_ENTRY entry;
+    if (find_file(name, &entry) != 0) {
+        fprintf(stderr, "%s bulunamadi\n", name);
+        return -1;
+    }
+
+    out->best_ms = 0;
+    out->avg_ms = 0;
+    for (int i = 0; i < runs; i++) {
+        disk_reset_stats();
+        double start = now_ms();
+        if (load(&entry, dest, BENCH_MAX_SIZE, &out->stats) != 0) {
+            fprintf(stderr, "%s yuklenemedi\n", name);
+            return -1;
+        }
+        double ms = now_ms() - start;
+        disk_get_stats(&out->disk);
+
+        if (i == 0 || ms < out->best_ms) out->best_ms = ms;
+        out->avg_ms += ms / runs;
+    }
+    return 0;
+}
+
+static void report(const char* label, const bench_result_t* r, double mbps) {
+    double transfer_ms = r->stats.read_bytes / (mbps * 1e6) * 1000.0;
+    printf("%-6s %10u %10u %8llu %10.3f %10.3f %12.3f\n", label,
+           r->stats.read_bytes, r->stats.bytes,
+           (unsigned long long) r->disk.read_commands,
+           r->best_ms, r->avg_ms, r->best_ms + transfer_ms);
+}
+
+int main(int argc, char* argv[]) {
+    int runs = 20;
+    double mbps = 20.0;
+    int workers = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:b:w:")) != -1) {
+        switch (opt) {
+        case 'n': runs = atoi(optarg); break;
+        case 'b': mbps = atof(optarg); break;
+        case 'w': workers = atoi(optarg); break;
+        default:
+            fprintf(stderr, "Kullanim: %s [-n tekrar] [-b MB/s] [-w worker] <imaj> [ham_dosya] [lz4_dosya]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (optind >= argc || runs <= 0 || mbps <= 0 || workers < 0) {
+        fprintf(stderr, "Kullanim: %s [-n tekrar] [-b MB/s] [-w worker] <imaj> [ham_dosya] [lz4_dosya]\n", argv[0]);
+        return 1;
+    }
+
+    const char* image_path = argv[optind];
+    const char* raw_name = optind + 1 < argc ? argv[optind + 1] : "kernel.c";
+    const char* lz4_name = optind + 2 < argc ? argv[optind + 2] : "kernel.lz4";
+
+    disk_device_t dev;
+    if (disk_host_open(&dev, image_path, 0) != 0) {
+        perror(image_path);
+        return 1;
+    }
+    disk_set_device(&dev);
+    if (disk_queue_init((uint32_t) workers) != 0) {
+        fprintf(stderr, "Disk kuyrugu baslatilamadi\n");
+        return 1;
+    }
+
+    if (fat32_image_open(&image, image_path) != 0) {
+        fprintf(stderr, "%s: FAT32 imaji eslenemedi\n", image_path);
+        return 1;
+    }
+
+    uint8_t* raw_dest = malloc(BENCH_MAX_SIZE);
+    uint8_t* lz4_dest = malloc(BENCH_MAX_SIZE);
+    uint8_t* mmap_dest = malloc(BENCH_MAX_SIZE);
+    bench_result_t raw, lz4, mapped;
+    if (!raw_dest || !lz4_dest || !mmap_dest ||
+        bench(raw_name, loader_load_entry, raw_dest, runs, &raw) != 0 ||
+        bench(lz4_name, loader_load_entry_lz4, lz4_dest, runs, &lz4) != 0 ||
+        bench(raw_name, mmap_load, mmap_dest, runs, &mapped) != 0) {
+        return 1;
+    }
+
+    if (raw.stats.bytes != lz4.stats.bytes || memcmp(raw_dest, lz4_dest, raw.stats.bytes) != 0) {
+        fprintf(stderr, "Uyari: acilan imaj ham dosyayla ayni degil\n");
+    }
+    if (memcmp(raw_dest, mmap_dest, raw.stats.bytes) != 0) {
+        fprintf(stderr, "Uyari: mmap ile okunan dosya blok aygitindan okunanla ayni degil\n");
+    }
+
+    printf("%-6s %10s %10s %8s %10s %10s %12s\n",
+           "imaj", "disk", "bellek", "komut", "en_iyi_ms", "ort_ms", "tahmini_ms");
+    report("ham", &raw, mbps);
+    report("lz4", &lz4, mbps);
+    report("mmap", &mapped, mbps);
+    printf("tahmin: %.1f MB/s disk, %d tekrar, %d worker\n", mbps, runs, workers);
+
+    disk_queue_shutdown();
+    disk_close(&dev);
+    fat32_image_close(&image);
+    free(raw_dest);
+    free(lz4_dest);
+    free(mmap_dest);
+    return 0;
+}
@@ -0,0 +1,239 @@
+// lz4pack: kernel/çalıştırılabilir imajları bootloader'ın açabileceği
+// LZ4 frame biçimine sıkıştıran host aracı.
+//
+//   lz4pack <girdi> <çıktı>
+//
+// Bloklar bağımsızdır (en fazla 4 MiB), içerik boyutu başlığa yazılır.
+// Başlık ve içerik sağlamaları (xxHash32) standart `lz4` aracıyla uyumlu
+// olsun diye hesaplanır; bootloader bunları doğrulamaz.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define BLOCK_MAX     (4u << 20)  // BD = 7
+#define HASH_BITS     16
+#define MIN_MATCH     4
+#define MFLIMIT       12          // Son eşleşme en az bu kadar önce başlamalı
+#define LAST_LITERALS 5           // Blok sonundaki bu kadar byte literal olmalı
+#define MAX_OFFSET    65535
+
+/* ================ xxHash32 ================ */
+
+#define PRIME32_1 2654435761u
+#define PRIME32_2 2246822519u
+#define PRIME32_3 3266489917u
+#define PRIME32_4  668265263u
+#define PRIME32_5  374761393u
+
+static inline uint32_t rotl32(uint32_t x, int r) {
+    return (x << r) | (x >> (32 - r));
+}
+
+static inline uint32_t read32(const uint8_t* p) {
+    return (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+static inline void write32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t) v;
+    p[1] = (uint8_t) (v >> 8);
+    p[2] = (uint8_t) (v >> 16);
+    p[3] = (uint8_t) (v >> 24);
+}
+
+static uint32_t xxh32(const uint8_t* p, size_t len, uint32_t seed) {
+    const uint8_t* end = p + len;
+    uint32_t h;
+
+    if (len >= 16) {
+        uint32_t v1 = seed + PRIME32_1 + PRIME32_2;
+        uint32_t v2 = seed + PRIME32_2;
+        uint32_t v3 = seed;
+        uint32_t v4 = seed - PRIME32_1;
+        do {
+            v1 = rotl32(v1 + read32(p) * PRIME32_2, 13) * PRIME32_1;
+            v2 = rotl32(v2 + read32(p + 4) * PRIME32_2, 13) * PRIME32_1;
+            v3 = rotl32(v3 + read32(p + 8) * PRIME32_2, 13) * PRIME32_1;
+            v4 = rotl32(v4 + read32(p + 12) * PRIME32_2, 13) * PRIME32_1;
+            p += 16;
+        } while (p + 16 <= end);
+        h = rotl32(v1, 1) + rotl32(v2, 7) + rotl32(v3, 12) + rotl32(v4, 18);
+    } else {
+        h = seed + PRIME32_5;
+    }
+
+    h += (uint32_t) len;
+    while (p + 4 <= end) {
+        h = rotl32(h + read32(p) * PRIME32_3, 17) * PRIME32_4;
+        p += 4;
+    }
+    while (p < end) {
+        h = rotl32(h + (*p++) * PRIME32_5, 11) * PRIME32_1;
+    }
+
+    h ^= h >> 15;
+    h *= PRIME32_2;
+    h ^= h >> 13;
+    h *= PRIME32_3;
+    h ^= h >> 16;
+    return h;
+}
+
+/* ================ LZ4 BLOK SIKIŞTIRICI ================ */
+
+static uint32_t hash_table[1 << HASH_BITS];
+
+static inline uint32_t hash4(uint32_t v) {
+    return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+static uint8_t* put_length(uint8_t* op, uint32_t len) {
+    while (len >= 255) {
+        *op++ = 255;
+        len -= 255;
+    }
+    *op++ = (uint8_t) len;
+    return op;
+}
+
+static uint8_t* put_sequence(uint8_t* op, const uint8_t* lit, uint32_t lit_len,
+                             uint32_t offset, uint32_t match_len) {
+    uint8_t* token = op++;
+    *token = (uint8_t) ((lit_len >= 15 ? 15 : lit_len) << 4);
+    if (lit_len >= 15) op = put_length(op, lit_len - 15);
+    memcpy(op, lit, lit_len);
+    op += lit_len;
+
+    if (match_len == 0) return op;  // Son dizi yalnızca literal içerir
+
+    *op++ = (uint8_t) offset;
+    *op++ = (uint8_t) (offset >> 8);
+    match_len -= MIN_MATCH;
+    *token |= (uint8_t) (match_len >= 15 ? 15 : match_len);
+    if (match_len >= 15) op = put_length(op, match_len - 15);
+    return op;
+}
+
+// Açgözlü (greedy) tek geçişli sıkıştırma; çıktı boyutunu döndürür
+static uint32_t compress_block(const uint8_t* src, uint32_t n, uint8_t* dst) {
+    uint8_t* op = dst;
+    uint32_t ip = 0;
+    uint32_t anchor = 0;
+
+    memset(hash_table, 0, sizeof(hash_table));
+
+    if (n > MFLIMIT) {
+        uint32_t limit = n - MFLIMIT;
+        while (ip < limit) {
+            uint32_t seq = read32(src + ip);
+            uint32_t h = hash4(seq);
+            uint32_t ref = hash_table[h];
+            hash_table[h] = ip + 1;
+
+            if (ref == 0 || ip - (ref - 1) > MAX_OFFSET || read32(src + ref - 1) != seq) {
+                ip++;
+                continue;
+            }
+            ref--;
+
+            uint32_t len = MIN_MATCH;
+            while (ip + len < n - LAST_LITERALS && src[ref + len] == src[ip + len]) len++;
+
+            op = put_sequence(op, src + anchor, ip - anchor, ip - ref, len);
+            ip += len;
+            anchor = ip;
+        }
+    }
+
+    op = put_sequence(op, src + anchor, n - anchor, 0, 0);
+    return (uint32_t) (op - dst);
+}
+
+/* ================ FRAME ================ */
+
+static uint8_t* read_file(const char* path, size_t* size) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    uint8_t* data = malloc(len > 0 ? (size_t) len : 1);
+    if (data && fread(data, 1, (size_t) len, f) != (size_t) len) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    *size = (size_t) len;
+    return data;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "Kullanim: %s <girdi> <cikti>\n", argv[0]);
+        return 1;
+    }
+
+    size_t size;
+    uint8_t* input = read_file(argv[1], &size);
+    if (!input) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    FILE* out = fopen(argv[2], "wb");
+    uint8_t* block = malloc(BLOCK_MAX + BLOCK_MAX / 255 + 16);
+    if (!out || !block) {
+        perror(argv[2]);
+        return 1;
+    }
+
+    // Frame başlığı: sürüm 01, bağımsız bloklar, içerik boyutu ve sağlaması
+    uint8_t header[15];
+    write32(header, 0x184D2204);
+    header[4] = 0x40 | 0x20 | 0x08 | 0x04;
+    header[5] = 7 << 4;
+    write32(header + 6, (uint32_t) size);
+    write32(header + 10, (uint32_t) ((uint64_t) size >> 32));
+    header[14] = (uint8_t) (xxh32(header + 4, 10, 0) >> 8);
+    fwrite(header, 1, sizeof(header), out);
+
+    size_t packed = sizeof(header);
+    for (size_t pos = 0; pos < size; pos += BLOCK_MAX) {
+        uint32_t n = size - pos < BLOCK_MAX ? (uint32_t) (size - pos) : BLOCK_MAX;
+        uint32_t c = compress_block(input + pos, n, block);
+        uint8_t word[4];
+
+        // Sıkışmayan blok ham saklanır (üst bit işaretli)
+        if (c >= n) {
+            write32(word, n | 0x80000000u);
+            fwrite(word, 1, 4, out);
+            fwrite(input + pos, 1, n, out);
+            c = n;
+        } else {
+            write32(word, c);
+            fwrite(word, 1, 4, out);
+            fwrite(block, 1, c, out);
+        }
+        packed += 4 + c;
+    }
+
+    uint8_t trailer[8];
+    write32(trailer, 0);                        // EndMark
+    write32(trailer + 4, xxh32(input, size, 0));
+    fwrite(trailer, 1, sizeof(trailer), out);
+    packed += sizeof(trailer);
+
+    if (fclose(out) != 0) {
+        perror(argv[2]);
+        return 1;
+    }
+
+    printf("%s: %zu -> %zu byte (%%%.1f)\n", argv[1], size, packed,
+           size ? 100.0 * (double) packed / (double) size : 0.0);
+    free(block);
+    free(input);
+    return 0;
+}
@@ -0,0 +1,334 @@
+// mkimage: benchmark için sentetik FAT32 disk imajı üreten host aracı.
+//
+//   mkimage [-c cluster_KiB] [-f parçalanma_%] [-n dosya] [-s dosya_KiB]
+//           [-k kernel_KiB] [-b büyük_dosya_MiB] [-r tohum] <çıktı>
+//
+// İmaj içeriği:
+//   /KERNEL.BIN   -k KiB, load_kernel / loader ölçümü için
+//   /BIG.DAT      -b MiB, sıralı ve rastgele okuma ölçümü için
+//   /DATA/        -n adet F0000000.DAT .. dosyası (her biri -s KiB)
+//
+// -f ile her cluster geçişinde verilen olasılıkla zincire 1-16 cluster'lık
+// bir boşluk bırakılır; böylece dosyalar parçalı diske yayılır. Cluster
+// sayısı FAT32 alt sınırının (65525) altına inmez; imaj seyrek dosya olarak
+// yazılır, boş bölgeler diskte yer kaplamaz.
+
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "disk_io.h"
+#include "fsinfo.h"
+#include "fat32.h"
+
+#define RESERVED_SECTORS 32
+#define FAT_COPIES       2
+#define MIN_CLUSTERS     65525          // FAT32 sayılması için gereken en az cluster
+#define MAX_FILES        9999999
+
+typedef struct {
+    char     name[11];
+    uint8_t  attributes;
+    uint32_t first_cluster;
+    uint32_t size;
+    uint32_t seed;          // İçerik üreteci tohumu
+} image_file_t;
+
+static uint32_t* fat;               // Bellekteki FAT (cluster indeksli)
+static uint32_t fat_capacity;
+static uint32_t next_cluster = 3;   // Cluster 2 kök dizine ayrılmıştır
+static uint32_t rng_state;
+static int fragment_percent;
+
+static uint32_t rng(void) {
+    // xorshift32
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void fat_reserve(uint32_t cluster) {
+    if (cluster < fat_capacity) return;
+
+    uint32_t capacity = fat_capacity ? fat_capacity : 65536;
+    while (capacity <= cluster) capacity *= 2;
+    fat = realloc(fat, (size_t) capacity * sizeof(uint32_t));
+    if (!fat) {
+        perror("malloc");
+        exit(1);
+    }
+    memset(fat + fat_capacity, 0, (size_t) (capacity - fat_capacity) * sizeof(uint32_t));
+    fat_capacity = capacity;
+}
+
+// count cluster'lık zincir ayır; parçalanma olasılığına göre araya boşluk koy
+static uint32_t alloc_chain(uint32_t count) {
+    uint32_t first = 0, prev = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (i > 0 && (int) (rng() % 100) < fragment_percent) {
+            next_cluster += 1 + rng() % 16;
+        }
+        uint32_t cluster = next_cluster++;
+        fat_reserve(cluster);
+        if (prev) {
+            fat[prev] = cluster;
+        } else {
+            first = cluster;
+        }
+        prev = cluster;
+    }
+    if (prev) fat[prev] = FAT32_EOC_MARK;
+    return first;
+}
+
+static void make_name(char name[11], const char* base, const char* ext) {
+    memset(name, ' ', 11);
+    memcpy(name, base, strlen(base));
+    memcpy(name + 8, ext, strlen(ext));
+}
+
+static void fill_dirent(fat32_dirent_t* raw, const char name[11], uint8_t attributes,
+                        uint32_t cluster, uint32_t size) {
+    memset(raw, 0, sizeof(*raw));
+    memcpy(raw->name, name, sizeof(raw->name));
+    raw->attributes = attributes;
+    raw->create_date = raw->write_date = raw->access_date = 0x0021;   // 1980-01-01
+    raw->cluster_high = (uint16_t) (cluster >> 16);
+    raw->cluster_low = (uint16_t) (cluster & 0xFFFF);
+    raw->file_size = size;
+}
+
+static int write_at(int fd, const void* data, size_t bytes, uint64_t offset) {
+    const uint8_t* p = data;
+    while (bytes > 0) {
+        ssize_t n = pwrite(fd, p, bytes, (off_t) offset);
+        if (n <= 0) return -1;
+        p += n;
+        bytes -= (size_t) n;
+        offset += (uint64_t) n;
+    }
+    return 0;
+}
+
+// Zincirin cluster'larına içerik yaz (dizinler için data, dosyalar için
+// tohumdan üretilen desen)
+static int write_chain(int fd, uint64_t data_offset, uint32_t cluster_size, uint32_t first,
+                       const uint8_t* data, uint32_t size, uint32_t seed, uint8_t* buffer) {
+    uint32_t cluster = first;
+    uint32_t done = 0;
+    uint32_t state = seed ? seed : 1;
+
+    while (done < size && cluster >= 2 && cluster < FAT32_EOC) {
+        uint32_t n = size - done < cluster_size ? size - done : cluster_size;
+        if (data) {
+            memcpy(buffer, data + done, n);
+        } else {
+            for (uint32_t i = 0; i < n; i += 4) {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                memcpy(buffer + i, &state, n - i < 4 ? n - i : 4);
+            }
+        }
+        if (write_at(fd, buffer, n, data_offset + (uint64_t) (cluster - 2) * cluster_size) != 0) {
+            return -1;
+        }
+        done += n;
+        cluster = fat[cluster];
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t cluster_kib = 4, files = 1000, file_kib = 16, kernel_kib = 256, big_mib = 16;
+    int opt;
+
+    rng_state = 0x4C414D41;   // "LAMA"
+    while ((opt = getopt(argc, argv, "c:f:n:s:k:b:r:")) != -1) {
+        switch (opt) {
+        case 'c': cluster_kib = (uint32_t) atoi(optarg); break;
+        case 'f': fragment_percent = atoi(optarg); break;
+        case 'n': files = (uint32_t) atoi(optarg); break;
+        case 's': file_kib = (uint32_t) atoi(optarg); break;
+        case 'k': kernel_kib = (uint32_t) atoi(optarg); break;
+        case 'b': big_mib = (uint32_t) atoi(optarg); break;
+        case 'r': rng_state = (uint32_t) strtoul(optarg, 0, 0) | 1; break;
+        default: optind = argc + 1; break;
+        }
+    }
+
+    // Cluster 512 byte'ın 2'nin kuvveti katı olmalı (en fazla 128 sektör)
+    uint32_t spc = cluster_kib * 2;
+    if (optind != argc - 1 || spc == 0 || spc > 128 || (spc & (spc - 1)) ||
+        fragment_percent < 0 || fragment_percent > 100 || files > MAX_FILES ||
+        file_kib > 1024 * 1024 || kernel_kib > 1024 * 1024 || big_mib > 1024) {
+        fprintf(stderr, "Kullanim: %s [-c cluster_KiB] [-f parcalanma_%%] [-n dosya] [-s dosya_KiB]\n"
+                        "          [-k kernel_KiB] [-b buyuk_dosya_MiB] [-r tohum] <cikti>\n", argv[0]);
+        return 1;
+    }
+    uint32_t cluster_size = spc * SECTOR_SIZE;
+
+    // 1. Yerleşim: önce tüm zincirler bellekteki FAT'e ayrılır
+    fat_reserve(2);
+    fat[0] = 0x0FFFFFF8;
+    fat[1] = FAT32_EOC_MARK;
+    fat[2] = FAT32_EOC_MARK;
+
+    image_file_t root[3];
+    image_file_t* data_files = calloc(files ? files : 1, sizeof(image_file_t));
+    if (!data_files) {
+        perror("malloc");
+        return 1;
+    }
+
+    make_name(root[0].name, "KERNEL", "BIN");
+    root[0].attributes = FAT32_ATTR_ARCHIVE;
+    root[0].size = kernel_kib * 1024;
+    make_name(root[1].name, "BIG", "DAT");
+    root[1].attributes = FAT32_ATTR_ARCHIVE;
+    root[1].size = big_mib << 20;
+    make_name(root[2].name, "DATA", "");
+    root[2].attributes = FAT32_ATTR_DIRECTORY;
+    root[2].size = 0;
+
+    // Dizin: "." ve ".." ardından dosyalar, sonunda bir boş girdi
+    uint32_t dir_bytes = (files + 3) * sizeof(fat32_dirent_t);
+    uint32_t dir_clusters = (dir_bytes + cluster_size - 1) / cluster_size;
+
+    for (int i = 0; i < 2; i++) {
+        root[i].seed = (uint32_t) i + 1;
+        root[i].first_cluster = alloc_chain((root[i].size + cluster_size - 1) / cluster_size);
+    }
+    root[2].first_cluster = alloc_chain(dir_clusters);
+    for (uint32_t i = 0; i < files; i++) {
+        char base[9];
+        snprintf(base, sizeof(base), "F%07u", i);
+        make_name(data_files[i].name, base, "DAT");
+        data_files[i].attributes = FAT32_ATTR_ARCHIVE;
+        data_files[i].size = file_kib * 1024;
+        data_files[i].seed = i + 3;
+        data_files[i].first_cluster = alloc_chain((data_files[i].size + cluster_size - 1) / cluster_size);
+    }
+
+    // 2. Geometri: kullanılan alanın %25 fazlası, en az FAT32 alt sınırı
+    uint64_t clusters = (uint64_t) next_cluster - 2;
+    clusters += clusters / 4 + 64;
+    if (clusters < MIN_CLUSTERS) clusters = MIN_CLUSTERS;
+    uint32_t fat_sectors = (uint32_t) (((clusters + 2) * 4 + SECTOR_SIZE - 1) / SECTOR_SIZE);
+    uint32_t data_start = RESERVED_SECTORS + FAT_COPIES * fat_sectors;
+    uint64_t total = data_start + clusters * spc;
+    if (total > 0xFFFFFFFFull) {
+        fprintf(stderr, "imaj 2 TiB sinirini asiyor\n");
+        return 1;
+    }
+    fat_reserve((uint32_t) clusters + 1);
+
+    uint32_t free_count = 0;
+    for (uint32_t c = 2; c < clusters + 2; c++) {
+        if (fat[c] == FAT32_FREE) free_count++;
+    }
+
+    int fd = open(argv[optind], O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || ftruncate(fd, (off_t) (total * SECTOR_SIZE)) != 0) {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    // 3. Boot sektörü (ve yedeği), FSINFO
+    uint8_t sector[SECTOR_SIZE];
+    fat32_boot_sector_t bs;
+    memset(sector, 0, sizeof(sector));
+    memset(&bs, 0, sizeof(bs));
+    memcpy(bs.jump, "\xEB\x58\x90", 3);
+    memcpy(bs.oem_id, "LAMAOS  ", 8);
+    bs.bytes_per_sector = SECTOR_SIZE;
+    bs.sectors_per_cluster = (uint8_t) spc;
+    bs.reserved_sector_count = RESERVED_SECTORS;
+    bs.fat_count = FAT_COPIES;
+    bs.media_type = 0xF8;
+    bs.sectors_per_track = 63;
+    bs.head_count = 255;
+    bs.total_sectors_large = (uint32_t) total;
+    bs.fat_size_32 = fat_sectors;
+    bs.fat32_root_cluster = 2;
+    bs.fs_info_sector = 1;
+    bs.backup_boot_sector = 6;
+    memcpy(sector, &bs, sizeof(bs));
+    sector[64] = 0x80;                          // Sürücü numarası
+    sector[66] = 0x29;                          // Genişletilmiş imza
+    memcpy(sector + 71, "LAMA BENCH ", 11);
+    memcpy(sector + 82, "FAT32   ", 8);
+    sector[510] = 0x55;
+    sector[511] = 0xAA;
+
+    fat32_fsinfo_t fsinfo;
+    memset(&fsinfo, 0, sizeof(fsinfo));
+    fsinfo.lead_signature = FSINFO_LEAD_SIGNATURE;
+    fsinfo.struct_signature = FSINFO_STRUCT_SIGNATURE;
+    fsinfo.free_count = free_count;
+    fsinfo.next_free = next_cluster;
+    fsinfo.trail_signature = FSINFO_TRAIL_SIGNATURE;
+
+    int failed = write_at(fd, sector, SECTOR_SIZE, 0) != 0 ||
+                 write_at(fd, sector, SECTOR_SIZE, 6 * SECTOR_SIZE) != 0 ||
+                 write_at(fd, &fsinfo, sizeof(fsinfo), SECTOR_SIZE) != 0 ||
+                 write_at(fd, &fsinfo, sizeof(fsinfo), 7 * SECTOR_SIZE) != 0;
+
+    // 4. FAT kopyaları
+    for (uint32_t i = 0; i < FAT_COPIES && !failed; i++) {
+        uint64_t offset = (uint64_t) (RESERVED_SECTORS + i * fat_sectors) * SECTOR_SIZE;
+        failed = write_at(fd, fat, (size_t) (clusters + 2) * sizeof(uint32_t), offset) != 0;
+    }
+
+    // 5. Dizinler ve dosya içerikleri
+    uint64_t data_offset = (uint64_t) data_start * SECTOR_SIZE;
+    uint8_t* buffer = malloc(cluster_size);
+    fat32_dirent_t* dir = calloc(dir_clusters, cluster_size);
+    fat32_dirent_t root_dir[4];
+    if (!buffer || !dir) {
+        perror("malloc");
+        return 1;
+    }
+
+    memset(root_dir, 0, sizeof(root_dir));
+    for (int i = 0; i < 3; i++) {
+        fill_dirent(&root_dir[i], root[i].name, root[i].attributes, root[i].first_cluster, root[i].size);
+    }
+    fill_dirent(&dir[0], ".          ", FAT32_ATTR_DIRECTORY, root[2].first_cluster, 0);
+    fill_dirent(&dir[1], "..         ", FAT32_ATTR_DIRECTORY, 0, 0);
+    for (uint32_t i = 0; i < files; i++) {
+        fill_dirent(&dir[i + 2], data_files[i].name, data_files[i].attributes,
+                    data_files[i].first_cluster, data_files[i].size);
+    }
+
+    failed = failed ||
+             write_chain(fd, data_offset, cluster_size, 2, (const uint8_t*) root_dir,
+                         sizeof(root_dir), 0, buffer) != 0 ||
+             write_chain(fd, data_offset, cluster_size, root[2].first_cluster, (const uint8_t*) dir,
+                         dir_clusters * cluster_size, 0, buffer) != 0;
+    for (int i = 0; i < 2 && !failed; i++) {
+        failed = write_chain(fd, data_offset, cluster_size, root[i].first_cluster, 0,
+                             root[i].size, root[i].seed, buffer) != 0;
+    }
+    for (uint32_t i = 0; i < files && !failed; i++) {
+        failed = write_chain(fd, data_offset, cluster_size, data_files[i].first_cluster, 0,
+                             data_files[i].size, data_files[i].seed, buffer) != 0;
+    }
+
+    if (failed || close(fd) != 0) {
+        perror(argv[optind]);
+        return 1;
+    }
+
+    printf("%s: %llu cluster x %u byte, %u dosya, %u bos cluster\n", argv[optind],
+           (unsigned long long) clusters, cluster_size, files + 2, free_count);
+    free(buffer);
+    free(dir);
+    free(data_files);
+    free(fat);
+    return 0;
+}